@@ -758,3 +758,191 @@ void ConvertRGBA8888ToPremulAlpha(u32 *dst, const u32 *src, u32 numPixels) {
 		dst[i] = premul_pixel_scalar(src[i]);
 	}
 }
+
+// YUV to RGB, with the sums in 6-bit fixed point:
+//   R = 1.164(Y - 16) + 1.596(V - 128)
+//   G = 1.164(Y - 16) - 0.392(U - 128) - 0.813(V - 128)
+//   B = 1.164(Y - 16) + 2.017(U - 128)
+// Each product is a 16x16 multiply keeping the high 16 bits (like _mm_mulhi_epi16), with the input
+// shifted up so the coefficients get 14-15 bits. The result is within about half a step of the exact
+// conversion. Everything fits in 16 bits except the blue sum, which can only overflow when it'd clamp
+// to 255 anyway, so the SIMD paths use saturating adds there and match the scalar path exactly.
+enum class YUVOutput {
+	RGBA8888,
+	RGB565,
+	RGBA5551,
+	RGBA4444,
+};
+
+// The multipliers for the fractional parts, the integer parts are added separately.
+static const int YUV_Y_FRAC = 5387;    // 0.164383 * 2^15, applied to (Y - 16) << 7.
+static const int YUV_RV = 26149;       // 1.596027 * 2^14, applied to V << 8.
+static const int YUV_GU = 6419;        // 0.391762 * 2^14, applied to U << 8.
+static const int YUV_GV = 13320;       // 0.812968 * 2^14, applied to V << 8.
+static const int YUV_BU_FRAC = 282;    // 0.017232 * 2^14, applied to U << 8.
+
+static inline u8 ClampYUVToU8(int x) {
+	return x < 0 ? 0 : (x > 255 ? 255 : x);
+}
+
+static inline int YUVMulHi(int a, int c) {
+	return (a * c) >> 16;
+}
+
+template <YUVOutput fmt>
+static inline u32 YUVToPixel(int y, int u, int v) {
+	y = y - 16;
+	u = u - 128;
+	v = v - 128;
+	const int yy = y * 64 + YUVMulHi(y * 128, YUV_Y_FRAC) + 32;
+	const u32 r = ClampYUVToU8((yy + YUVMulHi(v * 256, YUV_RV)) >> 6);
+	const u32 g = ClampYUVToU8((yy - (YUVMulHi(u * 256, YUV_GU) + YUVMulHi(v * 256, YUV_GV))) >> 6);
+	const u32 b = ClampYUVToU8((yy + u * 128 + YUVMulHi(u * 256, YUV_BU_FRAC)) >> 6);
+	switch (fmt) {
+	case YUVOutput::RGBA8888: return r | (g << 8) | (b << 16);
+	case YUVOutput::RGB565: return (r >> 3) | ((g >> 2) << 5) | ((b >> 3) << 11);
+	case YUVOutput::RGBA5551: return (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10);
+	case YUVOutput::RGBA4444: return (r >> 4) | ((g >> 4) << 4) | ((b >> 4) << 8);
+	}
+	return 0;
+}
+
+#if PPSSPP_ARCH(SSE2)
+template <YUVOutput fmt>
+static inline __m128i PackYUVPixels16(__m128i r, __m128i g, __m128i b) {
+	switch (fmt) {
+	case YUVOutput::RGB565:
+		return _mm_or_si128(_mm_or_si128(_mm_srli_epi16(r, 3), _mm_slli_epi16(_mm_srli_epi16(g, 2), 5)), _mm_slli_epi16(_mm_srli_epi16(b, 3), 11));
+	case YUVOutput::RGBA5551:
+		return _mm_or_si128(_mm_or_si128(_mm_srli_epi16(r, 3), _mm_slli_epi16(_mm_srli_epi16(g, 3), 5)), _mm_slli_epi16(_mm_srli_epi16(b, 3), 10));
+	default:
+		return _mm_or_si128(_mm_or_si128(_mm_srli_epi16(r, 4), _mm_slli_epi16(_mm_srli_epi16(g, 4), 4)), _mm_slli_epi16(_mm_srli_epi16(b, 4), 8));
+	}
+}
+#elif PPSSPP_ARCH(ARM_NEON)
+template <YUVOutput fmt>
+static inline uint16x8_t PackYUVPixels16(uint16x8_t r, uint16x8_t g, uint16x8_t b) {
+	switch (fmt) {
+	case YUVOutput::RGB565:
+		return vorrq_u16(vorrq_u16(vshrq_n_u16(r, 3), vshlq_n_u16(vshrq_n_u16(g, 2), 5)), vshlq_n_u16(vshrq_n_u16(b, 3), 11));
+	case YUVOutput::RGBA5551:
+		return vorrq_u16(vorrq_u16(vshrq_n_u16(r, 3), vshlq_n_u16(vshrq_n_u16(g, 3), 5)), vshlq_n_u16(vshrq_n_u16(b, 3), 10));
+	default:
+		return vorrq_u16(vorrq_u16(vshrq_n_u16(r, 4), vshlq_n_u16(vshrq_n_u16(g, 4), 4)), vshlq_n_u16(vshrq_n_u16(b, 4), 8));
+	}
+}
+#endif
+
+template <YUVOutput fmt, typename T>
+static void ConvertYUV420Line(T *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels) {
+	u32 i = 0;
+#if PPSSPP_ARCH(SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i yOffset = _mm_set1_epi16(16);
+	const __m128i uvOffset = _mm_set1_epi16(128);
+	const __m128i rounding = _mm_set1_epi16(32);
+	const __m128i yFrac = _mm_set1_epi16(YUV_Y_FRAC);
+	const __m128i rv = _mm_set1_epi16(YUV_RV);
+	const __m128i gu = _mm_set1_epi16(YUV_GU);
+	const __m128i gv = _mm_set1_epi16(YUV_GV);
+	const __m128i buFrac = _mm_set1_epi16(YUV_BU_FRAC);
+	for (; i + 16 <= numPixels; i += 16) {
+		const __m128i y8 = _mm_loadu_si128((const __m128i *)(y + i));
+		const __m128i u16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(u + i / 2)), zero), uvOffset);
+		const __m128i v16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(v + i / 2)), zero), uvOffset);
+
+		__m128i r[2], g[2], b[2];
+		for (int half = 0; half < 2; half++) {
+			// Each chroma sample covers two pixels.
+			const __m128i yh = _mm_sub_epi16(half == 0 ? _mm_unpacklo_epi8(y8, zero) : _mm_unpackhi_epi8(y8, zero), yOffset);
+			const __m128i uh = half == 0 ? _mm_unpacklo_epi16(u16, u16) : _mm_unpackhi_epi16(u16, u16);
+			const __m128i vh = half == 0 ? _mm_unpacklo_epi16(v16, v16) : _mm_unpackhi_epi16(v16, v16);
+			const __m128i uh8 = _mm_slli_epi16(uh, 8);
+			const __m128i vh8 = _mm_slli_epi16(vh, 8);
+			const __m128i yy = _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(yh, 6), _mm_mulhi_epi16(_mm_slli_epi16(yh, 7), yFrac)), rounding);
+			r[half] = _mm_srai_epi16(_mm_add_epi16(yy, _mm_mulhi_epi16(vh8, rv)), 6);
+			g[half] = _mm_srai_epi16(_mm_sub_epi16(yy, _mm_add_epi16(_mm_mulhi_epi16(uh8, gu), _mm_mulhi_epi16(vh8, gv))), 6);
+			b[half] = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yy, _mm_slli_epi16(uh, 7)), _mm_mulhi_epi16(uh8, buFrac)), 6);
+		}
+		// Clamp to 0-255.
+		const __m128i r8 = _mm_packus_epi16(r[0], r[1]);
+		const __m128i g8 = _mm_packus_epi16(g[0], g[1]);
+		const __m128i b8 = _mm_packus_epi16(b[0], b[1]);
+
+		__m128i *out = (__m128i *)(dst + i);
+		if (fmt == YUVOutput::RGBA8888) {
+			const __m128i rg0 = _mm_unpacklo_epi8(r8, g8);
+			const __m128i rg1 = _mm_unpackhi_epi8(r8, g8);
+			const __m128i ba0 = _mm_unpacklo_epi8(b8, zero);
+			const __m128i ba1 = _mm_unpackhi_epi8(b8, zero);
+			_mm_storeu_si128(out + 0, _mm_unpacklo_epi16(rg0, ba0));
+			_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg0, ba0));
+			_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rg1, ba1));
+			_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rg1, ba1));
+		} else {
+			_mm_storeu_si128(out + 0, PackYUVPixels16<fmt>(_mm_unpacklo_epi8(r8, zero), _mm_unpacklo_epi8(g8, zero), _mm_unpacklo_epi8(b8, zero)));
+			_mm_storeu_si128(out + 1, PackYUVPixels16<fmt>(_mm_unpackhi_epi8(r8, zero), _mm_unpackhi_epi8(g8, zero), _mm_unpackhi_epi8(b8, zero)));
+		}
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	const int16x8_t yOffset = vdupq_n_s16(16);
+	const int16x8_t uvOffset = vdupq_n_s16(128);
+	const int16x8_t rounding = vdupq_n_s16(32);
+	// vqdmulh doubles the product, so the inputs are shifted up one bit less than in the scalar path.
+	for (; i + 16 <= numPixels; i += 16) {
+		const uint8x16_t y8 = vld1q_u8(y + i);
+		const int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + i / 2))), uvOffset);
+		const int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + i / 2))), uvOffset);
+		// Each chroma sample covers two pixels.
+		const int16x8x2_t uz = vzipq_s16(u16, u16);
+		const int16x8x2_t vz = vzipq_s16(v16, v16);
+
+		uint8x8_t r[2], g[2], b[2];
+		for (int half = 0; half < 2; half++) {
+			const int16x8_t yh = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(half == 0 ? vget_low_u8(y8) : vget_high_u8(y8))), yOffset);
+			const int16x8_t uh = uz.val[half];
+			const int16x8_t vh = vz.val[half];
+			const int16x8_t uh7 = vshlq_n_s16(uh, 7);
+			const int16x8_t vh7 = vshlq_n_s16(vh, 7);
+			const int16x8_t yy = vaddq_s16(vaddq_s16(vshlq_n_s16(yh, 6), vqdmulhq_n_s16(vshlq_n_s16(yh, 6), YUV_Y_FRAC)), rounding);
+			// Clamp to 0-255 while narrowing.
+			r[half] = vqmovun_s16(vshrq_n_s16(vaddq_s16(yy, vqdmulhq_n_s16(vh7, YUV_RV)), 6));
+			g[half] = vqmovun_s16(vshrq_n_s16(vsubq_s16(yy, vaddq_s16(vqdmulhq_n_s16(uh7, YUV_GU), vqdmulhq_n_s16(vh7, YUV_GV))), 6));
+			b[half] = vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yy, uh7), vqdmulhq_n_s16(uh7, YUV_BU_FRAC)), 6));
+		}
+
+		if (fmt == YUVOutput::RGBA8888) {
+			uint8x16x4_t px;
+			px.val[0] = vcombine_u8(r[0], r[1]);
+			px.val[1] = vcombine_u8(g[0], g[1]);
+			px.val[2] = vcombine_u8(b[0], b[1]);
+			px.val[3] = vdupq_n_u8(0);
+			vst4q_u8((u8 *)(dst + i), px);
+		} else {
+			u16 *out = (u16 *)(dst + i);
+			vst1q_u16(out, PackYUVPixels16<fmt>(vmovl_u8(r[0]), vmovl_u8(g[0]), vmovl_u8(b[0])));
+			vst1q_u16(out + 8, PackYUVPixels16<fmt>(vmovl_u8(r[1]), vmovl_u8(g[1]), vmovl_u8(b[1])));
+		}
+	}
+#endif
+
+	for (; i < numPixels; ++i) {
+		dst[i] = (T)YUVToPixel<fmt>(y[i], u[i / 2], v[i / 2]);
+	}
+}
+
+void ConvertYUV420ToRGBA8888(u32 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels) {
+	ConvertYUV420Line<YUVOutput::RGBA8888>(dst, y, u, v, numPixels);
+}
+
+void ConvertYUV420ToRGB565(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels) {
+	ConvertYUV420Line<YUVOutput::RGB565>(dst, y, u, v, numPixels);
+}
+
+void ConvertYUV420ToRGBA5551(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels) {
+	ConvertYUV420Line<YUVOutput::RGBA5551>(dst, y, u, v, numPixels);
+}
+
+void ConvertYUV420ToRGBA4444(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels) {
+	ConvertYUV420Line<YUVOutput::RGBA4444>(dst, y, u, v, numPixels);
+}
@@ -168,3 +168,10 @@ void ConvertRGB565ToBGR565(u16 *dst, const u16 *src, u32 numPixels);
 void ConvertBGRA5551ToABGR1555(u16 *dst, const u16 *src, u32 numPixels);
 
 void ConvertRGBA8888ToPremulAlpha(u32 *dst, const u32 *src, u32 numPixels);
+
+// Converts a line of planar YUV 4:2:0 (BT.601, limited range, like PSP video) to RGB.
+// u and v point to the chroma of the line, which is shared by each pair of pixels. Alpha is left at zero.
+void ConvertYUV420ToRGBA8888(u32 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels);
+void ConvertYUV420ToRGB565(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels);
+void ConvertYUV420ToRGBA5551(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels);
+void ConvertYUV420ToRGBA4444(u16 *dst, const u8 *y, const u8 *u, const u8 *v, u32 numPixels);
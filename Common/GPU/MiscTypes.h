@@ -32,6 +32,11 @@ struct FrameTimeData {
 	double firstSubmit;
 	double queuePresent;
 
+	// Cross-thread handoff: time the emu thread spent blocked on the render thread,
+	// and time the render thread sat idle waiting for the emu thread.
+	double hostHandoffWait;
+	double renderThreadIdle;
+
 	double actualPresent;
 	double desiredPresentTime;
 	double earliestPresentTime;
@@ -51,7 +51,7 @@ struct GLFrameData {
 
 	// Frames need unique IDs to wait for present on, let's keep them here.
 	// Also used for indexing into the frame timing history buffer.
-	uint64_t frameId;
+	uint64_t frameId = 0;
 
 	std::mutex fenceMutex;
 	std::condition_variable fenceCondVar;
@@ -132,24 +132,18 @@ bool GLRenderManager::ThreadFrame(bool waitIfEmpty) {
 	while (true) {
 		// Pop a task off the queue and execute it. Exiting this loop is done with a special EXIT task,
 		// to keep things uniform.
-		{
-			std::unique_lock<std::mutex> lock(pushMutex_);
-
-			if (!waitIfEmpty && renderThreadQueue_.empty()) {
-				lock.unlock();
-				// Oh, host wanted out. Let's leave, and also let's notify the host.
-				// This is unlike Vulkan too which can just block on the thread existing.
-				std::unique_lock<std::mutex> lock(syncMutex_);
-				syncCondVar_.notify_one();
-				syncDone_ = true;
-				return false;
-			}
-
-			pushCondVar_.wait(lock, [this] { return !renderThreadQueue_.empty(); });
-			task = renderThreadQueue_.front();
-			renderThreadQueue_.pop();
+		if (!waitIfEmpty && renderThreadQueue_.Empty()) {
+			// Oh, host wanted out. Let's leave, and also let's notify the host.
+			// This is unlike Vulkan too which can just block on the thread existing.
+			std::unique_lock<std::mutex> lock(syncMutex_);
+			syncCondVar_.notify_one();
+			syncDone_ = true;
+			return false;
 		}
 
+		double idle = renderThreadQueue_.Pop(&task);
+		frameTimeHistory_[frameData_[task->frame].frameId].renderThreadIdle += idle;
+
 		// Render the scene.
 		VLOG("  PULL: Frame %d RUN (%0.3f)", task->frame, time_now_d());
 		if (Run(*task)) {
@@ -356,8 +350,12 @@ void GLRenderManager::BeginFrame(bool enableProfiling) {
 	{
 		std::unique_lock<std::mutex> lock(frameData.fenceMutex);
 		VLOG("PUSH: BeginFrame (curFrame = %d, readyForFence = %d, time=%0.3f)", curFrame, (int)frameData.readyForFence, time_now_d());
-		while (!frameData.readyForFence) {
-			frameData.fenceCondVar.wait(lock);
+		if (!frameData.readyForFence) {
+			double waitStart = time_now_d();
+			while (!frameData.readyForFence) {
+				frameData.fenceCondVar.wait(lock);
+			}
+			frameTimeData.hostHandoffWait = time_now_d() - waitStart;
 		}
 		frameData.readyForFence = false;
 	}
@@ -395,25 +393,17 @@ void GLRenderManager::Finish() {
 	VLOG("PUSH: Finish, pushing task. curFrame = %d", curFrame);
 	GLRRenderThreadTask *task = new GLRRenderThreadTask(GLRRunType::SUBMIT);
 	task->frame = curFrame;
-	{
-		std::unique_lock<std::mutex> lock(pushMutex_);
-		task->initSteps = std::move(initSteps_);
-		task->steps = std::move(steps_);
-		renderThreadQueue_.push(task);
-		initSteps_.clear();
-		steps_.clear();
-		pushCondVar_.notify_one();
-	}
+	task->initSteps = std::move(initSteps_);
+	task->steps = std::move(steps_);
+	initSteps_.clear();
+	steps_.clear();
+	PushRenderThreadTask(task);
 }
 
 void GLRenderManager::Present() {
 	GLRRenderThreadTask *presentTask = new GLRRenderThreadTask(GLRRunType::PRESENT);
 	presentTask->frame = curFrame_;
-	{
-		std::unique_lock<std::mutex> lock(pushMutex_);
-		renderThreadQueue_.push(presentTask);
-		pushCondVar_.notify_one();
-	}
+	PushRenderThreadTask(presentTask);
 
 	int newCurFrame = curFrame_ + 1;
 	if (newCurFrame >= inflightFrames_) {
@@ -528,18 +518,25 @@ bool GLRenderManager::Run(GLRRenderThreadTask &task) {
 	return false;
 }
 
+// Called on the emu thread. If the ring is full (shouldn't happen), the wait is charged to the host side of the frame.
+void GLRenderManager::PushRenderThreadTask(GLRRenderThreadTask *task) {
+	// The render thread owns the task as soon as it's pushed, so grab this first.
+	uint64_t frameId = frameData_[task->frame].frameId;
+	double wait = renderThreadQueue_.Push(task);
+	if (wait > 0.0) {
+		frameTimeHistory_[frameId].hostHandoffWait += wait;
+	}
+}
+
 void GLRenderManager::FlushSync() {
 	{
 		VLOG("PUSH: Frame[%d].readyForRun = true (sync)", curFrame_);
 
 		GLRRenderThreadTask *task = new GLRRenderThreadTask(GLRRunType::SYNC);
 		task->frame = curFrame_;
-
-		std::unique_lock<std::mutex> lock(pushMutex_);
-		renderThreadQueue_.push(task);
-		renderThreadQueue_.back()->initSteps = std::move(initSteps_);
-		renderThreadQueue_.back()->steps = std::move(steps_);
-		pushCondVar_.notify_one();
+		task->initSteps = std::move(initSteps_);
+		task->steps = std::move(steps_);
+		PushRenderThreadTask(task);
 		steps_.clear();
 	}
 
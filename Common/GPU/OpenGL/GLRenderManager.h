@@ -14,6 +14,7 @@
 #include "Common/GPU/MiscTypes.h"
 #include "Common/Data/Convert/SmallDataConvert.h"
 #include "Common/Log.h"
+#include "Common/Thread/SPSCRing.h"
 #include "Common/GPU/OpenGL/GLQueueRunner.h"
 #include "Common/GPU/OpenGL/GLFrameData.h"
 #include "Common/GPU/OpenGL/GLCommon.h"
@@ -849,6 +850,7 @@ class GLRenderManager {
 
 	// Bad for performance but sometimes necessary for synchronous CPU readbacks (screenshots and whatnot).
 	void FlushSync();
+	void PushRenderThreadTask(GLRRenderThreadTask *task);
 
 	// When using legacy functionality for push buffers (glBufferData), we need to flush them
 	// before actually making the glDraw* calls. It's best if the render manager handles that.
@@ -872,11 +874,9 @@ class GLRenderManager {
 	// Thread is managed elsewhere, and should call ThreadFrame.
 	GLQueueRunner queueRunner_;
 
-	// For pushing data on the queue.
-	std::mutex pushMutex_;
-	std::condition_variable pushCondVar_;
-
-	std::queue<GLRRenderThreadTask *> renderThreadQueue_;
+	// Tasks for the render thread. Only the emu thread pushes, and only the render thread pops.
+	// The number of tasks in flight is bounded by the per-frame fence in BeginFrame.
+	SPSCRing<GLRRenderThreadTask *, 32> renderThreadQueue_;
 
 	// For readbacks and other reasons we need to sync with the render thread.
 	std::mutex syncMutex_;
@@ -451,11 +451,7 @@ void VulkanRenderManager::StopThreads() {
 		// Tell the render thread to quit when it's done.
 		VKRRenderThreadTask *task = new VKRRenderThreadTask(VKRRunType::EXIT);
 		task->frame = vulkan_->GetCurFrame();
-		{
-			std::unique_lock<std::mutex> lock(pushMutex_);
-			renderThreadQueue_.push(task);
-		}
-		pushCondVar_.notify_one();
+		PushRenderThreadTask(task);
 		// Once the render thread encounters the above exit task, it'll exit.
 		renderThread_.join();
 		INFO_LOG(Log::G3D, "Vulkan submission thread joined. Frame=%d", vulkan_->GetCurFrame());
@@ -615,17 +611,9 @@ void VulkanRenderManager::RenderThreadFunc() {
 
 		// Pop a task of the queue and execute it.
 		VKRRenderThreadTask *task = nullptr;
-		{
-			std::unique_lock<std::mutex> lock(pushMutex_);
-			while (renderThreadQueue_.empty()) {
-				pushCondVar_.wait(lock);
-			}
-			task = renderThreadQueue_.front();
-			renderThreadQueue_.pop();
-		}
+		double idle = renderThreadQueue_.Pop(&task);
 
-		// Oh, we got a task! We can now have pushMutex_ unlocked, allowing the host to
-		// push more work when it feels like it, and just start working.
+		// Oh, we got a task! The host can keep pushing more work while we're on it.
 		if (task->runType == VKRRunType::EXIT) {
 			// Oh, host wanted out. Let's leave.
 			delete task;
@@ -633,6 +621,8 @@ void VulkanRenderManager::RenderThreadFunc() {
 			break;
 		}
 
+		// Charge the time we sat idle to the frame that finally gave us work.
+		frameTimeHistory_[frameData_[task->frame].frameId].renderThreadIdle += idle;
 		Run(*task);
 		delete task;
 	}
@@ -696,7 +686,7 @@ void VulkanRenderManager::PollPresentTiming() {
 }
 
 void VulkanRenderManager::BeginFrame(bool enableProfiling, bool enableLogProfiler) {
-	double frameBeginTime = time_now_d()
+	double frameBeginTime = time_now_d();
 	VLOG("BeginFrame");
 	VkDevice device = vulkan_->GetDevice();
 
@@ -706,10 +696,15 @@ void VulkanRenderManager::BeginFrame(bool enableProfiling, bool enableLogProfile
 
 	// Makes sure the submission from the previous time around has happened. Otherwise
 	// we are not allowed to wait from another thread here..
+	double hostHandoffWait = 0.0;
 	if (useRenderThread_) {
 		std::unique_lock<std::mutex> lock(frameData.fenceMutex);
-		while (!frameData.readyForFence) {
-			frameData.fenceCondVar.wait(lock);
+		if (!frameData.readyForFence) {
+			double waitStart = time_now_d();
+			while (!frameData.readyForFence) {
+				frameData.fenceCondVar.wait(lock);
+			}
+			hostHandoffWait = time_now_d() - waitStart;
 		}
 		frameData.readyForFence = false;
 	}
@@ -733,6 +728,7 @@ void VulkanRenderManager::BeginFrame(bool enableProfiling, bool enableLogProfile
 	frameTimeData.frameId = frameId;
 	frameTimeData.frameBegin = frameBeginTime;
 	frameTimeData.afterFenceWait = time_now_d();
+	frameTimeData.hostHandoffWait = hostHandoffWait;
 
 	// Can't set this until after the fence.
 	frameData.profile.enabled = enableProfiling;
@@ -1556,10 +1552,8 @@ void VulkanRenderManager::Finish() {
 	VKRRenderThreadTask *task = new VKRRenderThreadTask(VKRRunType::SUBMIT);
 	task->frame = curFrame;
 	if (useRenderThread_) {
-		std::unique_lock<std::mutex> lock(pushMutex_);
-		renderThreadQueue_.push(task);
-		renderThreadQueue_.back()->steps = std::move(steps_);
-		pushCondVar_.notify_one();
+		task->steps = std::move(steps_);
+		PushRenderThreadTask(task);
 	} else {
 		// Just do it!
 		task->steps = std::move(steps_);
@@ -1576,9 +1570,7 @@ void VulkanRenderManager::Present() {
 	VKRRenderThreadTask *task = new VKRRenderThreadTask(VKRRunType::PRESENT);
 	task->frame = curFrame;
 	if (useRenderThread_) {
-		std::unique_lock<std::mutex> lock(pushMutex_);
-		renderThreadQueue_.push(task);
-		pushCondVar_.notify_one();
+		PushRenderThreadTask(task);
 	} else {
 		// Just do it!
 		Run(*task);
@@ -1589,6 +1581,16 @@ void VulkanRenderManager::Present() {
 	insideFrame_ = false;
 }
 
+// Called on the emu thread. If the ring is full (shouldn't happen), the wait is charged to the host side of the frame.
+void VulkanRenderManager::PushRenderThreadTask(VKRRenderThreadTask *task) {
+	// The render thread owns the task as soon as it's pushed, so grab this first.
+	uint64_t frameId = frameData_[task->frame].frameId;
+	double wait = renderThreadQueue_.Push(task);
+	if (wait > 0.0) {
+		frameTimeHistory_[frameId].hostHandoffWait += wait;
+	}
+}
+
 // Called on the render thread.
 //
 // Can be called again after a VKRRunType::SYNC on the same frame.
@@ -1705,12 +1707,8 @@ void VulkanRenderManager::FlushSync() {
 			VLOG("PUSH: Frame[%d]", curFrame);
 			VKRRenderThreadTask *task = new VKRRenderThreadTask(VKRRunType::SYNC);
 			task->frame = curFrame;
-			{
-				std::unique_lock<std::mutex> lock(pushMutex_);
-				renderThreadQueue_.push(task);
-				renderThreadQueue_.back()->steps = std::move(steps_);
-				pushCondVar_.notify_one();
-			}
+			task->steps = std::move(steps_);
+			PushRenderThreadTask(task);
 			steps_.clear();
 		}
 
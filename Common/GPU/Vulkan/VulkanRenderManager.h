@@ -13,6 +13,7 @@
 
 #include "Common/Math/Statistics.h"
 #include "Common/Thread/Promise.h"
+#include "Common/Thread/SPSCRing.h"
 #include "Common/System/Display.h"
 #include "Common/GPU/Vulkan/VulkanContext.h"
 #include "Common/GPU/Vulkan/VulkanBarrier.h"
@@ -554,6 +555,7 @@ class VulkanRenderManager {
 	void CompileThreadFunc();
 
 	void Run(VKRRenderThreadTask &task);
+	void PushRenderThreadTask(VKRRenderThreadTask *task);
 
 	// Bad for performance but sometimes necessary for synchronous CPU readbacks (screenshots and whatnot).
 	void FlushSync();
@@ -606,11 +608,9 @@ class VulkanRenderManager {
 	std::thread renderThread_;
 	VulkanQueueRunner queueRunner_;
 
-	// For pushing data on the queue.
-	std::mutex pushMutex_;
-	std::condition_variable pushCondVar_;
-
-	std::queue<VKRRenderThreadTask *> renderThreadQueue_;
+	// Tasks for the render thread. Only the emu thread pushes, and only the render thread pops.
+	// The number of tasks in flight is bounded by the per-frame fence in BeginFrame, so this never fills up in practice.
+	SPSCRing<VKRRenderThreadTask *, 32> renderThreadQueue_;
 
 	// For readbacks and other reasons we need to sync with the render thread.
 	std::mutex syncMutex_;
@@ -630,6 +630,7 @@ struct DeviceCaps {
 	bool sampleRateShadingSupported;
 	bool setMaxFrameLatencySupported;
 	bool textureSwizzleSupported;
+	bool asyncReadbackSupported;  // ReadbackMode::OLD_DATA_OK returns earlier results instead of waiting.
 	bool requiresHalfPixelOffset;
 	bool provokingVertexLast;  // GL behavior, what the PSP does
 	bool verySlowShaderCompiler;
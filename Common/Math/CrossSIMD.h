@@ -125,6 +125,11 @@ struct Vec4S32 {
 	void Store(int *dst) { _mm_storeu_si128((__m128i *)dst, v); }
 	void Store2(int *dst) { _mm_storel_epi64((__m128i *)dst, v); }
 	void StoreAligned(int *dst) { _mm_store_si128((__m128i *)dst, v);}
+	// Sign-extends four 16-bit values.
+	static Vec4S32 LoadS16(const int16_t *src) { __m128i value = _mm_loadl_epi64((const __m128i *)src); return Vec4S32{ _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16) }; }
+	// Narrows with signed saturation, like clamp_s16.
+	void StoreS16(int16_t *dst) const { _mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(v, v)); }
+	Vec4S32 ClampS16() const { __m128i packed = _mm_packs_epi32(v, v); return Vec4S32{ _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16) }; }
 
 	Vec4S32 SignBits32ToMask() {
 		return Vec4S32{
@@ -166,6 +171,9 @@ struct Vec4S32 {
 
 	template<int imm>
 	Vec4S32 Shl() const { return Vec4S32{ imm == 0 ? v : _mm_slli_epi32(v, imm) }; }
+	// Arithmetic (sign-preserving) shift.
+	template<int imm>
+	Vec4S32 Shr() const { return Vec4S32{ imm == 0 ? v : _mm_srai_epi32(v, imm) }; }
 
 	// NOTE: May be slow.
 	int operator[](size_t index) const { return ((int *)&v)[index]; }
@@ -552,6 +560,11 @@ struct Vec4S32 {
 	void Store(int *dst) { vst1q_s32(dst, v); }
 	void Store2(int *dst) { vst1_s32(dst, vget_low_s32(v)); }
 	void StoreAligned(int *dst) { vst1q_s32(dst, v); }
+	// Sign-extends four 16-bit values.
+	static Vec4S32 LoadS16(const int16_t *src) { return Vec4S32{ vmovl_s16(vld1_s16(src)) }; }
+	// Narrows with signed saturation, like clamp_s16.
+	void StoreS16(int16_t *dst) const { vst1_s16(dst, vqmovn_s32(v)); }
+	Vec4S32 ClampS16() const { return Vec4S32{ vmovl_s16(vqmovn_s32(v)) }; }
 
 	// Warning: Unlike on x86, this is a full 32-bit multiplication.
 	Vec4S32 Mul16(Vec4S32 other) const { return Vec4S32{ vmulq_s32(v, other.v) }; }
@@ -579,6 +592,9 @@ struct Vec4S32 {
 
 	template<int imm>
 	Vec4S32 Shl() const { return Vec4S32{ vshlq_n_s32(v, imm) }; }
+	// Arithmetic (sign-preserving) shift.
+	template<int imm>
+	Vec4S32 Shr() const { return Vec4S32{ vshrq_n_s32(v, imm) }; }
 
 	void operator +=(Vec4S32 other) { v = vaddq_s32(v, other.v); }
 	void operator -=(Vec4S32 other) { v = vsubq_s32(v, other.v); }
@@ -1018,6 +1034,11 @@ struct Vec4S32 {
 	void Store(int *dst) { __lsx_vst(v, dst, 0); }
 	void Store2(int *dst) { __lsx_vstelm_d(v, dst, 0, 0); }
 	void StoreAligned(int *dst) { __lsx_vst(v, dst, 0); }
+	// Sign-extends four 16-bit values.
+	static Vec4S32 LoadS16(const int16_t *src) { return Vec4S32{ __lsx_vsllwil_w_h(__lsx_vldrepl_d(src, 0), 0) }; }
+	// Narrows with signed saturation, like clamp_s16.
+	void StoreS16(int16_t *dst) const { __lsx_vstelm_d(__lsx_vssrani_h_w(v, v, 0), dst, 0, 0); }
+	Vec4S32 ClampS16() const { return Vec4S32{ __lsx_vsat_w(v, 15) }; }
 
 	// Warning: Unlike on x86, this is a full 32-bit multiplication.
 	Vec4S32 Mul16(Vec4S32 other) const { return Vec4S32{ __lsx_vmul_w(v, other.v) }; }
@@ -1045,6 +1066,9 @@ struct Vec4S32 {
 
 	template<int imm>
 	Vec4S32 Shl() const { return Vec4S32{ __lsx_vslli_w(v, imm) }; }
+	// Arithmetic (sign-preserving) shift.
+	template<int imm>
+	Vec4S32 Shr() const { return Vec4S32{ __lsx_vsrai_w(v, imm) }; }
 
 	void operator +=(Vec4S32 other) { v = __lsx_vadd_w(v, other.v); }
 	void operator -=(Vec4S32 other) { v = __lsx_vsub_w(v, other.v); }
@@ -1408,6 +1432,20 @@ struct Vec4S32 {
 	void Store(int *dst) { memcpy(dst, v, sizeof(v)); }
 	void Store2(int *dst) { memcpy(dst, v, sizeof(v[0]) * 2); }
 	void StoreAligned(int *dst) { memcpy(dst, v, sizeof(v)); }
+	// Sign-extends four 16-bit values.
+	static Vec4S32 LoadS16(const int16_t *src) { return Vec4S32{ { src[0], src[1], src[2], src[3] } }; }
+	// Narrows with signed saturation, like clamp_s16.
+	void StoreS16(int16_t *dst) const {
+		Vec4S32 clamped = ClampS16();
+		for (int i = 0; i < 4; i++)
+			dst[i] = (int16_t)clamped.v[i];
+	}
+	Vec4S32 ClampS16() const {
+		Vec4S32 result;
+		for (int i = 0; i < 4; i++)
+			result.v[i] = v[i] < -32768 ? -32768 : (v[i] > 32767 ? 32767 : v[i]);
+		return result;
+	}
 
 	// Warning: Unlike on x86 SSE2, this is a full 32-bit multiplication.
 	Vec4S32 Mul16(Vec4S32 other) const { return Vec4S32{ { v[0] * other.v[0], v[1] * other.v[1], v[2] * other.v[2], v[3] * other.v[3] } }; }
@@ -1470,6 +1508,9 @@ struct Vec4S32 {
 
 	template<int imm>
 	Vec4S32 Shl() const { return Vec4S32{ { v[0] << imm, v[1] << imm, v[2] << imm, v[3] << imm } }; }
+	// Arithmetic (sign-preserving) shift.
+	template<int imm>
+	Vec4S32 Shr() const { return Vec4S32{ { v[0] >> imm, v[1] >> imm, v[2] >> imm, v[3] >> imm } }; }
 
 	Vec4S32 CompareEq(Vec4S32 other) const {
 		Vec4S32 out;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "Common/TimeUtil.h"
+
+// Fixed-size lock-free ring for exactly one producer thread and one consumer thread.
+//
+// Push and pop are plain atomics. When the ring is empty, the consumer can go to sleep
+// on a condition variable. The producer only takes the mutex when it has to wake it up,
+// so a busy handoff never touches a lock. The blocking calls return how long they
+// waited, so callers can measure cross-thread latency.
+template <class T, size_t N>
+class SPSCRing {
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+	// Producer only. Returns false if the ring is full.
+	bool TryPush(const T &value) {
+		size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == N)
+			return false;
+		items_[head & (N - 1)] = value;
+		// seq_cst pairs with the consumerWaiting_ store in Pop(), so that at least one of us sees the other.
+		head_.store(head + 1, std::memory_order_seq_cst);
+		if (consumerWaiting_.load(std::memory_order_seq_cst)) {
+			std::lock_guard<std::mutex> guard(mutex_);
+			cond_.notify_one();
+		}
+		return true;
+	}
+
+	// Producer only. If the ring is full, yields until there's room. Returns the seconds spent waiting.
+	double Push(const T &value) {
+		if (TryPush(value))
+			return 0.0;
+		double start = time_now_d();
+		while (!TryPush(value))
+			std::this_thread::yield();
+		return time_now_d() - start;
+	}
+
+	// Consumer only. Returns false if the ring is empty.
+	bool TryPop(T *value) {
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		if (head_.load(std::memory_order_acquire) == tail)
+			return false;
+		*value = items_[tail & (N - 1)];
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Blocks until there's something to pop. Returns the seconds spent waiting.
+	double Pop(T *value) {
+		if (TryPop(value))
+			return 0.0;
+		double start = time_now_d();
+		while (!TryPop(value)) {
+			std::unique_lock<std::mutex> lock(mutex_);
+			consumerWaiting_.store(true, std::memory_order_seq_cst);
+			if (head_.load(std::memory_order_seq_cst) == tail_.load(std::memory_order_relaxed))
+				cond_.wait(lock);
+			consumerWaiting_.store(false, std::memory_order_relaxed);
+		}
+		return time_now_d() - start;
+	}
+
+	// Only exact when called from the consumer.
+	bool Empty() const {
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+	}
+
+private:
+	T items_[N]{};
+	// Keep the two indices on separate cache lines, they're written by different threads.
+	alignas(64) std::atomic<size_t> head_{};
+	alignas(64) std::atomic<size_t> tail_{};
+	std::atomic<bool> consumerWaiting_{};
+	std::mutex mutex_;
+	std::condition_variable cond_;
+};
@@ -723,6 +723,7 @@ static const ConfigSetting graphicsSettings[] = {
 	ConfigSetting("SoftwareRendererJit", SETTING(g_Config, bSoftwareRenderingJit), true, CfgFlag::PER_GAME),
 	ConfigSetting("HardwareTransform", SETTING(g_Config, bHardwareTransform), true, CfgFlag::PER_GAME | CfgFlag::REPORT),
 	ConfigSetting("SoftwareSkinning", SETTING(g_Config, bSoftwareSkinning), true, CfgFlag::PER_GAME | CfgFlag::REPORT),
+	ConfigSetting("VertexDecodeCache", SETTING(g_Config, bVertexDecodeCache), false, CfgFlag::PER_GAME | CfgFlag::REPORT),
 	ConfigSetting("TextureFiltering", SETTING(g_Config, iTexFiltering), 1, CfgFlag::PER_GAME | CfgFlag::REPORT),
 	ConfigSetting("Smart2DTexFiltering", SETTING(g_Config, bSmart2DTexFiltering), false, CfgFlag::PER_GAME | CfgFlag::REPORT),
 	ConfigSetting("InternalResolution", SETTING(g_Config, iInternalResolution), &DefaultInternalResolution, CfgFlag::PER_GAME | CfgFlag::REPORT),
@@ -779,6 +780,7 @@ static const ConfigSetting graphicsSettings[] = {
 	ConfigSetting("ShaderChainRequires60FPS", SETTING(g_Config, bShaderChainRequires60FPS), false, CfgFlag::PER_GAME),
 
 	ConfigSetting("SkipGPUReadbackMode", SETTING(g_Config, iSkipGPUReadbackMode), false, CfgFlag::PER_GAME | CfgFlag::REPORT),
+	ConfigSetting("AsyncReadback", SETTING(g_Config, bAsyncReadback), false, CfgFlag::PER_GAME | CfgFlag::REPORT),
 
 	ConfigSetting("GfxDebugOutput", SETTING(g_Config, bGfxDebugOutput), false, CfgFlag::DONT_SAVE),
 	ConfigSetting("LogFrameDrops", SETTING(g_Config, bLogFrameDrops), false, CfgFlag::DEFAULT),
@@ -789,6 +791,7 @@ static const ConfigSetting graphicsSettings[] = {
 	ConfigSetting("MultiThreading", SETTING(g_Config, bRenderMultiThreading), true, CfgFlag::DEFAULT),
 
 	ConfigSetting("ShaderCache", SETTING(g_Config, bShaderCache), true, CfgFlag::DEFAULT),
+	ConfigSetting("ShaderCacheSPIRV", SETTING(g_Config, bShaderCacheSPIRV), false, CfgFlag::DEFAULT),
 	ConfigSetting("GpuLogProfiler", SETTING(g_Config, bGpuLogProfiler), false, CfgFlag::DEFAULT),
 
 	ConfigSetting("UberShaderVertex", SETTING(g_Config, bUberShaderVertex), true, CfgFlag::DEFAULT),
@@ -863,6 +866,10 @@ static const ConfigSetting soundSettings[] = {
 	ConfigSetting("AudioMixWithOthers", SETTING(g_Config, bAudioMixWithOthers), &DefaultAudioMixWithOthers, CfgFlag::DEFAULT),
 	ConfigSetting("AudioRespectSilentMode", SETTING(g_Config, bAudioRespectSilentMode), false, CfgFlag::DEFAULT),
 	ConfigSetting("UseOldAtrac", SETTING(g_Config, bUseOldAtrac), false, CfgFlag::DEFAULT),
+	ConfigSetting("SasVagCache", SETTING(g_Config, bSasVagCache), false, CfgFlag::DEFAULT),
+	ConfigSetting("AtracSpeculativeDecode", SETTING(g_Config, bAtracSpeculativeDecode), false, CfgFlag::DEFAULT),
+	ConfigSetting("AudioLatencyMs", SETTING(g_Config, iAudioLatencyMs), 0, CfgFlag::DEFAULT),
+	ConfigSetting("AudioResampler", SETTING(g_Config, iAudioResampler), (int)AudioResampler::LINEAR, CfgFlag::DEFAULT),
 };
 
 static bool DefaultShowTouchControls() {
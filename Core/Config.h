@@ -286,6 +286,7 @@ struct Config : public ConfigBlock {
 	bool bSoftwareRenderingJit;
 	bool bHardwareTransform;
 	bool bSoftwareSkinning;
+	bool bVertexDecodeCache;
 	bool bVendorBugChecksEnabled;
 	bool bUseGeometryShader;
 
@@ -361,9 +362,11 @@ struct Config : public ConfigBlock {
 	float fRemoteScrollPosition;
 	int iBloomHack; //0 = off, 1 = safe, 2 = balanced, 3 = aggressive
 	int iSkipGPUReadbackMode;  // 0 = off, 1 = skip, 2 = to texture
+	bool bAsyncReadback;
 	int iSplineBezierQuality; // 0 = low , 1 = Intermediate , 2 = High
 	bool bHardwareTessellation;
 	bool bShaderCache;  // Hidden ini-only setting, useful for debugging shader compile times.
+	bool bShaderCacheSPIRV;  // Hidden ini-only setting. Vulkan: also store compiled SPIR-V in the shader cache.
 	bool bUberShaderVertex;
 	bool bUberShaderFragment;
 	int iDefaultTab;
@@ -413,6 +416,10 @@ struct Config : public ConfigBlock {
 	std::string sAudioDevice;
 	bool bAutoSwitchAudioDevice;
 	bool bUseOldAtrac;
+	bool bSasVagCache;  // Hidden ini-only setting. Cache decoded VAG samples of one-shot SAS voices.
+	bool bAtracSpeculativeDecode;  // Hidden ini-only setting. Decode upcoming Atrac packets on a worker thread.
+	int iAudioLatencyMs;  // Hidden ini-only setting. Target output latency of the mixers, 0 = automatic.
+	int iAudioResampler;  // Hidden ini-only setting. AudioResampler, only used by the classic playback mode.
 
 	// iOS only for now
 	bool bAudioMixWithOthers;
@@ -146,6 +146,13 @@ enum class AudioSyncMode {
 	CLASSIC_PITCH = 1,
 };
 
+// Interpolation used by the classic resampler.
+enum class AudioResampler {
+	LINEAR = 0,
+	SINC_FIXED = 1,
+	SINC_FLOAT = 2,
+};
+
 // TODO: We can make this more fine-grained.
 enum class RestoreSettingsBits : int {
 	SETTINGS = 1,
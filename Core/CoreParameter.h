@@ -62,6 +62,9 @@ struct CoreParameter {
 	bool startBreak = false;
 	std::string *collectDebugOutput = nullptr;
 	bool headLess = false;   // Try to avoid messageboxes etc
+	// Software renderer only: keep rasterizing on worker threads past the end of each display list,
+	// and only wait at GE syncs, framebuffer reads and overlapping transfers. For headless throughput runs.
+	bool softGPUDeferListFlush = false;
 
 	// Internal PSP rendering resolution and scale factor.
 	int renderScaleFactor = 1;
@@ -20,6 +20,7 @@
 #include "Core/Debugger/WebSocket/GPURecordSubscriber.h"
 #include "Core/Debugger/WebSocket/WebSocketUtils.h"
 #include "Core/System.h"
+#include "GPU/Debugger/Playback.h"
 #include "GPU/Debugger/Record.h"
 #include "GPU/GPU.h"
 #include "GPU/GPUCommon.h"
@@ -27,6 +28,8 @@
 struct WebSocketGPURecordState : public DebuggerSubscriber {
 	~WebSocketGPURecordState();
 	void Dump(DebuggerRequest &req);
+	void ReplayFrames(DebuggerRequest &req);
+	void ReplaySeek(DebuggerRequest &req);
 
 	void Broadcast(net::WebSocketServer *ws) override;
 
@@ -39,6 +42,8 @@ struct WebSocketGPURecordState : public DebuggerSubscriber {
 DebuggerSubscriber *WebSocketGPURecordInit(DebuggerEventHandlerMap &map) {
 	auto p = new WebSocketGPURecordState();
 	map["gpu.record.dump"] = [p](DebuggerRequest &req) { p->Dump(req); };
+	map["gpu.record.replayFrames"] = [p](DebuggerRequest &req) { p->ReplayFrames(req); };
+	map["gpu.record.replaySeek"] = [p](DebuggerRequest &req) { p->ReplaySeek(req); };
 
 	return p;
 }
@@ -51,7 +56,8 @@ WebSocketGPURecordState::~WebSocketGPURecordState() {
 
 // Begin recording (gpu.record.dump)
 //
-// No parameters.
+// Parameters:
+//  - frames: optional number of consecutive frames to record, default 1.
 //
 // Response (same event name):
 //  - uri: data: URI containing debug dump data.
@@ -62,7 +68,11 @@ void WebSocketGPURecordState::Dump(DebuggerRequest &req) {
 		return req.Fail("CPU not started");
 	}
 
-	bool result = gpu->GetRecorder()->RecordNextFrame([=](const Path &filename) {
+	u32 frames = 1;
+	if (!req.ParamU32("frames", &frames, false, DebuggerParamType::OPTIONAL))
+		return;
+
+	bool result = gpu->GetRecorder()->RecordNextFrames((int)frames, [=](const Path &filename) {
 		lastFilename_ = filename;
 		pending_ = false;
 	});
@@ -77,6 +87,34 @@ void WebSocketGPURecordState::Dump(DebuggerRequest &req) {
 	lastTicket_ = value ? json_stringify(value) : "";
 }
 
+// Get the number of frames in the loaded GE dump (gpu.record.replayFrames)
+//
+// No parameters.
+//
+// Response (same event name):
+//  - frames: number of frames, 0 if no dump is loaded.
+void WebSocketGPURecordState::ReplayFrames(DebuggerRequest &req) {
+	JsonWriter &json = req.Respond();
+	json.writeInt("frames", GPURecord::Replay_GetFrameCount());
+}
+
+// Choose the next frame of a multi-frame GE dump to replay (gpu.record.replaySeek)
+//
+// Parameters:
+//  - frame: zero-based frame index, less than the count from gpu.record.replayFrames.
+//
+// No response data.
+void WebSocketGPURecordState::ReplaySeek(DebuggerRequest &req) {
+	u32 frame = 0;
+	if (!req.ParamU32("frame", &frame))
+		return;
+	if (frame >= (u32)GPURecord::Replay_GetFrameCount())
+		return req.Fail("Frame out of range");
+
+	GPURecord::Replay_SeekFrame((int)frame);
+	req.Respond();
+}
+
 // This handles the asynchronous gpu.record.dump response.
 void WebSocketGPURecordState::Broadcast(net::WebSocketServer *ws) {
 	if (!lastFilename_.empty()) {
@@ -22,6 +22,7 @@
 #include "Core/Debugger/WebSocket/GPUStatsSubscriber.h"
 #include "Core/HW/Display.h"
 #include "Core/System.h"
+#include "GPU/GPU.h"
 
 struct CollectedStats {
 	float vps;
@@ -73,6 +74,7 @@ struct WebSocketGPUStatsState : public DebuggerSubscriber {
 	~WebSocketGPUStatsState();
 	void Get(DebuggerRequest &req);
 	void Feed(DebuggerRequest &req);
+	void History(DebuggerRequest &req);
 
 	void Broadcast(net::WebSocketServer *ws) override;
 
@@ -93,6 +95,7 @@ DebuggerSubscriber *WebSocketGPUStatsInit(DebuggerEventHandlerMap &map) {
 	auto p = new WebSocketGPUStatsState();
 	map["gpu.stats.get"] = [p](DebuggerRequest &req) { p->Get(req); };
 	map["gpu.stats.feed"] = [p](DebuggerRequest &req) { p->Feed(req); };
+	map["gpu.stats.history"] = [p](DebuggerRequest &req) { p->History(req); };
 
 	return p;
 }
@@ -190,6 +193,46 @@ void WebSocketGPUStatsState::Feed(DebuggerRequest &req) {
 	}
 }
 
+// Get recent per-frame GPU counters (gpu.stats.history)
+//
+// Parameters:
+//  - after: optional number, only return frames with a higher id (pass the last id you got to poll.)
+//  - count: optional number, maximum frames to return (newest ones), default and max 600.
+//
+// Response (same event name):
+//  - frames: array of objects, oldest first, each with:
+//     - id: number, increasing per frame.
+//     - flips: number, total flips when the frame was recorded.
+//     - timestamp: number, host time in seconds when recorded.
+//     - frameTime: number, seconds since the previous frame.
+//     - numDrawCalls, numTextureInvalidations, numFBOsCreated, etc.: the per-frame counters.
+//  - last: number, id of the newest frame returned (or the after parameter if none.)
+//
+// Note: frames are recorded whenever per-frame stats are reset, even if stats collection is off.
+// Some counters (like timings) are only valid while collecting, see gpu.stats.feed.
+void WebSocketGPUStatsState::History(DebuggerRequest &req) {
+	uint32_t after = 0;
+	uint32_t count = GPUStatsHistory::SIZE;
+	if (!req.ParamU32("after", &after, false, DebuggerParamType::OPTIONAL))
+		return;
+	if (!req.ParamU32("count", &count, false, DebuggerParamType::OPTIONAL))
+		return;
+	if (count > GPUStatsHistory::SIZE)
+		count = GPUStatsHistory::SIZE;
+
+	std::vector<GPUStatsFrameRecord> records = gpuStatsHistory.GetSince(after, (int)count);
+
+	JsonWriter &json = req.Respond();
+	json.pushArray("frames");
+	for (const GPUStatsFrameRecord &record : records) {
+		json.pushDict();
+		GPUStatsFrameRecordToJSON(json, record);
+		json.pop();
+	}
+	json.pop();
+	json.writeUint("last", records.empty() ? after : records.back().id);
+}
+
 void WebSocketGPUStatsState::Broadcast(net::WebSocketServer *ws) {
 	std::lock_guard<std::mutex> guard(pendingLock_);
 	if (lastTicket_.empty() && !sendFeed_) {
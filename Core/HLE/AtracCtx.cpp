@@ -151,7 +151,7 @@ void Atrac::DoState(PointerWrap &p) {
 }
 
 void Atrac::ResetData() {
-	delete decoder_;
+	ReleaseAudioDecoder(decoder_);
 	decoder_ = nullptr;
 
 	if (dataBuf_)
@@ -169,7 +169,7 @@ u8 *Atrac::BufferStart() {
 }
 
 AtracBase::~AtracBase() {
-	delete decoder_;
+	ReleaseAudioDecoder(decoder_);
 }
 
 void Atrac::UpdateContextFromPSPMem() {
@@ -303,7 +303,7 @@ void Atrac::CalculateStreamInfo(u32 *outReadOffset) {
 
 void AtracBase::CreateDecoder(int codecType, int bytesPerFrame, int channels) {
 	if (decoder_) {
-		delete decoder_;
+		ReleaseAudioDecoder(decoder_);
 	}
 
 	// First, init the standalone decoder.
@@ -320,9 +320,9 @@ void AtracBase::CreateDecoder(int codecType, int bytesPerFrame, int channels) {
 		extraData[6] = jointStereo;
 		extraData[8] = jointStereo;
 		extraData[10] = 1;
-		decoder_ = CreateAtrac3Audio(channels, bytesPerFrame, extraData, sizeof(extraData));
+		decoder_ = CreateAtracAudioDecoder(PSP_CODEC_AT3, channels, bytesPerFrame, extraData, sizeof(extraData));
 	} else {
-		decoder_ = CreateAtrac3PlusAudio(channels, bytesPerFrame);
+		decoder_ = CreateAtracAudioDecoder(PSP_CODEC_AT3PLUS, channels, bytesPerFrame);
 	}
 }
 
@@ -14,6 +14,8 @@
 #include "Core/Config.h"
 #include "Core/MemMap.h"
 #include "Common/File/FileUtil.h"
+#include "Common/Thread/Promise.h"
+#include "Common/Thread/ThreadManager.h"
 
 // Convenient command line:
 // Windows\x64\debug\PPSSPPHeadless.exe  --root pspautotests/tests/../ -o --compare --new-atrac --timeout=30 --graphics=software pspautotests/tests/audio/atrac/stream.prx
@@ -311,6 +313,7 @@ Atrac2::Atrac2(u32 contextAddr, int codecType) {
 }
 
 Atrac2::~Atrac2() {
+	StopSpeculation();
 	DumpBufferToFile();
 	delete[] decodeTemp_;
 	// Nothing else to do here, the context is freed by the HLE.
@@ -356,6 +359,7 @@ void Atrac2::DoState(PointerWrap &p) {
 
 	const SceAtracIdInfo &info = context_->info;
 	if (p.mode == p.MODE_READ && info.state != ATRAC_STATUS_NO_DATA) {
+		StopSpeculation();
 		CreateDecoder(info.codec, info.sampleSize, info.numChan);
 	}
 }
@@ -381,6 +385,7 @@ int Atrac2::GetSoundSample(int *outEndSample, int *outLoopStartSample, int *outL
 
 int Atrac2::ResetPlayPosition(int seekPos, int bytesWrittenFirstBuf, int bytesWrittenSecondBuf, bool *delay) {
 	*delay = false;
+	CancelSpeculation();
 
 	// This was mostly copied straight from the old impl.
 	SceAtracIdInfo &info = context_->info;
@@ -584,6 +589,7 @@ void Atrac2::GetResetBufferInfoInternal(AtracResetBufferInfo *bufferInfo, int se
 }
 
 int Atrac2::SetLoopNum(int loopNum) {
+	CancelSpeculation();
 	SceAtracIdInfo &info = context_->info;
 	if (info.loopEnd <= 0) {
 		// File doesn't contain loop information, looping isn't allowed.
@@ -612,8 +618,7 @@ int Atrac2::LoopStatus() const {
 	}
 }
 
-u32 Atrac2::GetNextSamples() {
-	SceAtracIdInfo &info = context_->info;
+static int ComputeNextSamples(const SceAtracIdInfo &info) {
 	// TODO: Need to reformulate this.
 	const int endOfCurrentFrame = info.decodePos | info.SamplesFrameMask();  // bit trick!
 	const int remainder = std::max(0, endOfCurrentFrame - info.endSample);
@@ -621,6 +626,10 @@ u32 Atrac2::GetNextSamples() {
 	return std::max(0, info.SamplesPerFrame() - adjusted);
 }
 
+u32 Atrac2::GetNextSamples() {
+	return ComputeNextSamples(context_->info);
+}
+
 int Atrac2::GetNextDecodePosition(int *pos) const {
 	const SceAtracIdInfo &info = context_->info;
 	// Check if we reached the end.
@@ -636,6 +645,7 @@ int Atrac2::GetNextDecodePosition(int *pos) const {
 }
 
 int Atrac2::AddStreamData(u32 bytesToAdd) {
+	CancelSpeculation();
 	SceAtracIdInfo &info = context_->info;
 
 	// WARNING: bytesToAdd might not be sampleSize aligned, even though we return a sampleSize-aligned size
@@ -806,21 +816,16 @@ u32 Atrac2::DecodeData(u8 *outbuf, u32 outbufAddr, int *SamplesNum, int *finish,
 	return 0;
 }
 
-u32 Atrac2::DecodeInternal(u32 outbufAddr, int *SamplesNum, int *finish) {
-	SceAtracIdInfo &info = context_->info;
-
-	// Check that there's enough data to decode.
-
+// Checks that the next packet is available, and returns its address.
+// Works on a plain copy of the context, so the speculative decoder can use it too.
+static u32 GetNextPacket(const SceAtracIdInfo &info, u32 *inAddr, int *finish) {
 	// Check for end of file.
-	const int samplesToDecode = GetNextSamples();
 	const int nextFileOff = info.curFileOff + info.sampleSize;
 	if (nextFileOff > info.fileDataEnd || info.decodePos > info.endSample) {
 		*finish = 1;
 		return SCE_ERROR_ATRAC_ALL_DATA_DECODED;
 	}
 
-	DEBUG_LOG(Log::Atrac, "Decode(%08x): samplesToDecode: %d nextFileOff: %d", outbufAddr, samplesToDecode, nextFileOff);
-
 	// Check for streaming buffer run-out.
 	if (AtracStatusIsStreaming(info.state) && info.streamDataByte < info.sampleSize) {
 		*finish = 0;
@@ -833,10 +838,6 @@ u32 Atrac2::DecodeInternal(u32 outbufAddr, int *SamplesNum, int *finish) {
 		return SCE_ERROR_ATRAC_BUFFER_IS_EMPTY;
 	}
 
-	if (info.state == ATRAC_STATUS_FOR_SCESAS) {
-		_dbg_assert_(false);
-	}
-
 	u32 streamOff;
 	u32 bufferPtr;
 	if (!AtracStatusIsStreaming(info.state)) {
@@ -848,57 +849,17 @@ u32 Atrac2::DecodeInternal(u32 outbufAddr, int *SamplesNum, int *finish) {
 		streamOff = bufferIndex == 0 ? info.streamOff : info.secondStreamOff;
 	}
 
-	u32 inAddr = bufferPtr + streamOff;
-	int16_t *outPtr;
-
-	_dbg_assert_(samplesToDecode <= info.SamplesPerFrame());
-	if (samplesToDecode != info.SamplesPerFrame()) {
-		if (!decodeTemp_) {
-			decodeTemp_ = new int16_t[info.SamplesPerFrame() * outputChannels_];
-		}
-		outPtr = decodeTemp_;
-	} else {
-		outPtr = outbufAddr ? (int16_t *)Memory::GetPointer(outbufAddr) : 0;  // outbufAddr can be 0 during skip!
-	}
-
-	context_->codec.inBuf = inAddr;
-	context_->codec.outBuf = outbufAddr;
-
-	if (!Memory::IsValidAddress(inAddr)) {
-		ERROR_LOG(Log::Atrac, "DecodeInternal: Bad inAddr %08x", inAddr);
-		return SCE_ERROR_ATRAC_API_FAIL;
-	}
-
-	int bytesConsumed = 0;
-	int outSamples = 0;
-	if (!decoder_->Decode(Memory::GetPointerUnchecked(inAddr), info.sampleSize, &bytesConsumed, outputChannels_, outPtr, &outSamples)) {
-		// Decode failed.
-		*finish = 0;
-		// TODO: The error code here varies based on what the problem is, but not sure of the right values.
-		// 0000020b and 0000020c have been observed for 0xFF and/or garbage data, there may be more codes.
-		context_->codec.err = 0x20b;
-		return SCE_ERROR_ATRAC_API_FAIL;  // tested.
-	} else {
-		context_->codec.err = 0;
-	}
-
-	_dbg_assert_(bytesConsumed == info.sampleSize);
+	*inAddr = bufferPtr + streamOff;
+	return 0;
+}
 
+// Moves the context past the packet that was just decoded. Returns true if we switched over to streaming
+// from the second buffer, in which case the caller has to copy the partial packet at its end to the main buffer.
+static bool AdvancePastPacket(SceAtracIdInfo &info, int samplesToDecode) {
 	// Advance the file offset.
 	info.curFileOff += info.sampleSize;
 
 	if (info.numSkipFrames == 0) {
-		*SamplesNum = samplesToDecode;
-		if (info.endSample < info.decodePos + samplesToDecode) {
-			*finish = info.loopNum == 0;
-		} else {
-			*finish = 0;
-		}
-		u8 *outBuf = outbufAddr ? Memory::GetPointerWrite(outbufAddr) : nullptr;
-		if (samplesToDecode != info.SamplesPerFrame() && samplesToDecode != 0 && outBuf) {
-			memcpy(outBuf, decodeTemp_, samplesToDecode * outputChannels_ * sizeof(int16_t));
-		}
-
 		// Handle increments and looping.
 		info.decodePos += samplesToDecode;
 		if (info.loopEnd != 0 && info.loopNum != 0 && info.decodePos > info.loopEnd) {
@@ -944,21 +905,276 @@ u32 Atrac2::DecodeInternal(u32 outbufAddr, int *SamplesNum, int *finish) {
 				(info.loopEnd == 0 || (info.loopNum == 0 && info.loopEnd < info.decodePos))) {
 				// If, at that point, our file streaming offset has indeed reached the loop point...
 				if (info.curFileOff >= ComputeLoopEndFileOffset(info, info.loopEnd)) {
-					// Then we switch to streaming from the secondary buffer, and also let's copy the last partial
-					// packet from the second buffer back to the start of the main buffer...
+					// Then we switch to streaming from the secondary buffer.
 					info.curBuffer = 1;
 					info.streamDataByte = info.secondBufferByte;
 					info.secondStreamOff = 0;
-					memcpy(Memory::GetPointerWrite(info.buffer),
-						Memory::GetPointer(info.secondBuffer + (info.secondBufferByte - info.secondBufferByte % info.sampleSize)),
-						info.secondBufferByte % info.sampleSize);
+					return true;
 				}
 			}
 		}
 	}
+	return false;
+}
+
+u32 Atrac2::DecodeInternal(u32 outbufAddr, int *SamplesNum, int *finish) {
+	SceAtracIdInfo &info = context_->info;
+
+	// Check that there's enough data to decode.
+	const int samplesToDecode = GetNextSamples();
+	u32 inAddr;
+	u32 result = GetNextPacket(info, &inAddr, finish);
+	if (result != 0) {
+		return result;
+	}
+
+	DEBUG_LOG(Log::Atrac, "Decode(%08x): samplesToDecode: %d nextFileOff: %d", outbufAddr, samplesToDecode, info.curFileOff + info.sampleSize);
+
+	if (info.state == ATRAC_STATUS_FOR_SCESAS) {
+		_dbg_assert_(false);
+	}
+
+	int16_t *outPtr;
+
+	_dbg_assert_(samplesToDecode <= info.SamplesPerFrame());
+	if (samplesToDecode != info.SamplesPerFrame()) {
+		if (!decodeTemp_) {
+			decodeTemp_ = new int16_t[info.SamplesPerFrame() * outputChannels_];
+		}
+		outPtr = decodeTemp_;
+	} else {
+		outPtr = outbufAddr ? (int16_t *)Memory::GetPointer(outbufAddr) : 0;  // outbufAddr can be 0 during skip!
+	}
+
+	context_->codec.inBuf = inAddr;
+	context_->codec.outBuf = outbufAddr;
+
+	if (!Memory::IsValidAddress(inAddr)) {
+		ERROR_LOG(Log::Atrac, "DecodeInternal: Bad inAddr %08x", inAddr);
+		return SCE_ERROR_ATRAC_API_FAIL;
+	}
+
+	int bytesConsumed = 0;
+	bool success;
+	if (!TakeSpeculatedFrame(inAddr, outPtr, &bytesConsumed, &success)) {
+		const u8 *inPtr = Memory::GetPointerUnchecked(inAddr);
+		int outSamples = 0;
+		success = decoder_->Decode(inPtr, info.sampleSize, &bytesConsumed, outputChannels_, outPtr, &outSamples);
+	}
+
+	if (!success) {
+		// Decode failed.
+		*finish = 0;
+		// TODO: The error code here varies based on what the problem is, but not sure of the right values.
+		// 0000020b and 0000020c have been observed for 0xFF and/or garbage data, there may be more codes.
+		context_->codec.err = 0x20b;
+		return SCE_ERROR_ATRAC_API_FAIL;  // tested.
+	} else {
+		context_->codec.err = 0;
+	}
+
+	_dbg_assert_(bytesConsumed == info.sampleSize);
+
+	if (info.numSkipFrames == 0) {
+		*SamplesNum = samplesToDecode;
+		if (info.endSample < info.decodePos + samplesToDecode) {
+			*finish = info.loopNum == 0;
+		} else {
+			*finish = 0;
+		}
+		u8 *outBuf = outbufAddr ? Memory::GetPointerWrite(outbufAddr) : nullptr;
+		if (samplesToDecode != info.SamplesPerFrame() && samplesToDecode != 0 && outBuf) {
+			memcpy(outBuf, decodeTemp_, samplesToDecode * outputChannels_ * sizeof(int16_t));
+		}
+	}
+
+	if (AdvancePastPacket(info, samplesToDecode)) {
+		// Also copy the last partial packet from the second buffer back to the start of the main buffer.
+		memcpy(Memory::GetPointerWrite(info.buffer),
+			Memory::GetPointer(info.secondBuffer + (info.secondBufferByte - info.secondBufferByte % info.sampleSize)),
+			info.secondBufferByte % info.sampleSize);
+	}
+
+	if (g_Config.bAtracSpeculativeDecode) {
+		StartSpeculation();
+	}
 	return 0;
 }
 
+// Speculative decoding: After a successful decode, a worker thread keeps decoding the packets that a copy of the
+// context says will be requested next. It uses a second decoder that starts out as a copy of the real one, so when
+// the game asks for those packets in order, the output is exactly what decoding them here would have produced and
+// we just copy it. Every packet is compared against the bytes the worker decoded, in case the game rewrote the
+// buffer or moved the play position. On a miss the remaining frames are thrown away, and the real decoder is
+// caught up with the packets the game did take, so it ends up exactly where decoding without speculation would be.
+static std::atomic<u64> g_atracSpecHits;
+static std::atomic<u64> g_atracSpecMisses;
+
+void GetAtracSpeculationStats(u64 *hits, u64 *misses) {
+	*hits = g_atracSpecHits.load();
+	*misses = g_atracSpecMisses.load();
+}
+
+void Atrac2::StartSpeculation() {
+	const SceAtracIdInfo &info = context_->info;
+	if (!AtracStatusIsNormal(info.state) || !g_threadManager.IsInitialized() || !decoder_) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(specLock_);
+		if (specRunning_ || !specFrames_.empty()) {
+			return;
+		}
+	}
+	SyncSpeculatedDecoder();
+
+	const AudioDecoder::PoolKey &key = decoder_->GetPoolKey();
+	if (!key.standalone) {
+		// Can't copy the state of this one.
+		return;
+	}
+	if (specDecoder_ && !(specDecoder_->GetPoolKey() == key)) {
+		ReleaseAudioDecoder(specDecoder_);
+		specDecoder_ = nullptr;
+	}
+	if (!specDecoder_) {
+		specDecoder_ = CreateAtracAudioDecoder(key.audioType, key.channels, key.blockAlign, key.extraDataSize ? key.extraData : nullptr, key.extraDataSize);
+	}
+	if (!specDecoder_->CopyStateFrom(*decoder_)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(specLock_);
+	specRunning_ = true;
+	g_threadManager.EnqueueTask(new IndependentTask(TaskType::CPU_COMPUTE, TaskPriority::HIGH, [this, info]() {
+		SpeculateFrames(info);
+	}));
+}
+
+void Atrac2::SpeculateFrames(SceAtracIdInfo info) {
+	const int frameSamples = info.SamplesPerFrame() * outputChannels_;
+	for (int i = 0; i < ATRAC_SPECULATE_FRAMES && !specCancel_; i++) {
+		u32 inAddr;
+		int finish;
+		if (GetNextPacket(info, &inAddr, &finish) != 0 || !Memory::IsValidRange(inAddr, info.sampleSize)) {
+			break;
+		}
+		const int samplesToDecode = ComputeNextSamples(info);
+
+		// Decode from a copy, so that what we check against later is exactly what we decoded.
+		// Recycled frames keep their buffers, so this doesn't allocate once it's warmed up.
+		AtracSpeculatedFrame frame;
+		{
+			std::lock_guard<std::mutex> guard(specLock_);
+			if (!specFreeFrames_.empty()) {
+				frame = std::move(specFreeFrames_.back());
+				specFreeFrames_.pop_back();
+			}
+		}
+		frame.inAddr = inAddr;
+		const u8 *inPtr = Memory::GetPointerUnchecked(inAddr);
+		frame.packet.assign(inPtr, inPtr + info.sampleSize);
+		frame.samples.resize(frameSamples);
+		int outSamples = 0;
+		frame.success = specDecoder_->Decode(frame.packet.data(), info.sampleSize, &frame.bytesConsumed, outputChannels_, frame.samples.data(), &outSamples);
+
+		// Don't follow into the second buffer, that needs a copy in PSP memory first.
+		const bool stop = !frame.success || AdvancePastPacket(info, samplesToDecode);
+		{
+			std::lock_guard<std::mutex> guard(specLock_);
+			specFrames_.push_back(std::move(frame));
+		}
+		specCond_.notify_all();
+		if (stop) {
+			break;
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(specLock_);
+	specRunning_ = false;
+	specCond_.notify_all();
+}
+
+bool Atrac2::TakeSpeculatedFrame(u32 inAddr, int16_t *outPtr, int *bytesConsumed, bool *success) {
+	std::unique_lock<std::mutex> lock(specLock_);
+	specCond_.wait(lock, [this]() { return !specFrames_.empty() || !specRunning_; });
+	if (specFrames_.empty()) {
+		// Nothing (more) was decoded ahead. Bring decoder_ up to date before it's used.
+		lock.unlock();
+		SyncSpeculatedDecoder();
+		return false;
+	}
+
+	AtracSpeculatedFrame &frame = specFrames_.front();
+	const int inBytes = (int)frame.packet.size();
+	if (frame.inAddr == inAddr && Memory::IsValidRange(inAddr, inBytes) && memcmp(frame.packet.data(), Memory::GetPointerUnchecked(inAddr), inBytes) == 0) {
+		if (outPtr) {
+			memcpy(outPtr, frame.samples.data(), frame.samples.size() * sizeof(int16_t));
+		}
+		*bytesConsumed = frame.bytesConsumed;
+		*success = frame.success;
+		specConsumed_.push_back(std::move(frame));
+		specFrames_.pop_front();
+		g_atracSpecHits++;
+		return true;
+	}
+
+	lock.unlock();
+	g_atracSpecMisses++;
+	CancelSpeculation();
+	return false;
+}
+
+// Stops the worker and throws away what it decoded that the game didn't take. decoder_ is left exactly where
+// it would be without speculation, so this is safe to call whenever the play position or stream changes.
+void Atrac2::CancelSpeculation() {
+	std::unique_lock<std::mutex> lock(specLock_);
+	if (specRunning_) {
+		specCancel_ = true;
+		specCond_.wait(lock, [this]() { return !specRunning_; });
+		specCancel_ = false;
+	}
+	lock.unlock();
+	SyncSpeculatedDecoder();
+}
+
+// Must only be called while the worker isn't running.
+void Atrac2::SyncSpeculatedDecoder() {
+	std::lock_guard<std::mutex> guard(specLock_);
+	_dbg_assert_(!specRunning_);
+	if (!specConsumed_.empty()) {
+		if (specFrames_.empty()) {
+			// The game took everything the worker decoded, so its decoder is exactly where ours should be.
+			std::swap(decoder_, specDecoder_);
+		} else {
+			// Run the taken packets through the real decoder, just for the state. At most ATRAC_SPECULATE_FRAMES.
+			for (const AtracSpeculatedFrame &frame : specConsumed_) {
+				int bytesConsumed = 0;
+				decoder_->Decode(frame.packet.data(), (int)frame.packet.size(), &bytesConsumed, outputChannels_, nullptr, nullptr);
+			}
+		}
+	}
+	for (AtracSpeculatedFrame &frame : specConsumed_) {
+		specFreeFrames_.push_back(std::move(frame));
+	}
+	for (AtracSpeculatedFrame &frame : specFrames_) {
+		specFreeFrames_.push_back(std::move(frame));
+	}
+	specConsumed_.clear();
+	specFrames_.clear();
+}
+
+// For when decoder_ is about to be replaced or freed, so there's no point in catching it up.
+void Atrac2::StopSpeculation() {
+	specConsumed_.clear();
+	CancelSpeculation();
+	if (specDecoder_) {
+		ReleaseAudioDecoder(specDecoder_);
+		specDecoder_ = nullptr;
+	}
+}
+
 int Atrac2::SetData(const Track &track, u32 bufferAddr, u32 readSize, u32 bufferSize, u32 fileSize, int outputChannels, bool isAA3) {
 	_dbg_assert_(outputChannels == 1 || outputChannels == 2);
 	TrackInfo trackInfo{};
@@ -991,6 +1207,7 @@ int Atrac2::SetData(const Track &track, u32 bufferAddr, u32 readSize, u32 buffer
 
 	SceAtracIdInfo &info = context_->info;
 
+	StopSpeculation();
 	CreateDecoder(info.codec, info.sampleSize, info.numChan);
 
 	outputChannels_ = outputChannels;
@@ -1126,6 +1343,7 @@ void Atrac2::InitLowLevel(const Atrac3LowLevelParams &params, int codecType) {
 	info.dataOff = 0;
 	info.decodePos = 0;
 	info.state = ATRAC_STATUS_LOW_LEVEL;
+	StopSpeculation();
 	CreateDecoder(codecType, info.sampleSize, info.numChan);
 }
 
@@ -1150,6 +1368,7 @@ int Atrac2::DecodeLowLevel(const u8 *srcData, int *bytesConsumed, s16 *dstData,
 }
 
 void Atrac2::CheckForSas() {
+	CancelSpeculation();
 	SceAtracIdInfo &info = context_->info;
 	if (info.numChan != 1) {
 		WARN_LOG(Log::Atrac, "Caller forgot to set channels to 1");
@@ -1,9 +1,28 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
 
 #include "Core/HLE/AtracBase.h"
 
+// How many packets the speculative decoder decodes ahead of the game.
+constexpr int ATRAC_SPECULATE_FRAMES = 4;
+
+// A packet decoded ahead of time by the speculative decoder.
+struct AtracSpeculatedFrame {
+	u32 inAddr = 0;
+	bool success = false;
+	int bytesConsumed = 0;
+	std::vector<u8> packet;  // The input bytes, checked against memory when the game gets to it.
+	std::vector<int16_t> samples;
+};
+
+void GetAtracSpeculationStats(u64 *hits, u64 *misses);
+
 class Atrac2 : public AtracBase {
 public:
 	// The default values are only used during save state load, in which case they get restored by DoState.
@@ -64,6 +83,13 @@ class Atrac2 : public AtracBase {
 	u32 ResetPlayPositionInternal(int seekPos, int bytesWrittenFirstBuf, int bytesWrittenSecondBuf);
 
 	u32 SkipFrames(int *skippedCount);
+
+	void StartSpeculation();
+	void SpeculateFrames(SceAtracIdInfo info);
+	bool TakeSpeculatedFrame(u32 inAddr, int16_t *outPtr, int *bytesConsumed, bool *success);
+	void CancelSpeculation();
+	void SyncSpeculatedDecoder();
+	void StopSpeculation();
 	void WrapLastPacket();
 
 	void DumpBufferToFile();
@@ -79,4 +105,16 @@ class Atrac2 : public AtracBase {
 
 	std::vector<u8> dumpBuffer_;  // Used for dumping audio data to files.
 	bool dumped_ = false;  // Whether we already dumped the audio data to a file.
+
+	// Speculative decoding state. The worker decodes with specDecoder_, which starts out as a copy of decoder_,
+	// and owns it while specRunning_ is set. decoder_ is only caught up with the frames the game took
+	// (specConsumed_) when speculation ends, so a miss never affects it.
+	AudioDecoder *specDecoder_ = nullptr;
+	std::mutex specLock_;
+	std::condition_variable specCond_;
+	std::deque<AtracSpeculatedFrame> specFrames_;
+	std::vector<AtracSpeculatedFrame> specConsumed_;  // Taken by the game, but not yet decoded by decoder_.
+	std::vector<AtracSpeculatedFrame> specFreeFrames_;  // Their buffers are reused.
+	bool specRunning_ = false;
+	std::atomic<bool> specCancel_{};
 };
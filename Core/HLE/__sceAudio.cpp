@@ -27,6 +27,7 @@
 #include "Common/System/System.h"
 #include "Common/Math/SIMDHeaders.h"
 #include "Common/StringUtils.h"
+#include "Common/TimeUtil.h"
 
 #include "Core/Config.h"
 #include "Core/CoreTiming.h"
@@ -41,6 +42,7 @@
 #include "Core/HLE/sceAudio.h"
 #include "Core/HLE/sceKernel.h"
 #include "Core/HLE/sceKernelThread.h"
+#include "Core/HW/SimpleAudioDec.h"
 #include "Core/Util/AudioFormat.h"
 
 // Should be used to lock anything related to the outAudioQueue.
@@ -59,6 +61,9 @@ int eventHostAudioUpdate = -1;
 int mixFrequency = 44100;
 int srcFrequency = 0;
 
+static std::atomic<bool> collectTimings;
+static std::atomic<uint64_t> timingNanos[(int)AudioTimingCategory::COUNT];
+
 const int hwSampleRate = 44100;
 const int hwBlockSize = 64;
 
@@ -182,6 +187,9 @@ void __AudioShutdown() {
 		g_audioChans[i].clear();
 	}
 
+	// The codec modules shut down before us, so everything they released is in the pool by now.
+	ClearAudioDecoderPool();
+
 #ifndef MOBILE_DEVICE
 	if (g_Config.bDumpAudio) {
 		__StopLogAudio();
@@ -333,6 +341,7 @@ void __AudioUpdate(bool resetRecording) {
 	// AUDIO throttle doesn't really work on the PSP since the mixing intervals are so closely tied
 	// to the CPU. Much better to throttle the frame rate on frame display and just throw away audio
 	// if the buffer somehow gets full.
+	const double mixStart = __AudioTimingStart();
 	bool firstChannel = true;
 	const int16_t srcBufferSize = hwBlockSize * 2;
 	int16_t srcBuffer[srcBufferSize];
@@ -400,23 +409,16 @@ void __AudioUpdate(bool resetRecording) {
 			sz2 = 0;
 		}
 
+		// Volume has already been applied when the samples were queued.
 		if (firstChannel) {
-			for (size_t s = 0; s < sz1; s++)
-				mixBuffer[s] = buf1[s];
-			if (buf2) {
-				for (size_t s = 0; s < sz2; s++)
-					mixBuffer[s + sz1] = buf2[s];
-			}
+			ConvertS16ToS32(mixBuffer, buf1, sz1);
+			if (buf2)
+				ConvertS16ToS32(mixBuffer + sz1, buf2, sz2);
 			firstChannel = false;
 		} else {
-			// Surprisingly hard to SIMD efficiently on SSE2 due to lack of 16-to-32-bit sign extension. NEON should be straight-forward though, and SSE4.1 can do it nicely.
-			// Actually, the cmple/pack trick should work fine...
-			for (size_t s = 0; s < sz1; s++)
-				mixBuffer[s] += buf1[s];
-			if (buf2) {
-				for (size_t s = 0; s < sz2; s++)
-					mixBuffer[s + sz1] += buf2[s];
-			}
+			AccumulateS16ToS32(mixBuffer, buf1, sz1);
+			if (buf2)
+				AccumulateS16ToS32(mixBuffer + sz1, buf2, sz2);
 		}
 	}
 
@@ -424,6 +426,7 @@ void __AudioUpdate(bool resetRecording) {
 		// Nothing was written above, let's memset.
 		memset(mixBuffer, 0, hwBlockSize * 2 * sizeof(s32));
 	}
+	__AudioTimingEnd(AudioTimingCategory::MIXER, mixStart);
 
 	if (g_Config.bEnableSound) {
 		float multiplier = Volume100ToMultiplier(std::clamp(g_Config.iGameVolume, 0, VOLUMEHI_FULL));
@@ -461,9 +464,7 @@ void __AudioUpdate(bool resetRecording) {
 			}
 		} else {
 			if (g_Config.bDumpAudio) {
-				for (int i = 0; i < hwBlockSize * 2; i++) {
-					clampedMixBuffer[i] = clamp_s16(mixBuffer[i]);
-				}
+				ClampBufferToS16WithVolume(clampedMixBuffer, mixBuffer, hwBlockSize * 2, 4096);
 				g_wave_writer.AddStereoSamples(clampedMixBuffer, hwBlockSize);
 			} else {
 				__StopLogAudio();
@@ -496,6 +497,29 @@ void __StopLogAudio() {
 }
 #endif
 
+void __AudioSetCollectTimings(bool enable) {
+	collectTimings = enable;
+}
+
+void __AudioResetTimings() {
+	for (auto &nanos : timingNanos)
+		nanos = 0;
+}
+
+double __AudioGetTimingSeconds(AudioTimingCategory category) {
+	return timingNanos[(int)category].load() * 1e-9;
+}
+
+double __AudioTimingStart() {
+	return collectTimings.load(std::memory_order_relaxed) ? time_now_d() : 0.0;
+}
+
+void __AudioTimingEnd(AudioTimingCategory category, double start) {
+	if (start == 0.0)
+		return;
+	timingNanos[(int)category].fetch_add((uint64_t)((time_now_d() - start) * 1e9), std::memory_order_relaxed);
+}
+
 void WAVDump::Reset() {
 	__AudioUpdate(true);
 }
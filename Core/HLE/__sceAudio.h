@@ -50,6 +50,35 @@ void __AudioWakeThreads(AudioChannel &chan, int result);
 void __StartLogAudio(const Path &filename);
 void __StopLogAudio();
 
+// Host CPU time spent in the audio subsystems, for benchmarking. Only collected while enabled,
+// and safe to update from the SAS thread.
+enum class AudioTimingCategory {
+	SAS,
+	ATRAC,
+	MP3,
+	MIXER,
+	COUNT,
+};
+
+void __AudioSetCollectTimings(bool enable);
+void __AudioResetTimings();
+double __AudioGetTimingSeconds(AudioTimingCategory category);
+// Returns 0.0 when not collecting, which __AudioTimingEnd ignores.
+double __AudioTimingStart();
+void __AudioTimingEnd(AudioTimingCategory category, double start);
+
+class AudioTimingScope {
+public:
+	explicit AudioTimingScope(AudioTimingCategory category) : category_(category), start_(__AudioTimingStart()) {}
+	~AudioTimingScope() {
+		__AudioTimingEnd(category_, start_);
+	}
+
+private:
+	AudioTimingCategory category_;
+	double start_;
+};
+
 class WAVDump {
 public:
 	static void Reset();
@@ -36,6 +36,7 @@
 #include "Core/HLE/sceAtrac.h"
 #include "Core/HLE/AtracCtx.h"
 #include "Core/HLE/AtracCtx2.h"
+#include "Core/HLE/__sceAudio.h"
 #include "Core/System.h"
 
 // Notes about sceAtrac buffer management
@@ -315,6 +316,7 @@ static u32 sceAtracAddStreamData(int atracID, u32 bytesToAdd) {
 
 // Note that outAddr being null is completely valid here, used to skip data.
 static u32 sceAtracDecodeData(int atracID, u32 outAddr, u32 numSamplesAddr, u32 finishFlagAddr, u32 remainAddr) {
+	AudioTimingScope timing(AudioTimingCategory::ATRAC);
 	AtracBase *atrac = getAtrac(atracID);
 	u32 err = AtracValidateData(atrac);
 	if (err != 0) {
@@ -21,6 +21,7 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/FunctionWrappers.h"
 #include "Core/HLE/sceAudiocodec.h"
+#include "Core/HLE/__sceAudio.h"
 #include "Core/HLE/ErrorCodes.h"
 #include "Core/MemMap.h"
 #include "Core/Reporting.h"
@@ -106,7 +107,7 @@ static AudioDecoder *findDecoder(u32 ctxPtr) {
 static bool removeDecoder(u32 ctxPtr) {
 	auto it = g_audioDecoderContexts.find(ctxPtr);
 	if (it != g_audioDecoderContexts.end()) {
-		delete it->second;
+		ReleaseAudioDecoder(it->second);
 		g_audioDecoderContexts.erase(it);
 		return true;
 	}
@@ -115,7 +116,7 @@ static bool removeDecoder(u32 ctxPtr) {
 
 static void clearDecoders() {
 	for (const auto &[_, decoder] : g_audioDecoderContexts) {
-		delete decoder;
+		ReleaseAudioDecoder(decoder);
 	}
 	g_audioDecoderContexts.clear();
 }
@@ -258,7 +259,13 @@ static int sceAudiocodecDecode(u32 ctxPtr, int codec) {
 
 		int16_t *outBuf = (int16_t *)Memory::GetPointerWrite(ctx->outBuf);
 
+		const double decodeStart = __AudioTimingStart();
 		bool result = decoder->Decode(Memory::GetPointer(ctx->inBuf), bytesPerFrame, &inDataConsumed, 2, outBuf, &outSamples);
+		// AAC isn't broken out in the timings.
+		if (codec == PSP_CODEC_MP3)
+			__AudioTimingEnd(AudioTimingCategory::MP3, decodeStart);
+		else if (codec == PSP_CODEC_AT3 || codec == PSP_CODEC_AT3PLUS)
+			__AudioTimingEnd(AudioTimingCategory::ATRAC, decodeStart);
 		if (!result) {
 			ctx->err = 0x20b;
 			ERROR_LOG(Log::ME, "AudioCodec decode failed. Setting error to %08x", ctx->err);
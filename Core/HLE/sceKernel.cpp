@@ -33,6 +33,7 @@
 
 #include "Core/FileSystems/FileSystem.h"
 #include "Core/FileSystems/MetaFileSystem.h"
+#include "Core/HW/SasAudio.h"
 #include "Core/PSPLoaders.h"
 #include "Core/CoreTiming.h"
 #include "Core/Reporting.h"
@@ -436,6 +437,7 @@ int sceKernelDcacheWritebackRange(u32 addr, int size)
 
 	if (size > 0 && addr != 0) {
 		gpu->InvalidateCache(addr, size, GPU_INVALIDATE_HINT);
+		SasVagCacheInvalidate(addr, size);
 	}
 	hleEatCycles(165);
 	return hleNoLog(0);
@@ -451,6 +453,7 @@ int sceKernelDcacheWritebackInvalidateRange(u32 addr, int size)
 
 	if (size > 0 && addr != 0) {
 		gpu->InvalidateCache(addr, size, GPU_INVALIDATE_HINT);
+		SasVagCacheInvalidate(addr, size);
 	}
 	hleEatCycles(165);
 	return hleNoLog(0);
@@ -76,6 +76,7 @@
 #include "Core/HLE/FunctionWrappers.h"
 #include "Core/HLE/sceKernelMemory.h"
 #include "Core/HLE/sceMp3.h"
+#include "Core/HLE/__sceAudio.h"
 #include "Core/HW/SimpleAudioDec.h"
 #include "Core/MemMap.h"
 #include "Core/Reporting.h"
@@ -203,6 +204,7 @@ void __Mp3DoState(PointerWrap &p) {
 }
 
 static int sceMp3Decode(u32 mp3, u32 outPcmPtr) {
+	AudioTimingScope timing(AudioTimingCategory::MP3);
 	AuCtx *ctx = getMp3Ctx(mp3);
 	if (!ctx) {
 		if (mp3 >= MP3_MAX_HANDLES)
@@ -49,6 +49,7 @@
 #include "Core/HLE/sceSas.h"
 #include "Core/HLE/sceKernel.h"
 #include "Core/HLE/sceKernelThread.h"
+#include "Core/HLE/__sceAudio.h"
 
 // TODO - allow more than one, associating each with one Core pointer (passed in to all the functions)
 // No known games use more than one instance of Sas though.
@@ -93,7 +94,10 @@ int __SasThread() {
 		sasWake.wait(guard);
 		if (sasThreadState == SasThreadState::QUEUED) {
 			const bool mute = g_sasMuteFlag;
-			sas->Mix(sasThreadParams.outAddr, sasThreadParams.inAddr, sasThreadParams.leftVol, sasThreadParams.rightVol, mute);
+			{
+				AudioTimingScope timing(AudioTimingCategory::SAS);
+				sas->Mix(sasThreadParams.outAddr, sasThreadParams.inAddr, sasThreadParams.leftVol, sasThreadParams.rightVol, mute);
+			}
 			std::lock_guard<std::mutex> doneGuard(sasDoneMutex);
 			sasThreadState = SasThreadState::READY;
 			sasDone.notify_one();
@@ -112,6 +116,7 @@ static void __SasEnqueueMix(u32 outAddr, u32 inAddr = 0, int leftVol = 0, int ri
 	if (sasThreadState == SasThreadState::DISABLED) {
 		// No thread, call it immediately.
 		const bool mute = g_sasMuteFlag;
+		AudioTimingScope timing(AudioTimingCategory::SAS);
 		sas->Mix(outAddr, inAddr, leftVol, rightVol, mute);
 		return;
 	}
@@ -208,6 +213,7 @@ void __SasShutdown() {
 
 	delete sas;
 	sas = 0;
+	SasVagCacheClear();
 }
 
 static u32 sceSasInit(u32 core, u32 grainSize, u32 maxVoices, u32 outputMode, u32 sampleRate) {
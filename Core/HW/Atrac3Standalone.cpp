@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "SimpleAudioDec.h"
 #include "Common/LogReporting.h"
 #include "ext/at3_standalone/at3_decoders.h"
@@ -16,8 +18,9 @@ inline int16_t clamp16(float f) {
 class Atrac3Audio : public AudioDecoder {
 public:
 	Atrac3Audio(PSPAudioType audioType, int channels, size_t blockAlign, const uint8_t *extraData, size_t extraDataSize)
-		: audioType_(audioType), channels_(channels) {
+		: audioType_(audioType), channels_(channels), initialChannels_(channels) {
 		blockAlign_ = (int)blockAlign;
+		initialBlockAlign_ = blockAlign_;
 		if (audioType_ == PSP_CODEC_AT3) {
 			at3Ctx_ = atrac3_alloc(channels, &blockAlign_, extraData, (int)extraDataSize);
 			if (at3Ctx_) {
@@ -27,8 +30,9 @@ class Atrac3Audio : public AudioDecoder {
 				codecFailed_ = true;
 			}
 		}
+		// Zeroed, since a frame that codes no channel units leaves them untouched and we output them as is.
 		for (int i = 0; i < 2; i++) {
-			buffers_[i] = new float[4096];
+			buffers_[i] = new float[4096]{};
 		}
 	}
 	~Atrac3Audio() override {
@@ -56,6 +60,65 @@ class Atrac3Audio : public AudioDecoder {
 		}
 	}
 
+	bool Reset() override {
+		if (codecFailed_) {
+			return false;
+		}
+		if (at3pCtx_) {
+			// A late SetChannels changed the channel layout the context was opened with.
+			if (channels_ != initialChannels_) {
+				return false;
+			}
+			atrac3p_reset(at3pCtx_);
+		}
+		if (at3Ctx_) {
+			atrac3_reset(at3Ctx_);
+		}
+		for (int i = 0; i < 2; i++) {
+			memset(buffers_[i], 0, 4096 * sizeof(float));
+		}
+		channels_ = initialChannels_;
+		blockAlign_ = initialBlockAlign_;
+		return true;
+	}
+
+	bool CopyStateFrom(const AudioDecoder &other) override {
+		if (!GetPoolKey().standalone || !(other.GetPoolKey() == GetPoolKey())) {
+			return false;
+		}
+		// Same key and standalone, so it's one of us.
+		const Atrac3Audio &src = static_cast<const Atrac3Audio &>(other);
+		if (codecFailed_ || !src.codecOpen_) {
+			return false;
+		}
+		if (src.at3pCtx_ && (!at3pCtx_ || channels_ != src.channels_)) {
+			// Atrac3+ contexts are opened on the first decode, with the channel count at that point.
+			if (at3pCtx_) {
+				atrac3p_free(at3pCtx_);
+			}
+			int blockAlign = src.initialBlockAlign_;
+			at3pCtx_ = atrac3p_alloc(src.channels_, &blockAlign);
+			if (!at3pCtx_) {
+				codecOpen_ = false;
+				return false;
+			}
+		}
+		if (src.at3pCtx_ && atrac3p_copy_state(at3pCtx_, src.at3pCtx_) < 0) {
+			return false;
+		}
+		if (src.at3Ctx_ && (!at3Ctx_ || atrac3_copy_state(at3Ctx_, src.at3Ctx_) < 0)) {
+			return false;
+		}
+		// Frames that code no channel units output these as they are, so they're part of the state.
+		for (int i = 0; i < 2; i++) {
+			memcpy(buffers_[i], src.buffers_[i], 4096 * sizeof(float));
+		}
+		channels_ = src.channels_;
+		blockAlign_ = src.blockAlign_;
+		codecOpen_ = src.codecOpen_;
+		return true;
+	}
+
 	bool Decode(const uint8_t *inbuf, int inbytes, int *inbytesConsumed, int outputChannels, int16_t *outbuf, int *outSamples) override {
 		if (outSamples)
 			*outSamples = 0;
@@ -165,6 +228,9 @@ class Atrac3Audio : public AudioDecoder {
 
 	int channels_ = 0;
 	int blockAlign_ = 0;
+	// What we were created with, restored by Reset.
+	int initialChannels_ = 0;
+	int initialBlockAlign_ = 0;
 
 	float *buffers_[2]{};
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+
+// Underrun/overrun counters and a histogram of the queued latency, as seen by the consumer.
+// Updated from the two audio threads, and read from the UI, so everything is atomic.
+struct AudioRingStats {
+	static constexpr int HISTOGRAM_BUCKETS = 12;
+	static constexpr int BUCKET_MS = 10;  // The last bucket also counts everything above it.
+
+	void RecordUnderrun() { underruns.fetch_add(1, std::memory_order_relaxed); }
+	void RecordOverrun() { overruns.fetch_add(1, std::memory_order_relaxed); }
+	void RecordLatency(float ms) {
+		int bucket = ms <= 0.0f ? 0 : (int)(ms / BUCKET_MS);
+		if (bucket >= HISTOGRAM_BUCKETS)
+			bucket = HISTOGRAM_BUCKETS - 1;
+		histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Reset() {
+		underruns = 0;
+		overruns = 0;
+		for (auto &count : histogram)
+			count = 0;
+	}
+
+	// Appends a text version of the histogram, one line per non-empty bucket, as percentages.
+	void FormatHistogram(char *buf, size_t bufSize) const {
+		size_t len = strlen(buf);
+		u32 total = 0;
+		for (const auto &count : histogram)
+			total += count.load(std::memory_order_relaxed);
+		if (total == 0 || len >= bufSize)
+			return;
+		len += snprintf(buf + len, bufSize - len, "Latency histogram:\n");
+		for (int i = 0; i < HISTOGRAM_BUCKETS && len < bufSize; i++) {
+			u32 count = histogram[i].load(std::memory_order_relaxed);
+			if (count == 0)
+				continue;
+			const char *more = i == HISTOGRAM_BUCKETS - 1 ? "+" : "";
+			len += snprintf(buf + len, bufSize - len, "  %3d-%d%s ms: %0.1f%%\n", i * BUCKET_MS, (i + 1) * BUCKET_MS, more, 100.0 * count / total);
+		}
+	}
+
+	std::atomic<u32> underruns{};
+	std::atomic<u32> overruns{};
+	std::atomic<u32> histogram[HISTOGRAM_BUCKETS]{};
+};
+
+// Ring buffer for handing audio from the emulator thread (the only producer) to the host audio
+// callback (the only consumer), without locks. The indices grow freely and are masked on use, so
+// head - tail is always the fill level. Only the producer stores the head, and only the consumer
+// stores the tail, with release/acquire ordering around the data in between.
+//
+// The consumer may move the tail backwards (to replay data it has already read) as long as it
+// stays within the capacity behind the head.
+template <class T>
+class AudioRing {
+public:
+	// Capacity must be a power of two.
+	explicit AudioRing(u32 capacity) : capacity_(capacity), mask_(capacity - 1) {
+		items_ = new T[capacity]();
+	}
+	~AudioRing() {
+		delete[] items_;
+	}
+
+	AudioRing(const AudioRing &) = delete;
+	AudioRing &operator=(const AudioRing &) = delete;
+
+	u32 Capacity() const { return capacity_; }
+
+	T &At(u32 index) { return items_[index & mask_]; }
+	const T &At(u32 index) const { return items_[index & mask_]; }
+	// How many items can be accessed linearly from &At(index) before wrapping.
+	u32 ContiguousFrom(u32 index) const { return capacity_ - (index & mask_); }
+
+	u32 Head() const { return head_.load(std::memory_order_acquire); }
+	u32 Tail() const { return tail_.load(std::memory_order_acquire); }
+	u32 Size() const { return Head() - Tail(); }
+
+	// Producer only. Makes everything written up to the new head visible to the consumer.
+	void PublishHead(u32 head) { head_.store(head, std::memory_order_release); }
+	// Consumer only. Hands everything before the new tail back to the producer.
+	void PublishTail(u32 tail) { tail_.store(tail, std::memory_order_release); }
+
+	// Zeroes the contents, without moving the indices.
+	void Clear() {
+		for (u32 i = 0; i < capacity_; i++)
+			items_[i] = T();
+	}
+
+	AudioRingStats stats;
+
+private:
+	T *items_ = nullptr;
+	const u32 capacity_;
+	const u32 mask_;
+	// Keep the two indices on separate cache lines, they're written by different threads.
+	alignas(64) std::atomic<u32> head_{};
+	alignas(64) std::atomic<u32> tail_{};
+};
@@ -110,7 +110,11 @@ void GranularMixer::Mix(s16 *samples, u32 num_samples, int outSampleRate, float
 	// However, in case of faster framerates, we should apply some pressure to reduce this. And if real clock sync
 	// is on, we should also be able to get away with a shorter buffer here.
 	// const u32 buffer_size_ms = frameTimeEstimate_ * 44100.0f;
-	const u32 buffer_size_samples = smoothedReadSize_ * 4 + std::llround(frameTimeEstimate_ * inSampleRate);
+	u32 buffer_size_samples = smoothedReadSize_ * 4 + std::llround(frameTimeEstimate_ * inSampleRate);
+	if (g_Config.iAudioLatencyMs > 0) {
+		// Explicit latency target, overrides the estimate.
+		buffer_size_samples = (u32)std::llround(g_Config.iAudioLatencyMs * inSampleRate / 1000.0);
+	}
 	queuedSamplesTarget_ = buffer_size_samples;
 
 	// Limit the possible queue sizes to any number between 4 and 64.
@@ -124,7 +128,8 @@ void GranularMixer::Mix(s16 *samples, u32 num_samples, int outSampleRate, float
 
 	m_granule_queue_size.store(buffer_size_granules, std::memory_order_relaxed);
 
-	int actualQueueSize = m_queue_head - m_queue_tail;
+	int actualQueueSize = m_queue.Size();
+	m_queue.stats.RecordLatency(actualQueueSize * GRANULE_OVERLAP * 1000.0f / 44100.0f);
 	if (smoothedQueueSize_ == 0) {
 		smoothedQueueSize_ = actualQueueSize;
 	} else {
@@ -221,11 +226,11 @@ void GranularMixer::PushSamples(const s32 *samples, u32 num_samples, float volum
 }
 
 void GranularMixer::Enqueue() {
-	const u32 head = m_queue_head.load(std::memory_order_acquire);
+	const u32 head = m_queue.Head();
 
 	// Check if we run out of space in the circular queue. (rare)
 	u32 next_head = head + 1;
-	if ((next_head & GRANULE_QUEUE_MASK) == (m_queue_tail.load(std::memory_order_acquire) & GRANULE_QUEUE_MASK)) {
+	if (next_head - m_queue.Tail() >= m_queue.Capacity()) {
 		WARN_LOG(Log::Audio,
 			"Granule Queue has completely filled and audio samples are being dropped. "
 			"This should not happen unless the audio backend has stopped requesting audio.");
@@ -235,26 +240,26 @@ void GranularMixer::Enqueue() {
 	// The compiler (at least MSVC) fails at optimizing this loop using SIMD instructions.
 	const u32 start_index = m_next_buffer_index;
 
-	const u32 maskedHead = head & GRANULE_QUEUE_MASK;
+	Granule &dest = m_queue.At(head);
 	for (u32 i = 0; i < GRANULE_SIZE; ++i) {
-		m_queue[maskedHead][i] = m_next_buffer[(i + start_index) & GRANULE_MASK] * g_GranuleWindow[i];
+		dest[i] = m_next_buffer[(i + start_index) & GRANULE_MASK] * g_GranuleWindow[i];
 	}
 
-	m_queue_head.store(next_head, std::memory_order_release);
+	m_queue.PublishHead(next_head);
 	m_queue_looping.store(false, std::memory_order_relaxed);
 }
 
 void GranularMixer::Dequeue(Granule *granule) {
 	const u32 granule_queue_size = m_granule_queue_size.load(std::memory_order_relaxed);
-	const u32 head = m_queue_head.load(std::memory_order_acquire);
-	u32 tail = m_queue_tail.load(std::memory_order_acquire);
+	const u32 head = m_queue.Head();
+	u32 tail = m_queue.Tail();
 
 	// Checks to see if the queue has gotten too long.
 	if ((head - tail) > granule_queue_size) {
 		// Jump the playhead to half the queue size behind the head.
 		const u32 gap = (granule_queue_size >> 1) + 1;
 		tail = (head - gap);
-		overruns_++;
+		m_queue.stats.RecordOverrun();
 	}
 
 	// Checks to see if the queue is empty.
@@ -275,7 +280,7 @@ void GranularMixer::Dequeue(Granule *granule) {
 			// This provides smoother audio playback than suddenly stopping.
 			const u32 gap = std::max<u32>(2, granule_queue_size >> 1) - 1;
 			next_tail = head - gap;
-			underruns_++;
+			m_queue.stats.RecordUnderrun();
 			m_queue_looping.store(true, std::memory_order_relaxed);
 		} else {
 			// Send a zero granule.
@@ -285,8 +290,8 @@ void GranularMixer::Dequeue(Granule *granule) {
 		}
 	}
 
-	*granule = m_queue[tail & GRANULE_QUEUE_MASK];
-	m_queue_tail.store(next_tail, std::memory_order_release);
+	*granule = m_queue.At(tail);
+	m_queue.PublishTail(next_tail);
 }
 
 void GranularMixer::GetStats(GranularStats *stats) {
@@ -297,11 +302,30 @@ void GranularMixer::GetStats(GranularStats *stats) {
 	stats->maxQueuedGranules = MAX_GRANULE_QUEUE_SIZE;
 	stats->fadeVolume = m_fade_volume;
 	stats->looping = m_queue_looping;
-	stats->overruns = overruns_;
-	stats->underruns = underruns_;
+	stats->overruns = m_queue.stats.overruns;
+	stats->underruns = m_queue.stats.underruns;
 	stats->smoothedReadSize = smoothedReadSize_;
 	stats->frameTimeEstimate = frameTimeEstimate_;
 	stats->queuedSamplesTarget = queuedSamplesTarget_;
 	queuedGranulesMin_ = 10000;
 	queuedGranulesMax_ = 0;
 }
+
+void GranularMixer::GetAudioDebugStats(char *buf, size_t bufSize) {
+	snprintf(buf, bufSize,
+		"Queued granules: %d (target %d, max %d)\n"
+		"Smoothed queue: %0.1f granules\n"
+		"Underruns: %u\n"
+		"Overruns: %u\n",
+		(int)m_queue.Size(),
+		(int)m_granule_queue_size.load(std::memory_order_relaxed),
+		(int)MAX_GRANULE_QUEUE_SIZE,
+		smoothedQueueSize_,
+		m_queue.stats.underruns.load(),
+		m_queue.stats.overruns.load());
+	m_queue.stats.FormatHistogram(buf, bufSize);
+}
+
+void GranularMixer::ResetStatCounters() {
+	m_queue.stats.Reset();
+}
@@ -10,6 +10,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Core/Config.h"
+#include "Core/HW/AudioRing.h"
 
 class PointerWrap;
 
@@ -49,12 +50,13 @@ class GranularMixer final {
 	void PushSamples(const s32 *samples, u32 num_samples, float volume);
 
 	void GetStats(GranularStats *stats);
+	void GetAudioDebugStats(char *buf, size_t bufSize);
+	void ResetStatCounters();
 
 	static constexpr u32 GRANULE_SIZE = 256;
 
 private:
 	static constexpr std::size_t MAX_GRANULE_QUEUE_SIZE = 128;
-	static constexpr std::size_t GRANULE_QUEUE_MASK = MAX_GRANULE_QUEUE_SIZE - 1;
 
 	struct StereoPair final {
 		float l = 0.f;
@@ -95,16 +97,10 @@ class GranularMixer final {
 
 	std::atomic<u32> m_granule_queue_size{ 20 };
 	float smoothedQueueSize_ = 0.0f;
-	Granule m_queue[MAX_GRANULE_QUEUE_SIZE];
-
-	// These are permitted to grow indefinitely and masked on use.
-	std::atomic<u32> m_queue_head{};
-	std::atomic<u32> m_queue_tail{};
+	AudioRing<Granule> m_queue{ MAX_GRANULE_QUEUE_SIZE };
 	std::atomic<bool> m_queue_looping{};
 
 	float m_fade_volume = 1.0;
-	int underruns_ = 0;
-	int overruns_ = 0;
 	int queuedGranulesMin_ = 10000;
 	int queuedGranulesMax_ = 0;
 	int queuedSamplesTarget_ = 0;
@@ -16,6 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include "Common/Serialize/SerializeFuncs.h"
+#include "Common/Data/Convert/ColorConv.h"
 #include "Common/Math/SIMDHeaders.h"
 #include "Common/StringUtils.h"
 #include "Core/System.h"
@@ -357,6 +358,8 @@ void MediaEngine::closeContext() {
 		av_frame_free(&m_pFrameRGB);
 	if (m_pFrame)
 		av_frame_free(&m_pFrame);
+	if (m_pFrameDecode)
+		av_frame_free(&m_pFrameDecode);
 	if (m_pIOContext && m_pIOContext->buffer)
 		av_free(m_pIOContext->buffer);
 	if (m_pIOContext)
@@ -383,6 +386,7 @@ void MediaEngine::closeContext() {
 	sws_freeContext(m_sws_ctx);
 	m_sws_ctx = nullptr;
 	m_pIOContext = nullptr;
+	m_pendingYUVFor = nullptr;
 #endif
 	m_buffer = nullptr;
 }
@@ -593,6 +597,9 @@ bool MediaEngine::setVideoDim(int width, int height)
 	if (!m_pFrame) {
 		m_pFrame = av_frame_alloc();
 	}
+	if (!m_pFrameDecode) {
+		m_pFrameDecode = av_frame_alloc();
+	}
 
 	sws_freeContext(m_sws_ctx);
 	m_sws_ctx = nullptr;
@@ -670,9 +677,13 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 		return false;
 	if (!m_pCodecCtx)
 		return false;
-	if (!m_pFrame)
+	if (!m_pFrame || !m_pFrameDecode)
 		return false;
 
+	// Decode into a separate frame, so that m_pFrame keeps the current picture when there's no new
+	// one (at the end of the video), or when it's skipped.
+	AVFrame *frame = m_pFrameDecode;
+
 	AVPacket packet;
 	av_init_packet(&packet);
 	int frameFinished;
@@ -694,7 +705,7 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 48, 101)
 			if (packet.size != 0)
 				avcodec_send_packet(m_pCodecCtx, &packet);
-			int result = avcodec_receive_frame(m_pCodecCtx, m_pFrame);
+			int result = avcodec_receive_frame(m_pCodecCtx, frame);
 			if (result == 0) {
 				result = 1;
 				frameFinished = 1;
@@ -705,31 +716,39 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 				frameFinished = 0;
 			}
 #else
-			int result = avcodec_decode_video2(m_pCodecCtx, m_pFrame, &frameFinished, &packet);
+			int result = avcodec_decode_video2(m_pCodecCtx, frame, &frameFinished, &packet);
 #endif
 			if (frameFinished) {
 				if (!m_pFrameRGB) {
 					setVideoDim();
 				}
 				if (m_pFrameRGB && !skipFrame) {
-					updateSwsFormat(videoPixelMode);
-					// TODO: Technically we could set this to frameWidth instead of m_desWidth for better perf.
-					// Update the linesize for the new format too.  We started with the largest size, so it should fit.
-					m_pFrameRGB->linesize[0] = getPixelFormatBytes(videoPixelMode) * m_desWidth;
-
-					sws_scale(m_sws_ctx, m_pFrame->data, m_pFrame->linesize, 0,
-						m_pCodecCtx->height, m_pFrameRGB->data, m_pFrameRGB->linesize);
+					std::swap(m_pFrame, m_pFrameDecode);
+					if (m_pFrame->format == AV_PIX_FMT_YUV420P && m_pFrame->width == m_desWidth && m_pFrame->height == m_desHeight) {
+						// No scaling needed, so leave it as YUV and convert it when it's written out.
+						m_pendingYUVFor = m_pFrameRGB;
+						m_pendingPixelMode = videoPixelMode;
+					} else {
+						m_pendingYUVFor = nullptr;
+						updateSwsFormat(videoPixelMode);
+						// TODO: Technically we could set this to frameWidth instead of m_desWidth for better perf.
+						// Update the linesize for the new format too.  We started with the largest size, so it should fit.
+						m_pFrameRGB->linesize[0] = getPixelFormatBytes(videoPixelMode) * m_desWidth;
+
+						sws_scale(m_sws_ctx, m_pFrame->data, m_pFrame->linesize, 0,
+							m_pCodecCtx->height, m_pFrameRGB->data, m_pFrameRGB->linesize);
+					}
 				}
 
 #if LIBAVUTIL_VERSION_MAJOR >= 59
-				int64_t bestPts = m_pFrame->best_effort_timestamp;
-				int64_t ptsDuration = m_pFrame->duration;
+				int64_t bestPts = frame->best_effort_timestamp;
+				int64_t ptsDuration = frame->duration;
 #elif LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(55, 58, 100)
-				int64_t bestPts = m_pFrame->best_effort_timestamp;
-				int64_t ptsDuration = m_pFrame->pkt_duration;
+				int64_t bestPts = frame->best_effort_timestamp;
+				int64_t ptsDuration = frame->pkt_duration;
 #else
-				int64_t bestPts = av_frame_get_best_effort_timestamp(m_pFrame);
-				int64_t ptsDuration = av_frame_get_pkt_duration(m_pFrame);
+				int64_t bestPts = av_frame_get_best_effort_timestamp(frame);
+				int64_t ptsDuration = av_frame_get_pkt_duration(frame);
 #endif
 				if (ptsDuration == 0) {
 					if (m_lastPts == bestPts - m_firstTimeStamp || bestPts == AV_NOPTS_VALUE) {
@@ -836,6 +855,52 @@ inline void writeVideoLineABGR4444(void *destp, const void *srcp, int width) {
 	}
 }
 
+// Converts the pending YUV picture in m_pFrame, with alpha zeroed like the helpers above.
+// Games keep writing out the last picture after the video has ended (see scePsmf), which works
+// because stepVideo never decodes into m_pFrame, so a pending picture stays valid until replaced.
+void MediaEngine::writeVideoYUV(u8 *dest, int lineSize, int videoPixelMode, int width, int height) {
+#ifdef USE_FFMPEG
+	if (!m_pFrame->data[0]) {
+		_dbg_assert_msg_(false, "Pending YUV picture without data");
+		return;
+	}
+	for (int y = 0; y < height; y++) {
+		const u8 *srcY = m_pFrame->data[0] + y * m_pFrame->linesize[0];
+		const u8 *srcU = m_pFrame->data[1] + (y / 2) * m_pFrame->linesize[1];
+		const u8 *srcV = m_pFrame->data[2] + (y / 2) * m_pFrame->linesize[2];
+		u8 *line = dest + lineSize * y;
+		switch (videoPixelMode) {
+		case GE_CMODE_32BIT_ABGR8888:
+			ConvertYUV420ToRGBA8888((u32 *)line, srcY, srcU, srcV, width);
+			break;
+		case GE_CMODE_16BIT_BGR5650:
+			ConvertYUV420ToRGB565((u16 *)line, srcY, srcU, srcV, width);
+			break;
+		case GE_CMODE_16BIT_ABGR5551:
+			ConvertYUV420ToRGBA5551((u16 *)line, srcY, srcU, srcV, width);
+			break;
+		case GE_CMODE_16BIT_ABGR4444:
+			ConvertYUV420ToRGBA4444((u16 *)line, srcY, srcU, srcV, width);
+			break;
+		default:
+			ERROR_LOG_REPORT(Log::ME, "Unsupported video pixel format %d", videoPixelMode);
+			return;
+		}
+	}
+#endif // USE_FFMPEG
+}
+
+void MediaEngine::resolvePendingYUV() {
+#ifdef USE_FFMPEG
+	if (m_pendingYUVFor && m_pendingYUVFor == m_pFrameRGB) {
+		const int lineSize = getPixelFormatBytes(m_pendingPixelMode) * m_desWidth;
+		m_pFrameRGB->linesize[0] = lineSize;
+		writeVideoYUV(m_pFrameRGB->data[0], lineSize, m_pendingPixelMode, m_desWidth, m_desHeight);
+	}
+	m_pendingYUVFor = nullptr;
+#endif // USE_FFMPEG
+}
+
 int MediaEngine::writeVideoImage(u32 bufferPtr, int frameWidth, int videoPixelMode) {
 	int videoLineSize = 0;
 	switch (videoPixelMode) {
@@ -874,38 +939,43 @@ int MediaEngine::writeVideoImage(u32 bufferPtr, int frameWidth, int videoPixelMo
 		imgbuf = new u8[videoImageSize];
 	}
 
-	switch (videoPixelMode) {
-	case GE_CMODE_32BIT_ABGR8888:
-		for (int y = 0; y < height; y++) {
-			writeVideoLineRGBA(imgbuf + videoLineSize * y, data, width);
-			data += width * sizeof(u32);
-		}
-		break;
+	if (m_pendingYUVFor == m_pFrameRGB) {
+		// Still YUV, so convert it straight into place.
+		writeVideoYUV(imgbuf, videoLineSize, videoPixelMode, width, height);
+	} else {
+		switch (videoPixelMode) {
+		case GE_CMODE_32BIT_ABGR8888:
+			for (int y = 0; y < height; y++) {
+				writeVideoLineRGBA(imgbuf + videoLineSize * y, data, width);
+				data += width * sizeof(u32);
+			}
+			break;
 
-	case GE_CMODE_16BIT_BGR5650:
-		for (int y = 0; y < height; y++) {
-			writeVideoLineABGR5650(imgbuf + videoLineSize * y, data, width);
-			data += width * sizeof(u16);
-		}
-		break;
+		case GE_CMODE_16BIT_BGR5650:
+			for (int y = 0; y < height; y++) {
+				writeVideoLineABGR5650(imgbuf + videoLineSize * y, data, width);
+				data += width * sizeof(u16);
+			}
+			break;
 
-	case GE_CMODE_16BIT_ABGR5551:
-		for (int y = 0; y < height; y++) {
-			writeVideoLineABGR5551(imgbuf + videoLineSize * y, data, width);
-			data += width * sizeof(u16);
-		}
-		break;
+		case GE_CMODE_16BIT_ABGR5551:
+			for (int y = 0; y < height; y++) {
+				writeVideoLineABGR5551(imgbuf + videoLineSize * y, data, width);
+				data += width * sizeof(u16);
+			}
+			break;
 
-	case GE_CMODE_16BIT_ABGR4444:
-		for (int y = 0; y < height; y++) {
-			writeVideoLineABGR4444(imgbuf + videoLineSize * y, data, width);
-			data += width * sizeof(u16);
-		}
-		break;
+		case GE_CMODE_16BIT_ABGR4444:
+			for (int y = 0; y < height; y++) {
+				writeVideoLineABGR4444(imgbuf + videoLineSize * y, data, width);
+				data += width * sizeof(u16);
+			}
+			break;
 
-	default:
-		ERROR_LOG_REPORT(Log::ME, "Unsupported video pixel format %d", videoPixelMode);
-		break;
+		default:
+			ERROR_LOG_REPORT(Log::ME, "Unsupported video pixel format %d", videoPixelMode);
+			break;
+		}
 	}
 
 	if (swizzle) {
@@ -952,6 +1022,8 @@ int MediaEngine::writeVideoImageWithRange(u32 bufferPtr, int frameWidth, int vid
 	if (!m_pFrame || !m_pFrameRGB)
 		return 0;
 
+	resolvePendingYUV();
+
 	// lock the image size
 	u8 *imgbuf = buffer;
 	const u8 *data = m_pFrameRGB->data[0];
@@ -1028,6 +1100,7 @@ int MediaEngine::writeVideoImageWithRange(u32 bufferPtr, int frameWidth, int vid
 
 u8 *MediaEngine::getFrameImage() {
 #ifdef USE_FFMPEG
+	resolvePendingYUV();
 	return m_pFrameRGB->data[0];
 #else
 	return nullptr;
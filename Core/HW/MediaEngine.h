@@ -97,6 +97,8 @@ class MediaEngine {
 	bool SetupStreams();
 	bool setVideoDim(int width = 0, int height = 0);
 	void updateSwsFormat(int videoPixelMode);
+	void writeVideoYUV(u8 *dest, int lineSize, int videoPixelMode, int width, int height);
+	void resolvePendingYUV();
 	int getNextAudioFrame(u8 **buf, int *headerCode1, int *headerCode2);
 
 	static int MpegReadbuffer(void *opaque, uint8_t *buf, int buf_size);
@@ -128,6 +130,14 @@ class MediaEngine {
 	std::vector<AVCodecContext *> m_codecsToClose;
 	AVIOContext *m_pIOContext = nullptr;
 	SwsContext *m_sws_ctx = nullptr;
+	// When this equals m_pFrameRGB, the current picture is still only in m_pFrame as YUV 4:2:0, and
+	// writeVideoImage converts it straight into the destination. Anything else reading m_pFrameRGB resolves it first.
+	AVFrame *m_pendingYUVFor = nullptr;
+	// stepVideo decodes into this, and only swaps it with m_pFrame once it has a picture to show.
+	// avcodec_receive_frame unrefs the frame even when it fails, so m_pFrame must never be passed to it,
+	// or a pending picture would be gone when the video ends and writeVideoImage is called again.
+	AVFrame *m_pFrameDecode = nullptr;
+	int m_pendingPixelMode = 0;
 #endif
 
 	int m_sws_fmt = 0;
@@ -0,0 +1,166 @@
+// Copyright (c) 2012- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <cmath>
+#include <cstring>
+
+#include "Common/Math/SIMDHeaders.h"
+#include "Core/HW/PolyphaseFilter.h"
+#include "Core/Util/AudioFormat.h"
+
+static_assert(PolyphaseFilter::TAPS % 8 == 0, "The SIMD paths handle 8 taps at a time");
+
+// Zeroth order modified Bessel function of the first kind, for the Kaiser window.
+static double BesselI0(double x) {
+	double sum = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		const double half = x / (2.0 * k);
+		term *= half * half;
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+void PolyphaseFilter::Build(float cutoff) {
+	// Roughly 70dB of stopband attenuation.
+	constexpr double BETA = 7.0;
+	constexpr double PI_D = 3.14159265358979323846;
+	const double halfLength = TAPS / 2;
+	const double i0Beta = BesselI0(BETA);
+
+	cutoff_ = cutoff;
+	for (int p = 0; p < PHASES; p++) {
+		const double f = (double)p / PHASES;
+		double taps[TAPS];
+		double sum = 0.0;
+		for (int t = 0; t < TAPS; t++) {
+			// Distance from the output position, in input frames.
+			const double d = t - (TAPS / 2 - 1) - f;
+			const double x = d / halfLength;
+			const double window = fabs(x) < 1.0 ? BesselI0(BETA * sqrt(1.0 - x * x)) / i0Beta : 0.0;
+			const double arg = PI_D * cutoff * d;
+			const double sinc = d == 0.0 ? 1.0 : sin(arg) / arg;
+			taps[t] = sinc * window;
+			sum += taps[t];
+		}
+
+		// Normalize so that DC passes through unchanged, and put the rounding error of the fixed
+		// point version on the tap closest to the output position.
+		int fixedSum = 0;
+		for (int t = 0; t < TAPS; t++) {
+			float_[p][t] = (float)(taps[t] / sum);
+			fixed_[p][t] = (s16)lround(taps[t] / sum * (1 << 14));
+			fixedSum += fixed_[p][t];
+		}
+		fixed_[p][TAPS / 2 - 1 + (f >= 0.5 ? 1 : 0)] += (1 << 14) - fixedSum;
+	}
+}
+
+void PolyphaseFilter::FilterFixed(const s16 *frames, u32 frac, s16 *out) const {
+	const s16 *coefs = fixed_[Phase(frac)];
+#if PPSSPP_ARCH(SSE2)
+	__m128i accL = _mm_setzero_si128();
+	__m128i accR = _mm_setzero_si128();
+	for (int t = 0; t < TAPS; t += 8) {
+		// Deinterleave 8 frames by sign extending each half of the 32-bit lanes, then packing back.
+		__m128i a = _mm_loadu_si128((const __m128i *)(frames + t * 2));
+		__m128i b = _mm_loadu_si128((const __m128i *)(frames + t * 2 + 8));
+		__m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+		__m128i r = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+		__m128i c = _mm_load_si128((const __m128i *)(coefs + t));
+		accL = _mm_add_epi32(accL, _mm_madd_epi16(l, c));
+		accR = _mm_add_epi32(accR, _mm_madd_epi16(r, c));
+	}
+	__m128i sum = _mm_add_epi32(_mm_unpacklo_epi32(accL, accR), _mm_unpackhi_epi32(accL, accR));
+	sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+	sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1 << 13)), 14);
+	s32 packed = _mm_cvtsi128_si32(_mm_packs_epi32(sum, sum));
+	memcpy(out, &packed, sizeof(packed));
+#elif PPSSPP_ARCH(ARM_NEON)
+	int32x4_t accL = vdupq_n_s32(0);
+	int32x4_t accR = vdupq_n_s32(0);
+	for (int t = 0; t < TAPS; t += 8) {
+		int16x8x2_t lr = vld2q_s16(frames + t * 2);
+		int16x8_t c = vld1q_s16(coefs + t);
+		accL = vmlal_s16(accL, vget_low_s16(lr.val[0]), vget_low_s16(c));
+		accL = vmlal_s16(accL, vget_high_s16(lr.val[0]), vget_high_s16(c));
+		accR = vmlal_s16(accR, vget_low_s16(lr.val[1]), vget_low_s16(c));
+		accR = vmlal_s16(accR, vget_high_s16(lr.val[1]), vget_high_s16(c));
+	}
+	int32x2_t sum = vpadd_s32(vpadd_s32(vget_low_s32(accL), vget_high_s32(accL)), vpadd_s32(vget_low_s32(accR), vget_high_s32(accR)));
+	int16x4_t packed = vqrshrn_n_s32(vcombine_s32(sum, sum), 14);
+	vst1_lane_s16(out, packed, 0);
+	vst1_lane_s16(out + 1, packed, 1);
+#else
+	s32 l = 0;
+	s32 r = 0;
+	for (int t = 0; t < TAPS; t++) {
+		l += frames[t * 2] * coefs[t];
+		r += frames[t * 2 + 1] * coefs[t];
+	}
+	out[0] = clamp_s16((l + (1 << 13)) >> 14);
+	out[1] = clamp_s16((r + (1 << 13)) >> 14);
+#endif
+}
+
+void PolyphaseFilter::FilterFloat(const s16 *frames, u32 frac, s16 *out) const {
+	const float *coefs = float_[Phase(frac)];
+#if PPSSPP_ARCH(SSE2)
+	__m128 accL = _mm_setzero_ps();
+	__m128 accR = _mm_setzero_ps();
+	for (int t = 0; t < TAPS; t += 4) {
+		__m128i lr = _mm_loadu_si128((const __m128i *)(frames + t * 2));
+		__m128 l = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(lr, 16), 16));
+		__m128 r = _mm_cvtepi32_ps(_mm_srai_epi32(lr, 16));
+		__m128 c = _mm_load_ps(coefs + t);
+		accL = _mm_add_ps(accL, _mm_mul_ps(l, c));
+		accR = _mm_add_ps(accR, _mm_mul_ps(r, c));
+	}
+	__m128 sum = _mm_add_ps(_mm_unpacklo_ps(accL, accR), _mm_unpackhi_ps(accL, accR));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	__m128i rounded = _mm_cvtps_epi32(sum);
+	s32 packed = _mm_cvtsi128_si32(_mm_packs_epi32(rounded, rounded));
+	memcpy(out, &packed, sizeof(packed));
+#elif PPSSPP_ARCH(ARM_NEON)
+	float32x4_t accL = vdupq_n_f32(0.0f);
+	float32x4_t accR = vdupq_n_f32(0.0f);
+	for (int t = 0; t < TAPS; t += 8) {
+		int16x8x2_t lr = vld2q_s16(frames + t * 2);
+		float32x4_t c0 = vld1q_f32(coefs + t);
+		float32x4_t c1 = vld1q_f32(coefs + t + 4);
+		accL = vmlaq_f32(accL, vcvtq_f32_s32(vmovl_s16(vget_low_s16(lr.val[0]))), c0);
+		accL = vmlaq_f32(accL, vcvtq_f32_s32(vmovl_s16(vget_high_s16(lr.val[0]))), c1);
+		accR = vmlaq_f32(accR, vcvtq_f32_s32(vmovl_s16(vget_low_s16(lr.val[1]))), c0);
+		accR = vmlaq_f32(accR, vcvtq_f32_s32(vmovl_s16(vget_high_s16(lr.val[1]))), c1);
+	}
+	float32x2_t sum = vpadd_f32(vpadd_f32(vget_low_f32(accL), vget_high_f32(accL)), vpadd_f32(vget_low_f32(accR), vget_high_f32(accR)));
+	out[0] = clamp_s16((int)lrintf(vget_lane_f32(sum, 0)));
+	out[1] = clamp_s16((int)lrintf(vget_lane_f32(sum, 1)));
+#else
+	float l = 0.0f;
+	float r = 0.0f;
+	for (int t = 0; t < TAPS; t++) {
+		l += frames[t * 2] * coefs[t];
+		r += frames[t * 2 + 1] * coefs[t];
+	}
+	out[0] = clamp_s16((int)lrintf(l));
+	out[1] = clamp_s16((int)lrintf(r));
+#endif
+}
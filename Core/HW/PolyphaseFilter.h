@@ -0,0 +1,47 @@
+// Copyright (c) 2012- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Kaiser-windowed sinc filter bank for resampling interleaved stereo s16, one output frame at a time.
+// Each call reads TAPS input frames and produces the frame at 0.16 fixed-point position frac between
+// frames TAPS / 2 - 1 and TAPS / 2, so it runs TAPS / 2 frames behind a plain interpolator.
+// The phase is truncated to PHASE_BITS, there's no interpolation between neighbouring phases.
+class PolyphaseFilter {
+public:
+	static constexpr int TAPS = 32;
+	static constexpr int PHASE_BITS = 10;
+	static constexpr int PHASES = 1 << PHASE_BITS;
+
+	// cutoff is relative to the input Nyquist frequency. Both coefficient banks are rebuilt.
+	void Build(float cutoff);
+	float Cutoff() const { return cutoff_; }
+
+	// frames points to TAPS interleaved stereo frames, out receives one frame.
+	void FilterFixed(const s16 *frames, u32 frac, s16 *out) const;
+	void FilterFloat(const s16 *frames, u32 frac, s16 *out) const;
+
+private:
+	static int Phase(u32 frac) { return (frac & 0xFFFF) >> (16 - PHASE_BITS); }
+
+	float cutoff_ = 0.0f;
+	// 1.14 fixed point, each phase sums to exactly 1 << 14.
+	alignas(16) s16 fixed_[PHASES][TAPS]{};
+	alignas(16) float float_[PHASES][TAPS]{};
+};
@@ -16,7 +16,11 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
+#include "Common/Math/CrossSIMD.h"
 #include "Common/Profiler/Profiler.h"
 
 #include "Common/Serialize/SerializeFuncs.h"
@@ -27,6 +31,7 @@
 #include "Core/Util/AudioFormat.h"
 #include "Core/System.h"
 #include "SasAudio.h"
+#include "ext/xxhash.h"
 
 static const u8 f[16][2] = {
 	{   0,   0 },
@@ -49,6 +54,86 @@ static const u8 f[16][2] = {
 	{   0, 151 },
 };
 
+// Longer streams are most likely music, which isn't retriggered.
+static const int VAG_CACHE_MAX_BLOCKS = 0x4000;
+static const size_t VAG_CACHE_MAX_BYTES = 16 * 1024 * 1024;
+
+// Lookups happen at SetVoice/KeyOn time with the SAS thread drained, and entries are only
+// filled in while mixing, so the lock only needs to protect the map itself.
+static std::mutex g_vagCacheLock;
+static std::unordered_map<u64, std::shared_ptr<VagCacheEntry>> g_vagCache;
+static size_t g_vagCacheBytes;
+
+static std::atomic<u32> g_vagCacheHits;
+static std::atomic<u32> g_vagCacheMisses;
+static std::atomic<u32> g_vagCacheBlocksCached;
+static std::atomic<u32> g_vagCacheBlocksDecoded;
+
+static size_t VagCacheEntryBytes(const VagCacheEntry &entry) {
+	return (entry.size / 16) * 28 * sizeof(s16);
+}
+
+std::shared_ptr<VagCacheEntry> SasVagCacheLookup(u32 addr, u32 size) {
+	const int numBlocks = size / 16;
+	if (!g_Config.bSasVagCache || numBlocks == 0 || numBlocks > VAG_CACHE_MAX_BLOCKS || !Memory::IsValidRange(addr, size))
+		return nullptr;
+
+	// Games tend to reuse sound effect memory, so always check the contents.
+	const u64 hash = XXH3_64bits(Memory::GetPointerUnchecked(addr), numBlocks * 16);
+	const u64 key = ((u64)addr << 32) | size;
+
+	std::lock_guard<std::mutex> guard(g_vagCacheLock);
+	auto it = g_vagCache.find(key);
+	if (it != g_vagCache.end() && it->second->hash == hash) {
+		g_vagCacheHits++;
+		return it->second;
+	}
+	g_vagCacheMisses++;
+
+	if (it != g_vagCache.end()) {
+		it->second->invalidated = true;
+		g_vagCacheBytes -= VagCacheEntryBytes(*it->second);
+		g_vagCache.erase(it);
+	}
+
+	auto entry = std::make_shared<VagCacheEntry>();
+	entry->addr = addr;
+	entry->size = size;
+	entry->hash = hash;
+	entry->samples.reserve(numBlocks * 28);
+	if (g_vagCacheBytes + VagCacheEntryBytes(*entry) > VAG_CACHE_MAX_BYTES) {
+		g_vagCache.clear();
+		g_vagCacheBytes = 0;
+	}
+	g_vagCache[key] = entry;
+	g_vagCacheBytes += VagCacheEntryBytes(*entry);
+	return entry;
+}
+
+void SasVagCacheInvalidate(u32 addr, u32 size) {
+	std::lock_guard<std::mutex> guard(g_vagCacheLock);
+	for (auto it = g_vagCache.begin(); it != g_vagCache.end(); ) {
+		VagCacheEntry &entry = *it->second;
+		if (entry.addr < addr + size && addr < entry.addr + entry.size) {
+			entry.invalidated = true;
+			g_vagCacheBytes -= VagCacheEntryBytes(entry);
+			it = g_vagCache.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void SasVagCacheClear() {
+	std::lock_guard<std::mutex> guard(g_vagCacheLock);
+	g_vagCache.clear();
+	g_vagCacheBytes = 0;
+	g_vagCacheHits = 0;
+	g_vagCacheMisses = 0;
+	g_vagCacheBlocksCached = 0;
+	g_vagCacheBlocksDecoded = 0;
+}
+
 void VagDecoder::Start(u32 data, u32 vagSize, bool loopEnabled) {
 	loopEnabled_ = loopEnabled;
 	loopAtNextBlock_ = false;
@@ -61,6 +146,8 @@ void VagDecoder::Start(u32 data, u32 vagSize, bool loopEnabled) {
 	curBlock_ = -1;
 	s_1 = 0;	// per block?
 	s_2 = 0;
+	// After a loop, the ADPCM state differs from the first pass, so only cache one-shots.
+	cache_ = loopEnabled ? nullptr : SasVagCacheLookup(data, vagSize);
 }
 
 void VagDecoder::DecodeBlock(const u8 *&read_pointer) {
@@ -90,6 +177,24 @@ void VagDecoder::DecodeBlock(const u8 *&read_pointer) {
 		}
 	}
 
+	// The game changed the data under us, so the cached samples are stale. Our ADPCM state is
+	// still right for the blocks already played, so just continue decoding from memory.
+	if (cache_ && cache_->invalidated)
+		cache_.reset();
+
+	const int block = curBlock_ + 1;
+	if (cache_ && block < cache_->decodedBlocks) {
+		memcpy(samples, &cache_->samples[block * 28], sizeof(samples));
+		// The ADPCM state is just the last two samples.
+		s_2 = samples[26];
+		s_1 = samples[27];
+		curSample = 0;
+		curBlock_++;
+		g_vagCacheBlocksCached++;
+		read_pointer = readp + 14;
+		return;
+	}
+
 	// Keep state in locals to avoid bouncing to memory.
 	int s1 = s_1;
 	int s2 = s_2;
@@ -113,6 +218,13 @@ void VagDecoder::DecodeBlock(const u8 *&read_pointer) {
 	curSample = 0;
 	curBlock_++;
 
+	if (cache_ && block == cache_->decodedBlocks) {
+		cache_->samples.insert(cache_->samples.end(), samples, samples + 28);
+		cache_->decodedBlocks++;
+	}
+	if (cache_)
+		g_vagCacheBlocksDecoded++;
+
 	read_pointer = readp;
 }
 
@@ -186,6 +298,9 @@ void VagDecoder::DoState(PointerWrap &p) {
 	Do(p, loopEnabled_);
 	Do(p, loopAtNextBlock_);
 	Do(p, end_);
+
+	if (p.mode == PointerWrap::MODE_READ)
+		cache_.reset();
 }
 
 int SasAtrac3::SetContext(u32 contextAddr) {
@@ -376,6 +491,7 @@ SasInstance::SasInstance() {
 	waveformEffect.type = PSP_SAS_EFFECT_TYPE_OFF;
 	waveformEffect.isDryOn = 1;
 	memset(mixTemp_, 0, sizeof(mixTemp_));  // just to avoid a static analysis warning.
+	memset(voiceSamples_, 0, sizeof(voiceSamples_));
 }
 
 SasInstance::~SasInstance() {
@@ -411,13 +527,30 @@ void SasInstance::GetDebugText(char *text, size_t bufsize) {
 		}
 	}
 
+	char cacheBuf[256];
+	cacheBuf[0] = '\0';
+	if (g_Config.bSasVagCache) {
+		size_t entries, bytes;
+		{
+			std::lock_guard<std::mutex> guard(g_vagCacheLock);
+			entries = g_vagCache.size();
+			bytes = g_vagCacheBytes;
+		}
+		const u32 hits = g_vagCacheHits, misses = g_vagCacheMisses;
+		const u32 blocksCached = g_vagCacheBlocksCached, blocksDecoded = g_vagCacheBlocksDecoded;
+		snprintf(cacheBuf, sizeof(cacheBuf), "VAG cache: %d entries, %d KB, KeyOn hits %u/%u, blocks %0.1f%% cached\n",
+			(int)entries, (int)(bytes / 1024), hits, hits + misses,
+			blocksCached + blocksDecoded ? 100.0 * blocksCached / (blocksCached + blocksDecoded) : 0.0);
+	}
+
 	snprintf(text, bufsize,
 		"SR: %d Mode: %s Grain: %d\n"
 		"Effect: Type: %d Dry: %d Wet: %d L: %d R: %d Delay: %d Feedback: %d\n"
+		"%s"
 		"\n%s\n",
 		sampleRate, outputMode == PSP_SAS_OUTPUTMODE_RAW ? "Raw" : "Mixed", grainSize,
 		waveformEffect.type, waveformEffect.isDryOn, waveformEffect.isWetOn, waveformEffect.leftVol, waveformEffect.rightVol, waveformEffect.delay, waveformEffect.feedback,
-		voiceBuf);
+		cacheBuf, voiceBuf);
 
 }
 
@@ -525,6 +658,26 @@ bool SasVoice::HaveSamplesEnded() const {
 	}
 }
 
+// samples holds each sample twice (as written by MixVoice), so both channels are processed lane-wise.
+// The samples fit in 16 bits after the envelope, and volumes are limited to PSP_SAS_VOL_MAX,
+// so the 16-bit multiply is exact.
+void SasMixSamplesStereo(int *dest, const int *samples, int frames, int volumeLeft, int volumeRight) {
+	const int count = frames * 2;
+	int i = 0;
+#if !defined(CROSSSIMD_SLOW)
+	alignas(16) const int volumeLanes[4] = { volumeLeft, volumeRight, volumeLeft, volumeRight };
+	const Vec4S32 volumes = Vec4S32::LoadAligned(volumeLanes);
+	for (; i + 4 <= count; i += 4) {
+		Vec4S32 scaled = Vec4S32::Load(samples + i).Mul16(volumes).Shr<12>();
+		(Vec4S32::Load(dest + i) + scaled).Store(dest + i);
+	}
+#endif
+	for (; i < count; i += 2) {
+		dest[i] += (samples[i] * volumeLeft) >> 12;
+		dest[i + 1] += (samples[i + 1] * volumeRight) >> 12;
+	}
+}
+
 void SasInstance::MixVoice(SasVoice &voice) {
 	switch (voice.type) {
 	case VOICETYPE_VAG:
@@ -577,7 +730,10 @@ void SasInstance::MixVoice(SasVoice &voice) {
 			voice.envelope.Step();
 		}
 
+		// First pass (scalar): resample and apply the envelope, which is a sequential recurrence.
+		// The result is written twice per frame so the second pass can apply L/R volumes lane-wise.
 		const bool needsInterp = voicePitch != PSP_SAS_PITCH_BASE || (sampleFrac & PSP_SAS_PITCH_MASK) != 0;
+		int *samples = voiceSamples_;
 		for (int i = delay; i < grainSize; i++) {
 			const int16_t *s = mixTemp_ + (sampleFrac >> PSP_SAS_PITCH_BASE_SHIFT);
 
@@ -598,14 +754,19 @@ void SasInstance::MixVoice(SasVoice &voice) {
 			// We just scale by the envelope before we scale by volumes.
 			// Again, we round up by adding (1 << 14) first (*after* multiplying.)
 			sample = ((sample * envelopeValue) + (1 << 14)) >> 15;
+			*samples++ = sample;
+			*samples++ = sample;
+		}
 
-			// We mix into this 32-bit temp buffer and clip in a second loop
-			// Ideally, the shift right should be there too but for now I'm concerned about
-			// not overflowing.
-			mixBuffer[i * 2] += (sample * voice.volumeLeft) >> 12;
-			mixBuffer[i * 2 + 1] += (sample * voice.volumeRight) >> 12;
-			sendBuffer[i * 2] += sample * voice.effectLeft >> 12;
-			sendBuffer[i * 2 + 1] += sample * voice.effectRight >> 12;
+		// Second pass: scale by volumes and accumulate. We mix into these 32-bit temp buffers and
+		// clip in a later loop. Ideally, the shift right should be there too but for now I'm
+		// concerned about not overflowing.
+		const int frames = grainSize - delay;
+		if (frames > 0) {
+			if (voice.volumeLeft != 0 || voice.volumeRight != 0)
+				SasMixSamplesStereo(mixBuffer + delay * 2, voiceSamples_, frames, voice.volumeLeft, voice.volumeRight);
+			if (voice.effectLeft != 0 || voice.effectRight != 0)
+				SasMixSamplesStereo(sendBuffer + delay * 2, voiceSamples_, frames, voice.effectLeft, voice.effectRight);
 		}
 
 		voice.resampleHist[0] = mixTemp_[tempPos - 2];
@@ -22,6 +22,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Core/HW/BufferQueue.h"
 #include "Core/HW/SasReverb.h"
@@ -98,6 +102,25 @@ enum VoiceType {
 	VOICETYPE_ATRAC3,
 };
 
+// Decoded samples of a VAG stream, shared between all voices that play it. Blocks are added as
+// they're first decoded, and only voices that don't loop use it, so this is always the plain
+// linear decode of the data.
+struct VagCacheEntry {
+	u32 addr = 0;
+	u32 size = 0;
+	u64 hash = 0;
+	int decodedBlocks = 0;
+	std::vector<s16> samples;  // 28 per decoded block.
+	// Set when the memory changes. Voices still holding the entry go back to decoding from memory.
+	std::atomic<bool> invalidated{};
+};
+
+// Returns nullptr if the cache is disabled or the stream isn't cacheable.
+std::shared_ptr<VagCacheEntry> SasVagCacheLookup(u32 addr, u32 size);
+// Called when the game writes back or invalidates a memory range.
+void SasVagCacheInvalidate(u32 addr, u32 size);
+void SasVagCacheClear();
+
 // VAG is a Sony ADPCM audio compression format, which goes all the way back to the PSX.
 // It compresses 28 16-bit samples into a block of 16 bytes.
 class VagDecoder {
@@ -130,6 +153,9 @@ class VagDecoder {
 	bool loopEnabled_ = false;
 	bool loopAtNextBlock_ = false;
 	bool end_ = true;
+
+	// Not savestated, we just decode from memory after a load.
+	std::shared_ptr<VagCacheEntry> cache_;
 };
 
 class SasAtrac3 {
@@ -331,6 +357,10 @@ class SasInstance {
 	SasReverb reverb_;
 	int grainSize = 0;
 	int16_t mixTemp_[PSP_SAS_MAX_GRAIN * 4 + 2 + 16];  // some extra margin for very high pitches.
+	int voiceSamples_[PSP_SAS_MAX_GRAIN * 2];  // enveloped samples of the current voice, each stored twice.
 };
 
+// Accumulates (sample * volume) >> 12 into an interleaved stereo buffer. Exposed for tests.
+void SasMixSamplesStereo(int *dest, const int *samples, int frames, int volumeLeft, int volumeRight);
+
 const char *ADSRCurveModeAsString(SasADSRCurveMode mode);
@@ -15,9 +15,12 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
+#include "Common/Math/CrossSIMD.h"
 #include "Common/Math/math_util.h"
 #include "Core/Config.h"
 #include "Core/HW/SasReverb.h"
@@ -153,6 +156,109 @@ static const SasReverbData presets[10] = {
 	},
 };
 
+// Every buffer position the reverb touches, relative to the current position.
+enum ReverbTap {
+	TAP_dLSAME, TAP_dRSAME, TAP_dLDIFF, TAP_dRDIFF,
+	TAP_mLSAME, TAP_mRSAME, TAP_mLDIFF, TAP_mRDIFF,
+	TAP_mLSAME_PREV, TAP_mRSAME_PREV, TAP_mLDIFF_PREV, TAP_mRDIFF_PREV,
+	TAP_mLCOMB1, TAP_mLCOMB2, TAP_mLCOMB3, TAP_mLCOMB4,
+	TAP_mRCOMB1, TAP_mRCOMB2, TAP_mRCOMB3, TAP_mRCOMB4,
+	TAP_mLAPF1, TAP_mRAPF1, TAP_mLAPF1_SRC, TAP_mRAPF1_SRC,
+	TAP_mLAPF2, TAP_mRAPF2, TAP_mLAPF2_SRC, TAP_mRAPF2_SRC,
+	TAP_COUNT,
+};
+
+static void GetReverbTaps(const SasReverbData &d, int taps[TAP_COUNT]) {
+	taps[TAP_dLSAME] = d.dLSAME;
+	taps[TAP_dRSAME] = d.dRSAME;
+	taps[TAP_dLDIFF] = d.dLDIFF;
+	taps[TAP_dRDIFF] = d.dRDIFF;
+	taps[TAP_mLSAME] = d.mLSAME;
+	taps[TAP_mRSAME] = d.mRSAME;
+	taps[TAP_mLDIFF] = d.mLDIFF;
+	taps[TAP_mRDIFF] = d.mRDIFF;
+	taps[TAP_mLSAME_PREV] = d.mLSAME - 1;
+	taps[TAP_mRSAME_PREV] = d.mRSAME - 1;
+	taps[TAP_mLDIFF_PREV] = d.mLDIFF - 1;
+	taps[TAP_mRDIFF_PREV] = d.mRDIFF - 1;
+	taps[TAP_mLCOMB1] = d.mLCOMB1;
+	taps[TAP_mLCOMB2] = d.mLCOMB2;
+	taps[TAP_mLCOMB3] = d.mLCOMB3;
+	taps[TAP_mLCOMB4] = d.mLCOMB4;
+	taps[TAP_mRCOMB1] = d.mRCOMB1;
+	taps[TAP_mRCOMB2] = d.mRCOMB2;
+	taps[TAP_mRCOMB3] = d.mRCOMB3;
+	taps[TAP_mRCOMB4] = d.mRCOMB4;
+	taps[TAP_mLAPF1] = d.mLAPF1;
+	taps[TAP_mRAPF1] = d.mRAPF1;
+	taps[TAP_mLAPF1_SRC] = d.mLAPF1 - d.dAPF1;
+	taps[TAP_mRAPF1_SRC] = d.mRAPF1 - d.dAPF1;
+	taps[TAP_mLAPF2] = d.mLAPF2;
+	taps[TAP_mRAPF2] = d.mRAPF2;
+	taps[TAP_mLAPF2_SRC] = d.mLAPF2 - d.dAPF2;
+	taps[TAP_mRAPF2_SRC] = d.mRAPF2 - d.dAPF2;
+}
+
+enum {
+	REVERB_GROUP_SIZE = 4,
+};
+
+// ProcessGroup does all the comb and all-pass reads first, then runs the reflection filters
+// sample by sample, then does the all-pass writes. The delay lines of most presets are spread
+// out enough that this gives the same result as going sample by sample, but it has to be checked
+// for every pair of accesses that could land on the same position within a group.
+static bool CanProcessInGroups(const SasReverbData &d, const int taps[TAP_COUNT]) {
+	struct Access {
+		int tap;
+		bool write;
+		int stage;  // 0 = read up front, 1 = reflection filters (sample by sample), 2+ = all-pass writes.
+	};
+	// In the order a single sample performs them.
+	std::vector<Access> accesses;
+	static const int reflections[4][3] = {
+		{ TAP_dLSAME, TAP_mLSAME_PREV, TAP_mLSAME },
+		{ TAP_dRSAME, TAP_mRSAME_PREV, TAP_mRSAME },
+		{ TAP_dRDIFF, TAP_mLDIFF_PREV, TAP_mLDIFF },
+		{ TAP_dLDIFF, TAP_mRDIFF_PREV, TAP_mRDIFF },
+	};
+	for (const auto &r : reflections) {
+		accesses.push_back({ r[0], false, 1 });
+		accesses.push_back({ r[1], false, 1 });
+		accesses.push_back({ r[2], true, 1 });
+	}
+	const int16_t combVolumes[4] = { d.vCOMB1, d.vCOMB2, d.vCOMB3, d.vCOMB4 };
+	for (int i = 0; i < 8; i++) {
+		// A zero volume makes the value irrelevant.
+		if (combVolumes[i & 3] != 0)
+			accesses.push_back({ TAP_mLCOMB1 + i, false, 0 });
+	}
+	for (int i = 0; i < 4; i++) {
+		const int dest = TAP_mLAPF1 + (i >> 1) * 4 + (i & 1);
+		accesses.push_back({ dest + 2, false, 0 });
+		accesses.push_back({ dest, true, 2 + (i >> 1) });
+		accesses.push_back({ dest + 2, false, 0 });
+	}
+
+	for (size_t a = 0; a < accesses.size(); a++) {
+		for (size_t b = 0; b < accesses.size(); b++) {
+			const Access &first = accesses[a];
+			const Access &second = accesses[b];
+			if (a == b || (!first.write && !second.write) || (first.stage == 1 && second.stage == 1))
+				continue;
+			for (int dt = -(REVERB_GROUP_SIZE - 1); dt < REVERB_GROUP_SIZE; dt++) {
+				// Does "second", dt samples after "first", hit the same position?
+				if ((taps[first.tap] - taps[second.tap] - dt) % d.size != 0)
+					continue;
+				bool inOrder = dt > 0 || (dt == 0 && a < b);
+				bool groupedInOrder = first.stage < second.stage || (first.stage == second.stage && a < b);
+				if (inOrder != groupedInOrder)
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
 SasReverb::SasReverb() : preset_(-1), pos_(0) {
 	workspace_ = new int16_t[BUFSIZE];
 }
@@ -174,38 +280,87 @@ void SasReverb::SetPreset(int preset) {
 	if (preset_ != -1) {
 		pos_ = BUFSIZE - presets[preset_].size;
 		memset(workspace_, 0, sizeof(int16_t) * BUFSIZE);
+		int taps[TAP_COUNT];
+		GetReverbTaps(presets[preset_], taps);
+		groupsAllowed_ = CanProcessInGroups(presets[preset_], taps);
 	} else {
 		pos_ = 0;
+		groupsAllowed_ = false;
 	}
 }
 
-// Wraps around the upper part of a buffer.
-template<int bufsize>
-class BufferWrapper {
-public:
-	BufferWrapper(int16_t *buffer, int position, int usedSize) : buf_(buffer), pos_(position), end_(bufsize), base_(bufsize - usedSize), size_(usedSize) {}
-	int16_t &operator [](int index) {
-		int addr = pos_ + index;
-		if (addr >= end_) { addr -= size_; }
-		if (addr < base_) { addr += size_; }
-		return buf_[addr];
-	}
+// b points at the current position, and no tap may wrap around the end of the buffer.
+inline void SasReverb::ProcessSample(int16_t *b, const int *t, int16_t Lin, int16_t Rin, int32_t &Lout, int32_t &Rout) {
+	const SasReverbData &d = presets[preset_];
 
-	int GetPosition() { return pos_; }
-	void Next() {
-		pos_++;
-		if (pos_ >= end_) {
-			pos_ -= size_;
-		}
+	// ____Same Side Reflection(left - to - left and right - to - right)___________________
+	b[t[TAP_mLSAME]] = clamp_s16(Lin + (b[t[TAP_dLSAME]] * d.vWALL >> 15) - (b[t[TAP_mLSAME_PREV]]*d.vIIR >> 15) + b[t[TAP_mLSAME_PREV]]); // L - to - L
+	b[t[TAP_mRSAME]] = clamp_s16(Rin + (b[t[TAP_dRSAME]] * d.vWALL >> 15) - (b[t[TAP_mRSAME_PREV]]*d.vIIR >> 15) + b[t[TAP_mRSAME_PREV]]); // R - to - R
+	// ___Different Side Reflection(left - to - right and right - to - left)_______________
+	b[t[TAP_mLDIFF]] = clamp_s16(Lin + (b[t[TAP_dRDIFF]] * d.vWALL >> 15) - (b[t[TAP_mLDIFF_PREV]]*d.vIIR >> 15) + b[t[TAP_mLDIFF_PREV]]); // R - to - L
+	b[t[TAP_mRDIFF]] = clamp_s16(Rin + (b[t[TAP_dLDIFF]] * d.vWALL >> 15) - (b[t[TAP_mRDIFF_PREV]]*d.vIIR >> 15) + b[t[TAP_mRDIFF_PREV]]); // L - to - R
+	// ___Early Echo(Comb Filter, with input from buffer)__________________________
+	Lout = ((d.vCOMB1*b[t[TAP_mLCOMB1]] + d.vCOMB2*b[t[TAP_mLCOMB2]] + d.vCOMB3*b[t[TAP_mLCOMB3]] + d.vCOMB4*b[t[TAP_mLCOMB4]]) >> 15);
+	Rout = ((d.vCOMB1*b[t[TAP_mRCOMB1]] + d.vCOMB2*b[t[TAP_mRCOMB2]] + d.vCOMB3*b[t[TAP_mRCOMB3]] + d.vCOMB4*b[t[TAP_mRCOMB4]]) >> 15);
+	// ___Late Reverb APF1(All Pass Filter 1, with input from COMB)________________
+	b[t[TAP_mLAPF1]] = clamp_s16(Lout - (d.vAPF1*b[t[TAP_mLAPF1_SRC]] >> 15));
+	Lout = b[t[TAP_mLAPF1_SRC]] + (b[t[TAP_mLAPF1]] * d.vAPF1 >> 15);
+	b[t[TAP_mRAPF1]] = clamp_s16(Rout - (d.vAPF1*b[t[TAP_mRAPF1_SRC]] >> 15));
+	Rout = b[t[TAP_mRAPF1_SRC]] + (b[t[TAP_mRAPF1]] * d.vAPF1 >> 15);
+	// ___Late Reverb APF2(All Pass Filter 2, with input from APF1)________________
+	b[t[TAP_mLAPF2]] = clamp_s16(Lout - (d.vAPF2*b[t[TAP_mLAPF2_SRC]] >> 15));
+	Lout = b[t[TAP_mLAPF2_SRC]] + (b[t[TAP_mLAPF2]] * d.vAPF2 >> 15);
+	b[t[TAP_mRAPF2]] = clamp_s16(Rout - (d.vAPF2*b[t[TAP_mRAPF2_SRC]] >> 15));
+	Rout = b[t[TAP_mRAPF2_SRC]] + (b[t[TAP_mRAPF2]] * d.vAPF2 >> 15);
+}
+
+// Same as four ProcessSample calls, but the comb and all-pass stages run on four samples at a time.
+// Only valid if groupsAllowed_.
+void SasReverb::ProcessGroup(int16_t *b, const int *t, const int16_t *input, int32_t *Lout, int32_t *Rout) {
+	const SasReverbData &d = presets[preset_];
+
+	const Vec4S32 vCOMB1 = Vec4S32::Splat(d.vCOMB1);
+	const Vec4S32 vCOMB2 = Vec4S32::Splat(d.vCOMB2);
+	const Vec4S32 vCOMB3 = Vec4S32::Splat(d.vCOMB3);
+	const Vec4S32 vCOMB4 = Vec4S32::Splat(d.vCOMB4);
+	const Vec4S32 vAPF1 = Vec4S32::Splat(d.vAPF1);
+	const Vec4S32 vAPF2 = Vec4S32::Splat(d.vAPF2);
+
+	Vec4S32 lComb = (Vec4S32::LoadS16(b + t[TAP_mLCOMB1]).Mul16(vCOMB1) + Vec4S32::LoadS16(b + t[TAP_mLCOMB2]).Mul16(vCOMB2) +
+		Vec4S32::LoadS16(b + t[TAP_mLCOMB3]).Mul16(vCOMB3) + Vec4S32::LoadS16(b + t[TAP_mLCOMB4]).Mul16(vCOMB4)).Shr<15>();
+	Vec4S32 rComb = (Vec4S32::LoadS16(b + t[TAP_mRCOMB1]).Mul16(vCOMB1) + Vec4S32::LoadS16(b + t[TAP_mRCOMB2]).Mul16(vCOMB2) +
+		Vec4S32::LoadS16(b + t[TAP_mRCOMB3]).Mul16(vCOMB3) + Vec4S32::LoadS16(b + t[TAP_mRCOMB4]).Mul16(vCOMB4)).Shr<15>();
+	const Vec4S32 lApf1Src = Vec4S32::LoadS16(b + t[TAP_mLAPF1_SRC]);
+	const Vec4S32 rApf1Src = Vec4S32::LoadS16(b + t[TAP_mRAPF1_SRC]);
+	const Vec4S32 lApf2Src = Vec4S32::LoadS16(b + t[TAP_mLAPF2_SRC]);
+	const Vec4S32 rApf2Src = Vec4S32::LoadS16(b + t[TAP_mRAPF2_SRC]);
+
+	// The reflection filters are IIRs, so they have to go one sample at a time.
+	for (int i = 0; i < REVERB_GROUP_SIZE; i++) {
+		int16_t *bi = b + i;
+		int16_t Lin = input[i * 2] >> 1;
+		int16_t Rin = input[i * 2 + 1] >> 1;
+		bi[t[TAP_mLSAME]] = clamp_s16(Lin + (bi[t[TAP_dLSAME]] * d.vWALL >> 15) - (bi[t[TAP_mLSAME_PREV]]*d.vIIR >> 15) + bi[t[TAP_mLSAME_PREV]]);
+		bi[t[TAP_mRSAME]] = clamp_s16(Rin + (bi[t[TAP_dRSAME]] * d.vWALL >> 15) - (bi[t[TAP_mRSAME_PREV]]*d.vIIR >> 15) + bi[t[TAP_mRSAME_PREV]]);
+		bi[t[TAP_mLDIFF]] = clamp_s16(Lin + (bi[t[TAP_dRDIFF]] * d.vWALL >> 15) - (bi[t[TAP_mLDIFF_PREV]]*d.vIIR >> 15) + bi[t[TAP_mLDIFF_PREV]]);
+		bi[t[TAP_mRDIFF]] = clamp_s16(Rin + (bi[t[TAP_dLDIFF]] * d.vWALL >> 15) - (bi[t[TAP_mRDIFF_PREV]]*d.vIIR >> 15) + bi[t[TAP_mRDIFF_PREV]]);
 	}
 
-private:
-	int16_t *buf_;
-	int pos_;
-	int end_;
-	int base_;
-	int size_;
-};
+	// The all-pass inputs fit in 16 bits after clamping, so Mul16 is exact.
+	Vec4S32 lApf1 = (lComb - lApf1Src.Mul16(vAPF1).Shr<15>()).ClampS16();
+	lApf1.StoreS16(b + t[TAP_mLAPF1]);
+	Vec4S32 lOut = lApf1Src + lApf1.Mul16(vAPF1).Shr<15>();
+	Vec4S32 rApf1 = (rComb - rApf1Src.Mul16(vAPF1).Shr<15>()).ClampS16();
+	rApf1.StoreS16(b + t[TAP_mRAPF1]);
+	Vec4S32 rOut = rApf1Src + rApf1.Mul16(vAPF1).Shr<15>();
+
+	Vec4S32 lApf2 = (lOut - lApf2Src.Mul16(vAPF2).Shr<15>()).ClampS16();
+	lApf2.StoreS16(b + t[TAP_mLAPF2]);
+	(lApf2Src + lApf2.Mul16(vAPF2).Shr<15>()).Store(Lout);
+	Vec4S32 rApf2 = (rOut - rApf2Src.Mul16(vAPF2).Shr<15>()).ClampS16();
+	rApf2.StoreS16(b + t[TAP_mRAPF2]);
+	(rApf2Src + rApf2.Mul16(vAPF2).Shr<15>()).Store(Rout);
+}
 
 void SasReverb::ProcessReverb(int16_t *output, const int16_t *input, size_t inputSize, int volLeft, int volRight) {
 	// This means replicate the input signal in the processed buffer.
@@ -233,50 +388,60 @@ void SasReverb::ProcessReverb(int16_t *output, const int16_t *input, size_t inpu
 	}
 
 	const SasReverbData &d = presets[preset_];
-
-	// We put this on the stack instead of in the object to let the compiler optimize better (avoid mem r/w).
-	BufferWrapper<BUFSIZE> b(workspace_, pos_, d.size);
+	const int end = BUFSIZE;
+	const int base = BUFSIZE - d.size;
+	int taps[TAP_COUNT];
+	GetReverbTaps(d, taps);
 
 	// This runs at 22khz.
-	// Very unoptimized, straight from the description. Can probably be reformulated into something way more efficient.
-	// Or we could actually template the whole thing with the parameters as template arguments, as the presets are fixed.
-	for (size_t i = 0; i < inputSize; i++) {
-		// Dividing by two here is an incorrect hack. Some multiplication factor is needed to prevent the reverb from getting too loud, though.
-		int16_t LeftInput = input[i * 2] >> 1;
-		int16_t RightInput = input[i * 2 + 1] >> 1;
-
-		int16_t Lin = LeftInput; //  (d.vLIN * LeftInput) >> 15;
-		int16_t Rin = RightInput; // (d.vRIN * RightInput) >> 15;
-
-		// ____Same Side Reflection(left - to - left and right - to - right)___________________
-		b[d.mLSAME] = clamp_s16(Lin + (b[d.dLSAME] * d.vWALL >> 15) - (b[d.mLSAME - 1]*d.vIIR >> 15) + b[d.mLSAME - 1]); // L - to - L
-		b[d.mRSAME] = clamp_s16(Rin + (b[d.dRSAME] * d.vWALL >> 15) - (b[d.mRSAME - 1]*d.vIIR >> 15) + b[d.mRSAME - 1]); // R - to - R
-		// ___Different Side Reflection(left - to - right and right - to - left)_______________
-		b[d.mLDIFF] = clamp_s16(Lin + (b[d.dRDIFF] * d.vWALL >> 15) - (b[d.mLDIFF - 1]*d.vIIR >> 15) + b[d.mLDIFF - 1]); // R - to - L
-		b[d.mRDIFF] = clamp_s16(Rin + (b[d.dLDIFF] * d.vWALL >> 15) - (b[d.mRDIFF - 1]*d.vIIR >> 15) + b[d.mRDIFF - 1]); // L - to - R
-		// ___Early Echo(Comb Filter, with input from buffer)__________________________
-		int32_t Lout = ((d.vCOMB1*b[d.mLCOMB1] + d.vCOMB2*b[d.mLCOMB2] + d.vCOMB3*b[d.mLCOMB3] + d.vCOMB4*b[d.mLCOMB4]) >> 15);
-		int32_t Rout = ((d.vCOMB1*b[d.mRCOMB1] + d.vCOMB2*b[d.mRCOMB2] + d.vCOMB3*b[d.mRCOMB3] + d.vCOMB4*b[d.mRCOMB4]) >> 15);
-		// ___Late Reverb APF1(All Pass Filter 1, with input from COMB)________________
-		b[d.mLAPF1] = clamp_s16(Lout - (d.vAPF1*b[(d.mLAPF1 - d.dAPF1)] >> 15));
-		Lout = b[(d.mLAPF1 - d.dAPF1)] + (b[d.mLAPF1] * d.vAPF1 >> 15);
-		b[d.mRAPF1] = clamp_s16(Rout - (d.vAPF1*b[(d.mRAPF1 - d.dAPF1)] >> 15));
-		Rout = b[(d.mRAPF1 - d.dAPF1)] + (b[d.mRAPF1] * d.vAPF1 >> 15);
-		// ___Late Reverb APF2(All Pass Filter 2, with input from APF1)________________
-		b[d.mLAPF2] = clamp_s16(Lout - (d.vAPF2*b[(d.mLAPF2 - d.dAPF2)] >> 15));
-		Lout = b[(d.mLAPF2 - d.dAPF2)] + (b[d.mLAPF2] * d.vAPF2 >> 15);
-		b[d.mRAPF2] = clamp_s16(Rout - (d.vAPF2*b[(d.mRAPF2 - d.dAPF2)] >> 15));
-		Rout = b[(d.mRAPF2 - d.dAPF2)] + (b[d.mRAPF2] * d.vAPF2 >> 15);
-		// ___Output to Mixer(Output volume multiplied with input from APF2)___________
-		output[i * 4 + 0] = clamp_s16((Lout * volLeft) >> 15);
-		output[i * 4 + 1] = clamp_s16((Rout * volRight) >> 15);
-		output[i * 4 + 2] = 0;
-		output[i * 4 + 3] = 0;
-
-		b.Next();
-	}
+	// The buffer is a ring in the upper part of workspace_. We go through it in runs where
+	// none of the taps wrap around, so the inner loops can index it directly.
+	size_t i = 0;
+	while (i < inputSize) {
+		int run = (int)std::min(inputSize - i, (size_t)(end - pos_));
+		int t[TAP_COUNT];
+		for (int j = 0; j < TAP_COUNT; j++) {
+			int addr = pos_ + taps[j];
+			if (addr >= end) { addr -= d.size; }
+			if (addr < base) { addr += d.size; }
+			t[j] = addr - pos_;
+			run = std::min(run, end - addr);
+		}
 
-	// Save the state in the object.
-	pos_ = b.GetPosition();
-}
+		int16_t *b = workspace_ + pos_;
+		int k = 0;
+		if (groupsAllowed_) {
+			for (; k + REVERB_GROUP_SIZE <= run; k += REVERB_GROUP_SIZE) {
+				int32_t Lout[REVERB_GROUP_SIZE], Rout[REVERB_GROUP_SIZE];
+				ProcessGroup(b + k, t, input + (i + k) * 2, Lout, Rout);
+				for (int g = 0; g < REVERB_GROUP_SIZE; g++) {
+					// ___Output to Mixer(Output volume multiplied with input from APF2)___________
+					int16_t *out = output + (i + k + g) * 4;
+					out[0] = clamp_s16((Lout[g] * volLeft) >> 15);
+					out[1] = clamp_s16((Rout[g] * volRight) >> 15);
+					out[2] = 0;
+					out[3] = 0;
+				}
+			}
+		}
+		for (; k < run; k++) {
+			// Dividing by two here is an incorrect hack. Some multiplication factor is needed to prevent the reverb from getting too loud, though.
+			int16_t LeftInput = input[(i + k) * 2] >> 1;
+			int16_t RightInput = input[(i + k) * 2 + 1] >> 1;
+			int32_t Lout, Rout;
+			ProcessSample(b + k, t, LeftInput, RightInput, Lout, Rout);
+			// ___Output to Mixer(Output volume multiplied with input from APF2)___________
+			int16_t *out = output + (i + k) * 4;
+			out[0] = clamp_s16((Lout * volLeft) >> 15);
+			out[1] = clamp_s16((Rout * volRight) >> 15);
+			out[2] = 0;
+			out[3] = 0;
+		}
 
+		i += run;
+		pos_ += run;
+		if (pos_ >= end) {
+			pos_ -= d.size;
+		}
+	}
+}
@@ -38,7 +38,12 @@ class SasReverb {
 		BUFSIZE = 0x20000,
 	};
 
+	void ProcessSample(int16_t *b, const int *taps, int16_t Lin, int16_t Rin, int32_t &Lout, int32_t &Rout);
+	void ProcessGroup(int16_t *b, const int *taps, const int16_t *input, int32_t *Lout, int32_t *Rout);
+
 	int16_t *workspace_;
 	int preset_;
 	int pos_;
+	// Whether groups of four samples can be processed stage by stage, see SetPreset.
+	bool groupsAllowed_ = false;
 };
@@ -17,6 +17,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
 
 #include "Common/Serialize/SerializeFuncs.h"
 #include "Core/Debugger/MemBlockInfo.h"
@@ -140,12 +144,89 @@ class FFmpegAudioDecoder : public AudioDecoder {
 	bool codecOpen_ = false;
 };
 
+// Released decoders, waiting to be handed out again. Decoders are created and released from both the
+// emulator thread and the UI (background audio), so this is locked.
+static std::mutex g_decoderPoolLock;
+static std::map<PSPAudioType, std::vector<AudioDecoder *>> g_decoderPool;
+static AudioDecoderPoolStats g_decoderPoolStats{};
+// Per audio type. A game rarely has more than a handful of effects starting in the same frame.
+static constexpr size_t MAX_POOLED_DECODERS = 8;
+
+bool AudioDecoder::PoolKey::operator==(const PoolKey &other) const {
+	return audioType == other.audioType && standalone == other.standalone && sampleRateHz == other.sampleRateHz &&
+		channels == other.channels && blockAlign == other.blockAlign && extraDataSize == other.extraDataSize &&
+		memcmp(extraData, other.extraData, extraDataSize) == 0;
+}
+
+static bool MakePoolKey(AudioDecoder::PoolKey *key, PSPAudioType audioType, bool standalone, int sampleRateHz, int channels, size_t blockAlign, const uint8_t *extraData, size_t extraDataSize) {
+	key->audioType = audioType;
+	key->standalone = standalone;
+	key->sampleRateHz = sampleRateHz;
+	key->channels = channels;
+	key->blockAlign = blockAlign;
+	if (extraDataSize > sizeof(key->extraData)) {
+		// Not something we can match, won't be pooled.
+		return false;
+	}
+	if (extraDataSize) {
+		memcpy(key->extraData, extraData, extraDataSize);
+	}
+	key->extraDataSize = extraDataSize;
+	return true;
+}
+
+static AudioDecoder *TakePooledDecoder(const AudioDecoder::PoolKey &key) {
+	std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+	auto iter = g_decoderPool.find(key.audioType);
+	if (iter != g_decoderPool.end()) {
+		std::vector<AudioDecoder *> &decoders = iter->second;
+		for (size_t i = 0; i < decoders.size(); i++) {
+			if (decoders[i]->GetPoolKey() == key) {
+				AudioDecoder *decoder = decoders[i];
+				decoders.erase(decoders.begin() + i);
+				g_decoderPoolStats.reused++;
+				g_decoderPoolStats.pooled--;
+				return decoder;
+			}
+		}
+	}
+	return nullptr;
+}
+
+static void CountCreatedDecoder() {
+	std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+	g_decoderPoolStats.created++;
+}
+
+static AudioDecoder *CreateStandaloneDecoder(PSPAudioType audioType, int channels, size_t blockAlign, const uint8_t *extraData, size_t extraDataSize) {
+	if (audioType == PSP_CODEC_AT3) {
+		return CreateAtrac3Audio(channels, blockAlign, extraData, extraDataSize);
+	}
+	return CreateAtrac3PlusAudio(channels, blockAlign);
+}
+
+AudioDecoder *CreateAtracAudioDecoder(PSPAudioType audioType, int channels, size_t blockAlign, const uint8_t *extraData, size_t extraDataSize) {
+	_dbg_assert_(audioType == PSP_CODEC_AT3 || audioType == PSP_CODEC_AT3PLUS);
+	AudioDecoder::PoolKey key;
+	const bool poolable = MakePoolKey(&key, audioType, true, 44100, channels, blockAlign, extraData, extraDataSize);
+	AudioDecoder *decoder = poolable ? TakePooledDecoder(key) : nullptr;
+	if (!decoder) {
+		CountCreatedDecoder();
+		decoder = CreateStandaloneDecoder(audioType, channels, blockAlign, extraData, extraDataSize);
+		if (poolable) {
+			decoder->SetPoolKey(key);
+		}
+	}
+	return decoder;
+}
+
 AudioDecoder *CreateAudioDecoder(PSPAudioType audioType, int sampleRateHz, int channels, size_t blockAlign, const uint8_t *extraData, size_t extraDataSize) {
 	bool forceFfmpeg = false;
 #ifdef USE_FFMPEG
 	forceFfmpeg = g_Config.bForceFfmpegForAudioDec;
 #endif
 	if (forceFfmpeg) {
+		CountCreatedDecoder();
 		return new FFmpegAudioDecoder(audioType, sampleRateHz, channels);
 	}
 
@@ -158,15 +239,67 @@ AudioDecoder *CreateAudioDecoder(PSPAudioType audioType, int sampleRateHz, int c
 	// case PSP_CODEC_MP3:
 	// 	return new MiniMp3Audio();
 	case PSP_CODEC_AT3:
-	 	return CreateAtrac3Audio(channels, blockAlign, extraData, extraDataSize);
 	case PSP_CODEC_AT3PLUS:
-		return CreateAtrac3PlusAudio(channels, blockAlign);
+		return CreateAtracAudioDecoder(audioType, channels, blockAlign, extraData, extraDataSize);
 	default:
 		// Only AAC normally falls back to FFMPEG now.
+		// These aren't pooled, an opened FFmpeg context can't be put back to its initial state.
+		CountCreatedDecoder();
 		return new FFmpegAudioDecoder(audioType, sampleRateHz, channels);
 	}
 }
 
+void ReleaseAudioDecoder(AudioDecoder *decoder) {
+	if (!decoder) {
+		return;
+	}
+	const AudioDecoder::PoolKey &key = decoder->GetPoolKey();
+	// Reset outside the lock, it clears a fair bit of memory.
+	if (key.standalone && decoder->Reset()) {
+		std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+		std::vector<AudioDecoder *> &decoders = g_decoderPool[key.audioType];
+		if (decoders.size() < MAX_POOLED_DECODERS) {
+			decoder->SetCtxPtr(0xFFFFFFFF);
+			decoders.push_back(decoder);
+			g_decoderPoolStats.released++;
+			g_decoderPoolStats.pooled++;
+			return;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+		g_decoderPoolStats.freed++;
+	}
+	delete decoder;
+}
+
+void ClearAudioDecoderPool() {
+	std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+	for (auto &[_, decoders] : g_decoderPool) {
+		for (AudioDecoder *decoder : decoders) {
+			delete decoder;
+		}
+		g_decoderPoolStats.freed += (u32)decoders.size();
+	}
+	g_decoderPool.clear();
+	g_decoderPoolStats.pooled = 0;
+}
+
+AudioDecoderPoolStats GetAudioDecoderPoolStats() {
+	std::lock_guard<std::mutex> guard(g_decoderPoolLock);
+	return g_decoderPoolStats;
+}
+
+void GetAudioDecoderPoolDebugText(char *buf, size_t bufSize) {
+	size_t len = strlen(buf);
+	if (len >= bufSize) {
+		return;
+	}
+	const AudioDecoderPoolStats stats = GetAudioDecoderPoolStats();
+	snprintf(buf + len, bufSize - len, "Audio decoders: %u created, %u reused\n  %u released to pool, %u freed, %u pooled\n",
+		stats.created, stats.reused, stats.released, stats.freed, stats.pooled);
+}
+
 static int GetAudioCodecID(int audioType) {
 #ifdef USE_FFMPEG
 	switch (audioType) {
@@ -435,10 +568,8 @@ bool FFmpegAudioDecoder::Decode(const uint8_t *inbuf, int inbytes, int *inbytesC
 }
 
 void AudioClose(AudioDecoder **ctx) {
-#ifdef USE_FFMPEG
-	delete *ctx;
-	*ctx = 0;
-#endif  // USE_FFMPEG
+	ReleaseAudioDecoder(*ctx);
+	*ctx = nullptr;
 }
 
 void AudioClose(FFmpegAudioDecoder **ctx) {
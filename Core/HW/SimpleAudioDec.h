@@ -39,19 +39,61 @@ class AudioDecoder {
 	// NOTE: This can come late (MediaEngine::getAudioSample)! But it will come before the first Decode.
 	virtual void SetChannels(int channels) = 0;
 	virtual void FlushBuffers() {}
+	// Puts the decoder back in the state it was created in, so the pool can hand it out again.
+	// Decoders that can't do that return false, and are deleted instead.
+	virtual bool Reset() { return false; }
+	// Makes this decoder continue exactly where other is, so both produce the same output for the next packets.
+	// Only works between decoders with the same pool key, returns false if it isn't supported.
+	virtual bool CopyStateFrom(const AudioDecoder &other) { return false; }
 
 	// Just metadata.
 	void SetCtxPtr(uint32_t ptr) { ctxPtr = ptr; }
 	uint32_t GetCtxPtr() const { return ctxPtr; }
 
+	// What the decoder was created with. Set by the create functions, used to match it in the pool.
+	struct PoolKey {
+		bool operator==(const PoolKey &other) const;
+
+		PSPAudioType audioType = (PSPAudioType)0;
+		bool standalone = false;
+		int sampleRateHz = 0;
+		int channels = 0;
+		size_t blockAlign = 0;
+		uint8_t extraData[14]{};
+		size_t extraDataSize = 0;
+	};
+	const PoolKey &GetPoolKey() const { return poolKey_; }
+	void SetPoolKey(const PoolKey &key) { poolKey_ = key; }
+
 private:
 	uint32_t ctxPtr = 0xFFFFFFFF;
+	PoolKey poolKey_;
+};
+
+struct AudioDecoderPoolStats {
+	u32 created;
+	u32 reused;
+	u32 released;  // Reset and put back in the pool.
+	u32 freed;     // Couldn't be reset, or the pool was full.
+	u32 pooled;    // Currently waiting in the pool.
 };
 
+// Releases the decoder through ReleaseAudioDecoder, and clears the pointer.
 void AudioClose(AudioDecoder **ctx);
 const char *GetCodecName(int codec);  // audioType
 bool IsValidCodec(PSPAudioType codec);
+// Reuses a released decoder created with the same parameters, if there is one.
 AudioDecoder *CreateAudioDecoder(PSPAudioType audioType, int sampleRateHz = 44100, int channels = 2, size_t blockAlign = 0, const uint8_t *extraData = nullptr, size_t extraDataSize = 0);
+// Like CreateAudioDecoder, but always uses the standalone Atrac3/Atrac3+ decoder, ignoring bForceFfmpegForAudioDec.
+AudioDecoder *CreateAtracAudioDecoder(PSPAudioType audioType, int channels, size_t blockAlign, const uint8_t *extraData = nullptr, size_t extraDataSize = 0);
+// Use this instead of delete. Games that create and destroy a decoder per sound effect would
+// otherwise keep allocating and freeing large codec contexts.
+void ReleaseAudioDecoder(AudioDecoder *decoder);
+// Deletes everything in the pool. Called on shutdown.
+void ClearAudioDecoderPool();
+AudioDecoderPoolStats GetAudioDecoderPoolStats();
+// Appends a text version of the stats.
+void GetAudioDecoderPoolDebugText(char *buf, size_t bufSize);
 
 class AuCtx {
 public:
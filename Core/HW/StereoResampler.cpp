@@ -46,15 +46,13 @@
 #include "Core/Config.h"
 #include "Core/ConfigValues.h"
 #include "Core/HW/StereoResampler.h"
-#include "Core/Util/AudioFormat.h"  // for clamp_u16
+#include "Core/Util/AudioFormat.h"
 #include "Core/System.h"
 
 StereoResampler::StereoResampler() noexcept
 		: maxBufsize_(MAX_BUFSIZE_DEFAULT)
-	  , targetBufsize_(TARGET_BUFSIZE_DEFAULT) {
-	// Need to have space for the worst case in case it changes.
-	buffer_ = new int16_t[MAX_BUFSIZE_EXTRA * 2]();
-
+	  , targetBufsize_(TARGET_BUFSIZE_DEFAULT)
+	  , ring_(MAX_BUFSIZE_EXTRA * 2) {  // Need to have space for the worst case in case it changes.
 	// Some Android devices are v-synced to non-60Hz framerates. We simply timestretch audio to fit.
 	// TODO: should only do this if auto frameskip is off?
 	float refresh = System_GetPropertyFloat(SYSPROP_DISPLAY_REFRESH_RATE);
@@ -70,12 +68,36 @@ StereoResampler::StereoResampler() noexcept
 }
 
 StereoResampler::~StereoResampler() {
-	delete[] buffer_;
-	buffer_ = nullptr;
+	delete activeFilter_;
+	delete pendingFilter_.load();
+	delete retiredFilter_.load();
+}
+
+// Called from the emulator thread.
+void StereoResampler::UpdateFilter() {
+	delete retiredFilter_.exchange(nullptr);
+
+	const AudioResampler resampler = (AudioResampler)g_Config.iAudioResampler;
+	if (resampler != AudioResampler::SINC_FIXED && resampler != AudioResampler::SINC_FLOAT)
+		return;
+	const int sampleRate = wantedFilterRate_.load();
+	if (sampleRate == 0 || sampleRate == builtFilterRate_ || pendingFilter_.load())
+		return;
+
+	RateFilter *rateFilter = new RateFilter();
+	// When the output rate is lower, the cutoff has to move down with it to avoid aliasing.
+	rateFilter->filter.Build(0.9f * std::min(1.0f, (float)sampleRate / inputSampleRateHz_));
+	rateFilter->sampleRate = sampleRate;
+	builtFilterRate_ = sampleRate;
+	pendingFilter_.store(rateFilter);
 }
 
 void StereoResampler::UpdateBufferSize() {
-	if (g_Config.bExtraAudioBuffering) {
+	if (g_Config.iAudioLatencyMs > 0) {
+		// Explicit latency target.
+		targetBufsize_ = std::clamp(g_Config.iAudioLatencyMs * inputSampleRateHz_ / 1000, TARGET_BUFSIZE_MARGIN, MAX_BUFSIZE_EXTRA / 2);
+		maxBufsize_ = targetBufsize_ * 2 > MAX_BUFSIZE_DEFAULT ? MAX_BUFSIZE_EXTRA : MAX_BUFSIZE_DEFAULT;
+	} else if (g_Config.bExtraAudioBuffering) {
 		maxBufsize_ = MAX_BUFSIZE_EXTRA;
 		targetBufsize_ = TARGET_BUFSIZE_EXTRA;
 	} else {
@@ -91,62 +113,8 @@ void StereoResampler::UpdateBufferSize() {
 	}
 }
 
-// factor is a 0.12-bit fixed point number.
-template<bool multiply>
-inline void ClampBufferToS16(s16 *out, const s32 *in, size_t size, int factor) {
-	if (multiply) {
-		// Let's SIMD later. Unfortunately for s16 operations, SSE2 is very different and odd
-		// so CrossSIMD won't be very useful.
-		// LLVM autovec does an okay job with this on ARM64, it turns out.
-		for (size_t i = 0; i < size; i++) {
-			out[i] = clamp_s16((in[i] * factor) >> 12);
-		}
-	} else {
-#ifdef _M_SSE
-		// Size will always be 16-byte aligned as the hwBlockSize is.
-		while (size >= 8) {
-			__m128i in1 = _mm_loadu_si128((__m128i *)in);
-			__m128i in2 = _mm_loadu_si128((__m128i *)(in + 4));
-			__m128i packed = _mm_packs_epi32(in1, in2);  // pack with signed saturation, perfect.
-			_mm_storeu_si128((__m128i *)out, packed);
-			out += 8;
-			in += 8;
-			size -= 8;
-		}
-#elif PPSSPP_ARCH(ARM_NEON)
-		// Dynamic shifts can only be left, but it's signed - negate to shift right.
-		while (size >= 8) {
-			int32x4_t in1 = vld1q_s32(in);
-			int32x4_t in2 = vld1q_s32(in + 4);
-			int16x4_t packed1 = vqmovn_s32(in1);
-			int16x4_t packed2 = vqmovn_s32(in2);
-			vst1_s16(out, packed1);
-			vst1_s16(out + 4, packed2);
-			out += 8;
-			in += 8;
-			size -= 8;
-		}
-#endif
-		// This does the remainder if SIMD was used, otherwise it does it all.
-		for (size_t i = 0; i < size; i++) {
-			out[i] = clamp_s16(in[i]);
-		}
-	}
-}
-
-inline void ClampBufferToS16WithVolume(s16 *out, const s32 *in, size_t size, int volume) {
-	// The last parameter to ClampBufferToS16 is no longer a shift, now it's a 12-bit multiplier.
-	if (volume >= 4096) {
-		ClampBufferToS16<false>(out, in, size, 0);
-	} else if (volume <= 0) {
-		memset(out, 0, size * sizeof(s16));
-	} else {
-		ClampBufferToS16<true>(out, in, size, volume);
-	}
-}
-
 void StereoResampler::Clear() {
-	memset(buffer_, 0, maxBufsize_ * 2 * sizeof(int16_t));
+	ring_.Clear();
 }
 
 inline int16_t MixSingleSample(int16_t s1, int16_t s2, uint16_t frac) {
@@ -164,29 +132,24 @@ void StereoResampler::Mix(s16 *samples, unsigned int numSamples, bool consider_f
 	if (!samples)
 		return;
 
-	if (!buffer_) {
-		return;
-	}
-
 	unsigned int currentSample;
 
 	// Cache access in non-volatile variable
 	// This is the only function changing the read value, so it's safe to
 	// cache it locally although it's written here.
 	// The writing pointer will be modified outside, but it will only increase,
-	// so we will just ignore new written data while interpolating (until it wraps...).
+	// so we will just ignore new written data while interpolating.
 	// Without this cache, the compiler wouldn't be allowed to optimize the
 	// interpolation loop.
-	u32 indexR = indexR_.load();
-	u32 indexW = indexW_.load();
-
-	const int INDEX_MASK = (maxBufsize_ * 2 - 1);
+	u32 indexR = ring_.Tail();
+	u32 indexW = ring_.Head();
 
 	// This is only for debug visualization, not used for anything.
-	lastBufSize_ = ((indexW - indexR) & INDEX_MASK) / 2;
+	lastBufSize_ = (indexW - indexR) / 2;
+	ring_.stats.RecordLatency(1000.0f * lastBufSize_ / inputSampleRateHz_);
 
 	// Drift prevention mechanism.
-	float numLeft = (float)(((indexW - indexR) & INDEX_MASK) / 2);
+	float numLeft = (float)((indexW - indexR) / 2);
 	// If we had to discard samples the last frame due to underrun,
 	// apply an adjustment here. Otherwise we'll overestimate how many
 	// samples we need.
@@ -208,27 +171,65 @@ void StereoResampler::Mix(s16 *samples, unsigned int numSamples, bool consider_f
 	outputSampleRateHz_ = (float)(inputSampleRateHz_ + offset);
 	const u32 ratio = (u32)(65536.0 * outputSampleRateHz_ / (double)sample_rate);
 	ratio_ = ratio;
-	// TODO: consider a higher-quality resampling algorithm.
 	// TODO: Add a fast path for 1:1.
 	u32 frac = frac_;
-	for (currentSample = 0; currentSample < numSamples * 2; currentSample += 2) {
-		if (((indexW - indexR) & INDEX_MASK) <= 2) {
-			// Ran out!
-			// int missing = numSamples * 2 - currentSample;
-			// ILOG("Resampler underrun: %d (numSamples: %d, currentSample: %d)", missing, numSamples, currentSample / 2);
-			underrunCount_++;
-			break;
+	const AudioResampler resampler = (AudioResampler)g_Config.iAudioResampler;
+	const bool sinc = resampler == AudioResampler::SINC_FIXED || resampler == AudioResampler::SINC_FLOAT;
+	if (sinc) {
+		wantedFilterRate_.store(sample_rate);
+		// Only take a new filter once the emulator thread has freed the last one we gave back.
+		if (!retiredFilter_.load()) {
+			RateFilter *pending = pendingFilter_.exchange(nullptr);
+			if (pending) {
+				retiredFilter_.store(activeFilter_);
+				activeFilter_ = pending;
+			}
+		}
+	}
+
+	if (sinc && activeFilter_ && activeFilter_->sampleRate == sample_rate) {
+		const PolyphaseFilter &filter = activeFilter_->filter;
+		constexpr int FILTER_SPAN = PolyphaseFilter::TAPS * 2;
+		alignas(16) s16 wrapped[FILTER_SPAN];
+		for (currentSample = 0; currentSample < numSamples * 2; currentSample += 2) {
+			if ((s32)(indexW - indexR) < FILTER_SPAN) {
+				ring_.stats.RecordUnderrun();
+				break;
+			}
+			const s16 *frames = &ring_.At(indexR);
+			if (ring_.ContiguousFrom(indexR) < FILTER_SPAN) {
+				for (int i = 0; i < FILTER_SPAN; i++)
+					wrapped[i] = ring_.At(indexR + i);
+				frames = wrapped;
+			}
+			if (resampler == AudioResampler::SINC_FIXED)
+				filter.FilterFixed(frames, frac, &samples[currentSample]);
+			else
+				filter.FilterFloat(frames, frac, &samples[currentSample]);
+			frac += ratio;
+			indexR += 2 * (frac >> 16);
+			frac &= 0xffff;
+		}
+	} else {
+		for (currentSample = 0; currentSample < numSamples * 2; currentSample += 2) {
+			if ((s32)(indexW - indexR) <= 2) {
+				// Ran out!
+				// int missing = numSamples * 2 - currentSample;
+				// ILOG("Resampler underrun: %d (numSamples: %d, currentSample: %d)", missing, numSamples, currentSample / 2);
+				ring_.stats.RecordUnderrun();
+				break;
+			}
+			u32 indexR2 = indexR + 2; //next sample
+			s16 l1 = ring_.At(indexR); //current
+			s16 r1 = ring_.At(indexR + 1); //current
+			s16 l2 = ring_.At(indexR2); //next
+			s16 r2 = ring_.At(indexR2 + 1); //next
+			samples[currentSample] = MixSingleSample(l1, l2, (u16)frac);
+			samples[currentSample + 1] = MixSingleSample(r1, r2, (u16)frac);
+			frac += ratio;
+			indexR += 2 * (frac >> 16);
+			frac &= 0xffff;
 		}
-		u32 indexR2 = indexR + 2; //next sample
-		s16 l1 = buffer_[indexR & INDEX_MASK]; //current
-		s16 r1 = buffer_[(indexR + 1) & INDEX_MASK]; //current
-		s16 l2 = buffer_[indexR2 & INDEX_MASK]; //next
-		s16 r2 = buffer_[(indexR2 + 1) & INDEX_MASK]; //next
-		samples[currentSample] = MixSingleSample(l1, l2, (u16)frac);
-		samples[currentSample + 1] = MixSingleSample(r1, r2, (u16)frac);
-		frac += ratio;
-		indexR += 2 * (frac >> 16);
-		frac &= 0xffff;
 	}
 	frac_ = frac;
 
@@ -237,15 +238,15 @@ void StereoResampler::Mix(s16 *samples, unsigned int numSamples, bool consider_f
 
 	// Padding with the last value to reduce clicking
 	short s[2];
-	s[0] = clamp_s16(buffer_[(indexR - 1) & INDEX_MASK]);
-	s[1] = clamp_s16(buffer_[(indexR - 2) & INDEX_MASK]);
+	s[0] = clamp_s16(ring_.At(indexR - 1));
+	s[1] = clamp_s16(ring_.At(indexR - 2));
 	for (; currentSample < numSamples * 2; currentSample += 2) {
 		samples[currentSample] = s[0];
 		samples[currentSample + 1] = s[1];
 	}
 
 	// Flush cached variable
-	indexR_.store(indexR);
+	ring_.PublishTail(indexR);
 }
 
 // Executes on the emulator thread, pushing sound into the buffer.
@@ -253,11 +254,11 @@ void StereoResampler::PushSamples(const s32 *samples, unsigned int numSamples, f
 	inputSampleCount_ += numSamples;
 
 	UpdateBufferSize();
-	const int INDEX_MASK = (maxBufsize_ * 2 - 1);
+	UpdateFilter();
 	// Cache access in non-volatile variable
 	// indexR isn't allowed to cache in the audio throttling loop as it
 	// needs to get updates to not deadlock.
-	u32 indexW = indexW_.load();
+	u32 indexW = ring_.Head();
 
 	u32 cap = maxBufsize_ * 2;
 	// If fast-forwarding, no need to fill up the entire buffer, just screws up timing after releasing the fast-forward button.
@@ -267,9 +268,9 @@ void StereoResampler::PushSamples(const s32 *samples, unsigned int numSamples, f
 
 	// Check if we have enough free space
 	// indexW == indexR_ results in empty buffer, so indexR must always be smaller than indexW
-	if (numSamples * 2 + ((indexW - indexR_.load()) & INDEX_MASK) >= cap) {
+	if (numSamples * 2 + (indexW - ring_.Tail()) >= cap) {
 		if (!PSP_CoreParameter().fastForward) {
-			overrunCount_++;
+			ring_.stats.RecordOverrun();
 		}
 		// TODO: "Timestretch" by doing a windowed overlap with existing buffer content?
 		return;
@@ -279,15 +280,15 @@ void StereoResampler::PushSamples(const s32 *samples, unsigned int numSamples, f
 	int volume = (int)(multiplier * 4096.0f);
 
 	// Check if we need to roll over to the start of the buffer during the copy.
-	unsigned int indexW_left_samples = maxBufsize_ * 2 - (indexW & INDEX_MASK);
+	unsigned int indexW_left_samples = ring_.ContiguousFrom(indexW);
 	if (numSamples * 2 > indexW_left_samples) {
-		ClampBufferToS16WithVolume(&buffer_[indexW & INDEX_MASK], samples, indexW_left_samples, volume);
-		ClampBufferToS16WithVolume(&buffer_[0], samples + indexW_left_samples, numSamples * 2 - indexW_left_samples, volume);
+		ClampBufferToS16WithVolume(&ring_.At(indexW), samples, indexW_left_samples, volume);
+		ClampBufferToS16WithVolume(&ring_.At(indexW + indexW_left_samples), samples + indexW_left_samples, numSamples * 2 - indexW_left_samples, volume);
 	} else {
-		ClampBufferToS16WithVolume(&buffer_[indexW & INDEX_MASK], samples, numSamples * 2, volume);
+		ClampBufferToS16WithVolume(&ring_.At(indexW), samples, numSamples * 2, volume);
 	}
 
-	indexW_ += numSamples * 2;
+	ring_.PublishHead(indexW + numSamples * 2);
 	lastPushSize_ = numSamples;
 }
 
@@ -301,8 +302,8 @@ void StereoResampler::GetAudioDebugStats(char *buf, size_t bufSize) {
 	snprintf(buf, bufSize,
 		"Audio buffer: %d/%d (%0.1fms, target: %d)\n"
 		"Filtered: %0.2f\n"
-		"Underruns: %d\n"
-		"Overruns: %d\n"
+		"Underruns: %u\n"
+		"Overruns: %u\n"
 		"Sample rate: %d (input: %d)\n"
 		"Effective input sample rate: %0.2f\n"
 		"Effective output sample rate: %0.2f\n"
@@ -313,18 +314,15 @@ void StereoResampler::GetAudioDebugStats(char *buf, size_t bufSize) {
 		bufferLatencyMs,
 		targetBufsize_,
 		numLeftI_,
-		underrunCountTotal_,
-		overrunCountTotal_,
+		ring_.stats.underruns.load(),
+		ring_.stats.overruns.load(),
 		(int)outputSampleRateHz_,
 		inputSampleRateHz_,
 		effective_input_sample_rate,
 		effective_output_sample_rate,
 		lastPushSize_,
 		(float)ratio_ / 65536.0f);
-	underrunCountTotal_ += underrunCount_;
-	overrunCountTotal_ += overrunCount_;
-	underrunCount_ = 0;
-	overrunCount_ = 0;
+	ring_.stats.FormatHistogram(buf, bufSize);
 
 	// Use this to remove the bias from the startup.
 	// if (elapsed > 3.0) {
@@ -333,10 +331,7 @@ void StereoResampler::GetAudioDebugStats(char *buf, size_t bufSize) {
 }
 
 void StereoResampler::ResetStatCounters() {
-	underrunCount_ = 0;
-	overrunCount_ = 0;
-	underrunCountTotal_ = 0;
-	overrunCountTotal_ = 0;
+	ring_.stats.Reset();
 	inputSampleCount_ = 0;
 	outputSampleCount_ = 0;
 	startTime_ = time_now_d();
@@ -23,6 +23,8 @@
 #include <atomic>
 
 #include "Common/CommonTypes.h"
+#include "Core/HW/AudioRing.h"
+#include "Core/HW/PolyphaseFilter.h"
 
 struct AudioDebugStats;
 
@@ -53,22 +55,32 @@ class StereoResampler {
 	// This can be adjusted, for the case of non-60hz output (a few hz off).
 	int inputSampleRateHz_ = 44100;
 
-	int16_t *buffer_ = nullptr;
-	std::atomic<u32> indexW_;
-	std::atomic<u32> indexR_;
+	// Interleaved stereo samples.
+	AudioRing<int16_t> ring_;
 	float numLeftI_ = 0.0f;
 
+	// Only used with the sinc resamplers. Building a filter bank is too slow for the audio callback,
+	// so the emulator thread builds it for the rate Mix asks for, and hands it over through
+	// pendingFilter_. Mix puts the one it replaced in retiredFilter_ for the emulator thread to free.
+	// Until a filter for the current output rate is in place, Mix uses linear interpolation.
+	struct RateFilter {
+		PolyphaseFilter filter;
+		int sampleRate;
+	};
+	void UpdateFilter();
+
+	RateFilter *activeFilter_ = nullptr;  // Only touched by Mix.
+	std::atomic<RateFilter *> pendingFilter_{};
+	std::atomic<RateFilter *> retiredFilter_{};
+	std::atomic<int> wantedFilterRate_{};
+	int builtFilterRate_ = 0;  // Only touched by the emulator thread.
+
 	u32 frac_ = 0;
 	float outputSampleRateHz_ = 0.0;
 	int lastBufSize_ = 0;
 	int lastPushSize_ = 0;
 	u32 ratio_ = 0;
 
-	int underrunCount_ = 0;
-	int overrunCount_ = 0;
-	int underrunCountTotal_ = 0;
-	int overrunCountTotal_ = 0;
-
 	int droppedSamples_ = 0;
 
 	int64_t inputSampleCount_ = 0;
@@ -572,6 +572,7 @@ void PSP_UpdateDebugStats(bool collectStats) {
 
 	if (!PSP_CoreParameter().frozen && !Core_IsStepping()) {
 		kernelStats.ResetFrame();
+		gpuStatsHistory.Record(gpuStats.perFrame, gpuStats.totals.numFlips);
 		gpuStats.ResetFrame();
 	}
 }
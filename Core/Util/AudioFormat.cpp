@@ -21,6 +21,17 @@
 #include "Core/Util/AudioFormat.h"
 #include "Common/Math/SIMDHeaders.h"
 
+#ifdef _M_SSE
+#include <immintrin.h>
+
+// Lets us build SSE4.1/AVX2 kernels without raising the baseline for the whole file.
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET(x) [[gnu::target(x)]]
+#else
+#define AUDIO_TARGET(x)
+#endif
+#endif
+
 // TODO: This shouldn't be a global.
 #if PPSSPP_ARCH(ARM_NEON)
 alignas(16) static s16 volumeValues[4] = {};
@@ -140,3 +151,148 @@ void ConvertS16ToF32(float *out, const s16 *in, size_t size) {
 		out[i] = in[i] * (1.0f / 32767.0f);
 	}
 }
+
+#ifdef _M_SSE
+AUDIO_TARGET("sse4.1")
+static size_t MixS16ToS32SSE4(s32 *out, const s16 *in, size_t size, bool accumulate) {
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m128i samples = _mm_loadu_si128((const __m128i *)(in + i));
+		__m128i lo = _mm_cvtepi16_epi32(samples);
+		__m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(samples, 8));
+		if (accumulate) {
+			lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i *)(out + i)));
+			hi = _mm_add_epi32(hi, _mm_loadu_si128((const __m128i *)(out + i + 4)));
+		}
+		_mm_storeu_si128((__m128i *)(out + i), lo);
+		_mm_storeu_si128((__m128i *)(out + i + 4), hi);
+	}
+	return i;
+}
+
+AUDIO_TARGET("avx2")
+static size_t MixS16ToS32AVX2(s32 *out, const s16 *in, size_t size, bool accumulate) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		__m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(in + i)));
+		__m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(in + i + 8)));
+		if (accumulate) {
+			lo = _mm256_add_epi32(lo, _mm256_loadu_si256((const __m256i *)(out + i)));
+			hi = _mm256_add_epi32(hi, _mm256_loadu_si256((const __m256i *)(out + i + 8)));
+		}
+		_mm256_storeu_si256((__m256i *)(out + i), lo);
+		_mm256_storeu_si256((__m256i *)(out + i + 8), hi);
+	}
+	return i;
+}
+
+AUDIO_TARGET("sse4.1")
+static size_t ClampS32ToS16VolumeSSE4(s16 *out, const s32 *in, size_t size, int volume) {
+	const __m128i factor = _mm_set1_epi32(volume);
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m128i in1 = _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(in + i)), factor);
+		__m128i in2 = _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(in + i + 4)), factor);
+		_mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(_mm_srai_epi32(in1, 12), _mm_srai_epi32(in2, 12)));
+	}
+	return i;
+}
+#endif
+
+template <bool accumulate>
+static void MixS16ToS32(s32 *out, const s16 *in, size_t size) {
+	size_t i = 0;
+#ifdef _M_SSE
+	if (cpu_info.bAVX2) {
+		i = MixS16ToS32AVX2(out, in, size, accumulate);
+	} else if (cpu_info.bSSE4_1) {
+		i = MixS16ToS32SSE4(out, in, size, accumulate);
+	} else {
+		// No 16-to-32-bit sign extension in SSE2, so unpack against a mask of the sign bits instead.
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 8 <= size; i += 8) {
+			__m128i samples = _mm_loadu_si128((const __m128i *)(in + i));
+			__m128i sign = _mm_cmpgt_epi16(zero, samples);
+			__m128i lo = _mm_unpacklo_epi16(samples, sign);
+			__m128i hi = _mm_unpackhi_epi16(samples, sign);
+			if (accumulate) {
+				lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i *)(out + i)));
+				hi = _mm_add_epi32(hi, _mm_loadu_si128((const __m128i *)(out + i + 4)));
+			}
+			_mm_storeu_si128((__m128i *)(out + i), lo);
+			_mm_storeu_si128((__m128i *)(out + i + 4), hi);
+		}
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	for (; i + 8 <= size; i += 8) {
+		int16x8_t samples = vld1q_s16(in + i);
+		int32x4_t lo, hi;
+		if (accumulate) {
+			lo = vaddw_s16(vld1q_s32(out + i), vget_low_s16(samples));
+			hi = vaddw_s16(vld1q_s32(out + i + 4), vget_high_s16(samples));
+		} else {
+			lo = vmovl_s16(vget_low_s16(samples));
+			hi = vmovl_s16(vget_high_s16(samples));
+		}
+		vst1q_s32(out + i, lo);
+		vst1q_s32(out + i + 4, hi);
+	}
+#endif
+	for (; i < size; i++) {
+		if (accumulate)
+			out[i] += in[i];
+		else
+			out[i] = in[i];
+	}
+}
+
+void ConvertS16ToS32(s32 *out, const s16 *in, size_t size) {
+	MixS16ToS32<false>(out, in, size);
+}
+
+void AccumulateS16ToS32(s32 *out, const s16 *in, size_t size) {
+	MixS16ToS32<true>(out, in, size);
+}
+
+void ClampBufferToS16WithVolume(s16 *out, const s32 *in, size_t size, int volume) {
+	if (volume <= 0) {
+		memset(out, 0, size * sizeof(s16));
+		return;
+	}
+
+	size_t i = 0;
+	if (volume >= 4096) {
+#ifdef _M_SSE
+		for (; i + 8 <= size; i += 8) {
+			__m128i in1 = _mm_loadu_si128((const __m128i *)(in + i));
+			__m128i in2 = _mm_loadu_si128((const __m128i *)(in + i + 4));
+			_mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(in1, in2));  // pack with signed saturation, perfect.
+		}
+#elif PPSSPP_ARCH(ARM_NEON)
+		for (; i + 8 <= size; i += 8) {
+			vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vld1q_s32(in + i)), vqmovn_s32(vld1q_s32(in + i + 4))));
+		}
+#endif
+		for (; i < size; i++) {
+			out[i] = clamp_s16(in[i]);
+		}
+		return;
+	}
+
+#ifdef _M_SSE
+	// SSE2 has no 32-bit multiply that keeps the low half, so only SSE4.1 gets a fast path here.
+	if (cpu_info.bSSE4_1) {
+		i = ClampS32ToS16VolumeSSE4(out, in, size, volume);
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	const int32x4_t factor = vdupq_n_s32(volume);
+	for (; i + 8 <= size; i += 8) {
+		int32x4_t in1 = vshrq_n_s32(vmulq_s32(vld1q_s32(in + i), factor), 12);
+		int32x4_t in2 = vshrq_n_s32(vmulq_s32(vld1q_s32(in + i + 4), factor), 12);
+		vst1q_s16(out + i, vcombine_s16(vqmovn_s32(in1), vqmovn_s32(in2)));
+	}
+#endif
+	for (; i < size; i++) {
+		out[i] = clamp_s16((in[i] * volume) >> 12);
+	}
+}
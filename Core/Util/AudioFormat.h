@@ -67,3 +67,10 @@ static inline s16 ApplySampleVolume20Bit(s16 sample, int vol20) {
 
 void AdjustVolumeBlock(s16 *out, s16 *in, size_t size, int leftVol, int rightVol);
 void ConvertS16ToF32(float *ou, const s16 *in, size_t size);
+
+// Sign-extends s16 samples into an s32 mix buffer. The Accumulate variant adds to what's already there.
+void ConvertS16ToS32(s32 *out, const s16 *in, size_t size);
+void AccumulateS16ToS32(s32 *out, const s16 *in, size_t size);
+// Packs an s32 mix buffer down to s16 with saturation. volume is a 0.12-bit fixed point
+// multiplier, anything from 4096 up means unity.
+void ClampBufferToS16WithVolume(s16 *out, const s32 *in, size_t size, int volume);
@@ -8,21 +8,15 @@
 #include "Common/Math/math_util.h"
 #include "GPU/Common/VertexDecoderCommon.h"
 
-DepthScissor DepthScissor::Tile(int tile, int numTiles) const {
-	if (numTiles == 1) {
-		return *this;
+DepthScissor DepthScissor::Tile(int left, int right) const {
+	// The result is empty (x2 < x1) if the scissor doesn't reach into the column.
+	DepthScissor scissor = *this;
+	scissor.x1 = std::max((int)x1, left);
+	scissor.x2 = std::min((int)x2, right - 1);
+	if (scissor.x2 < scissor.x1) {
+		scissor.x1 = 1;
+		scissor.x2 = 0;
 	}
-	// First tiling algorithm: Split into vertical slices.
-	int w = x2 - x1;
-	int tileW = (w / numTiles) & ~3;  // Round to four pixels.
-
-	// TODO: Should round x1 to four pixels as well! except the first one
-
-	DepthScissor scissor;
-	scissor.x1 = x1 + tileW * tile;
-	scissor.x2 = (tile == numTiles - 1) ? x2 : (x1 + tileW * (tile + 1));
-	scissor.y1 = y1;
-	scissor.y2 = y2;
 	return scissor;
 }
 
@@ -370,7 +364,7 @@ int DepthRasterClipIndexedRectangles(int *tx, int *ty, float *tz, const float *t
 	return outCount;
 }
 
-int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *transformed, const uint16_t *indexBuffer, const DepthDraw &draw, const DepthScissor scissor) {
+int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *transformed, const uint16_t *indexBuffer, const DepthDraw &draw, const DepthScissor scissor, DepthRasterStats *stats) {
 	int outCount = 0;
 
 	int flipCull = 0;
@@ -518,7 +512,7 @@ int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *tr
 		// Still good for backface culling early and pretty cheap to compute.
 		Vec4F32 doubleTriArea = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0) - Vec4F32::Splat((float)(MIN_TWICE_TRI_AREA));
 		if (!AnyZeroSignBit(doubleTriArea)) {
-			gpuStats.perFrame.numDepthRasterEarlySize += 4;
+			stats->earlySize += 4;
 			continue;
 		}
 
@@ -560,13 +554,13 @@ int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *tr
 		}
 	}
 
-	gpuStats.perFrame.numDepthRasterZCulled += planeCulled;
-	gpuStats.perFrame.numDepthEarlyBoxCulled += boxCulled;
+	stats->zCulled += planeCulled;
+	stats->boxCulled += boxCulled;
 	return outCount;
 }
 
 // Rasterizes screen-space vertices.
-void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, const int *ty, const float *tz, int count, const DepthDraw &draw, const DepthScissor scissor, bool lowQ) {
+void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, const int *ty, const float *tz, int count, const DepthDraw &draw, const DepthScissor scissor, bool lowQ, DepthRasterStats *stats) {
 	// Prim should now be either TRIANGLES or RECTs.
 	_dbg_assert_(draw.prim == GE_PRIM_RECTANGLES || draw.prim == GE_PRIM_TRIANGLES);
 
@@ -578,32 +572,32 @@ void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, con
 			// We remove the subpixel information here.
 			DepthRasterRect(depth, depthStride, scissor, tx[i], ty[i], tx[i + 1], ty[i + 1], z, draw.compareMode);
 		}
-		gpuStats.perFrame.numDepthRasterPrims += count / 2;
+		stats->prims += count / 2;
 		break;
 	case GE_PRIM_TRIANGLES:
 	{
-		int stats[3]{};
+		int triStats[3]{};
 		// Batches of 4 triangles, as output by the clip function.
 		if (lowQ) {
 			switch (draw.compareMode) {
 			case ZCompareMode::Greater:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Greater, true>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Greater, true>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
 			case ZCompareMode::Less:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Less, true>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Less, true>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
 			case ZCompareMode::Always:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Always, true>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Always, true>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
@@ -613,29 +607,29 @@ void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, con
 			case ZCompareMode::Greater:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Greater, false>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Greater, false>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
 			case ZCompareMode::Less:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Less, false>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Less, false>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
 			case ZCompareMode::Always:
 			{
 				for (int i = 0; i < count; i += 12) {
-					DepthRaster4Triangles<ZCompareMode::Always, false>(stats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
+					DepthRaster4Triangles<ZCompareMode::Always, false>(triStats, depth, depthStride, scissor, &tx[i], &ty[i], &tz[i]);
 				}
 				break;
 			}
 			}
 		}
-		gpuStats.perFrame.numDepthRasterNoPixels += stats[(int)TriangleStat::NoPixels];
-		gpuStats.perFrame.numDepthRasterTooSmall += stats[(int)TriangleStat::SmallOrBackface];
-		gpuStats.perFrame.numDepthRasterPrims += stats[(int)TriangleStat::OK];
+		stats->noPixels += triStats[(int)TriangleStat::NoPixels];
+		stats->tooSmall += triStats[(int)TriangleStat::SmallOrBackface];
+		stats->prims += triStats[(int)TriangleStat::OK];
 		break;
 	}
 	default:
@@ -27,7 +27,21 @@ struct DepthScissor {
 	u16 x2;
 	u16 y2;
 
-	DepthScissor Tile(int tile, int numTiles) const;
+	// Intersects with the pixel columns [left, right).
+	DepthScissor Tile(int left, int right) const;
+};
+
+// Counters for one tile of depth rasterization. Tiles are rasterized on worker threads,
+// so these get added to gpuStats on the GPU thread once the tiles are done.
+struct DepthRasterStats {
+	int prims;
+	int earlySize;
+	int noPixels;
+	int tooSmall;
+	int zCulled;
+	int boxCulled;
+	double cullTime;
+	double rasterizeTime;
 };
 
 struct DepthDraw {
@@ -51,9 +65,9 @@ struct DepthDraw {
 class VertexDecoder;
 struct TransformedVertex;
 
-int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *transformed, const uint16_t *indexBuffer, const DepthDraw &draw, const DepthScissor scissor);
+int DepthRasterClipIndexedTriangles(int *tx, int *ty, float *tz, const float *transformed, const uint16_t *indexBuffer, const DepthDraw &draw, const DepthScissor scissor, DepthRasterStats *stats);
 int DepthRasterClipIndexedRectangles(int *tx, int *ty, float *tz, const float *transformed, const uint16_t *indexBuffer, const DepthDraw &draw, const DepthScissor scissor);
 void DecodeAndTransformForDepthRaster(float *dest, const float *worldviewproj, const void *vertexData, int indexLowerBound, int indexUpperBound, const VertexDecoder *dec, u32 vertTypeID);
 void TransformPredecodedForDepthRaster(float *dest, const float *worldviewproj, const void *decodedVertexData, const VertexDecoder *dec, int count);
 void ConvertPredecodedThroughForDepthRaster(float *dest, const void *decodedVertexData, const VertexDecoder *dec, int count);
-void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, const int *ty, const float *tz, int count, const DepthDraw &draw, const DepthScissor scissor, bool lowQ);
+void DepthRasterScreenVerts(uint16_t *depth, int depthStride, const int *tx, const int *ty, const float *tz, int count, const DepthDraw &draw, const DepthScissor scissor, bool lowQ, DepthRasterStats *stats);
@@ -21,6 +21,7 @@
 
 #include "Common/Data/Convert/ColorConv.h"
 #include "Common/Profiler/Profiler.h"
+#include "Common/Thread/ParallelLoop.h"
 #include "Common/LogReporting.h"
 #include "Common/Math/SIMDHeaders.h"
 #include "Common/Math/CrossSIMD.h"
@@ -28,6 +29,7 @@
 #include "Common/TimeUtil.h"
 #include "Core/System.h"
 #include "Core/Config.h"
+#include "Core/MemMap.h"
 #include "GPU/GPUCommon.h"
 #include "GPU/Common/DrawEngineCommon.h"
 #include "GPU/GPUStateSIMDUtil.h"
@@ -43,7 +45,14 @@ enum {
 	TRANSFORMED_VERTEX_BUFFER_SIZE = VERTEX_BUFFER_MAX * sizeof(TransformedVertex),
 };
 
-DrawEngineCommon::DrawEngineCommon() : decoderMap_(32) {
+// Smaller draws aren't worth the lookup.
+static const int VERTEX_CACHE_MIN_VERTS = 32;
+static const size_t VERTEX_CACHE_MAX_BYTES = 16 * 1024 * 1024;
+static const int VERTEX_CACHE_KILL_AGE = 120;
+// After this many changes, we assume it's dynamic and stop caching it.
+static const int VERTEX_CACHE_MAX_CHANGES = 4;
+
+DrawEngineCommon::DrawEngineCommon() : decoderMap_(32), vertexCache_(256) {
 	if (g_Config.bVertexDecoderJit && (g_Config.iCpuCore == (int)CPUCore::JIT || g_Config.iCpuCore == (int)CPUCore::JIT_IR)) {
 		decJitCache_ = new VertexDecoderJitCache();
 	}
@@ -66,6 +75,7 @@ DrawEngineCommon::~DrawEngineCommon() {
 	decoderMap_.Iterate([&](const uint32_t vtype, VertexDecoder *decoder) {
 		delete decoder;
 	});
+	ClearVertexCache();
 	ClearSplineBezierWeights();
 }
 
@@ -110,6 +120,10 @@ void DrawEngineCommon::NotifyConfigChanged() {
 
 	useHWTransform_ = g_Config.bHardwareTransform;
 	useHWTessellation_ = UpdateUseHWTessellation(g_Config.bHardwareTessellation);
+
+	// Invalidation is only hooked up for the hardware backends.
+	ClearVertexCache();
+	useVertexCache_ = g_Config.bVertexDecodeCache && !g_Config.bSoftwareRendering;
 }
 
 void DrawEngineCommon::DispatchSubmitImm(GEPrimitiveType prim, TransformedVertex *buffer, int vertexCount, int cullMode, bool continuation) {
@@ -800,6 +814,9 @@ bool DrawEngineCommon::SubmitPrim(const void *verts, const void *inds, GEPrimiti
 
 void DrawEngineCommon::BeginFrame() {
 	applySkinInDecode_ = g_Config.bSoftwareSkinning;
+	if (useVertexCache_) {
+		DecimateVertexCache();
+	}
 }
 
 void DrawEngineCommon::DecodeVerts(const VertexDecoder *dec, u8 *dest) {
@@ -825,13 +842,122 @@ void DrawEngineCommon::DecodeVerts(const VertexDecoder *dec, u8 *dest) {
 
 		// Decode the verts (and at the same time apply morphing/skinning). Simple.
 		const u8 *startPos = (const u8 *)dv.verts + indexLowerBound * dec->VertexSize();
-		dec->DecodeVerts(dest + numDecodedVerts * stride, startPos, &dv.uvScale, count);
+		u8 *out = dest + numDecodedVerts * stride;
+		if (!useVertexCache_ || count < VERTEX_CACHE_MIN_VERTS || !DecodeVertsCached(dec, out, startPos, dv.uvScale, count)) {
+			dec->DecodeVerts(out, startPos, &dv.uvScale, count);
+		}
 		numDecodedVerts += count;
 	}
 	numDecodedVerts_ = numDecodedVerts;
 	decodeVertsCounter_ = i;
 }
 
+// Returns false if the caller should just decode normally.
+bool DrawEngineCommon::DecodeVertsCached(const VertexDecoder *dec, u8 *dest, const u8 *src, const UVScale &uvScale, int count) {
+	// Skinning and morphing depend on state outside the vertex data.
+	if (dec->skinInDecode || dec->morphcount > 1) {
+		return false;
+	}
+
+	VertsCacheKey key{};
+	key.addr = Memory::GetAddressFromHostPointerUnchecked(src) & 0x3FFFFFFF;
+	key.vertTypeID = dec->VertexType();
+	key.count = count;
+	key.uvScale = uvScale;
+
+	const u32 srcSize = count * dec->VertexSize();
+	const u32 stride = dec->GetDecVtxFmt().stride;
+	const u32 decodedSize = count * stride;
+	const u64 hash = XXH3_64bits(src, srcSize);
+
+	VertsCacheEntry *entry = vertexCache_.GetOrNull(key);
+	if (entry) {
+		entry->lastFrame = gpuStats.totals.numFlips;
+		if (entry->hash == hash && !entry->decoded.empty()) {
+			memcpy(dest, entry->decoded.data(), decodedSize);
+			gpuStats.perFrame.numVertexCacheHits++;
+			return true;
+		}
+
+		gpuStats.perFrame.numVertexCacheMisses++;
+		if (entry->numChanges >= VERTEX_CACHE_MAX_CHANGES) {
+			return false;
+		}
+		if (++entry->numChanges == VERTEX_CACHE_MAX_CHANGES) {
+			// Keeps changing, probably dynamic. Keep the entry around so we remember that.
+			vertexCacheBytes_ -= entry->decoded.size();
+			std::vector<u8>().swap(entry->decoded);
+			return false;
+		}
+	} else {
+		gpuStats.perFrame.numVertexCacheMisses++;
+		if (vertexCacheBytes_ + decodedSize > VERTEX_CACHE_MAX_BYTES) {
+			return false;
+		}
+		entry = new VertsCacheEntry{};
+		entry->lastFrame = gpuStats.totals.numFlips;
+		vertexCache_.Insert(key, entry);
+	}
+
+	// Decode into the cache and copy, since dest may be a GPU buffer that's slow to read back.
+	// The decoder may write up to a vertex plus 16 bytes past the end.
+	vertexCacheBytes_ -= entry->decoded.size();
+	entry->decoded.resize(decodedSize + stride + 16);
+	vertexCacheBytes_ += entry->decoded.size();
+	dec->DecodeVerts(entry->decoded.data(), src, &uvScale, count);
+	memcpy(dest, entry->decoded.data(), decodedSize);
+	entry->hash = hash;
+	entry->srcSize = srcSize;
+	return true;
+}
+
+void DrawEngineCommon::InvalidateVertexCache(u32 addr, int size, GPUInvalidationType type) {
+	// Entries are always verified by hash, so this is mainly to free memory early.
+	// Games often invalidate all memory every frame, so ignore that.
+	if (vertexCache_.size() == 0 || type == GPU_INVALIDATE_ALL || size <= 0) {
+		return;
+	}
+
+	addr &= 0x3FFFFFFF;
+	std::vector<VertsCacheKey> toRemove;
+	vertexCache_.Iterate([&](const VertsCacheKey &key, VertsCacheEntry *entry) {
+		if (key.addr < addr + (u32)size && addr < key.addr + entry->srcSize) {
+			toRemove.push_back(key);
+		}
+	});
+	for (const VertsCacheKey &key : toRemove) {
+		VertsCacheEntry *entry = vertexCache_.GetOrNull(key);
+		vertexCacheBytes_ -= entry->decoded.size();
+		delete entry;
+		vertexCache_.Remove(key);
+	}
+	vertexCache_.Maintain();
+}
+
+void DrawEngineCommon::DecimateVertexCache() {
+	std::vector<VertsCacheKey> toRemove;
+	vertexCache_.Iterate([&](const VertsCacheKey &key, VertsCacheEntry *entry) {
+		if (entry->lastFrame + VERTEX_CACHE_KILL_AGE < gpuStats.totals.numFlips) {
+			toRemove.push_back(key);
+		}
+	});
+	for (const VertsCacheKey &key : toRemove) {
+		VertsCacheEntry *entry = vertexCache_.GetOrNull(key);
+		vertexCacheBytes_ -= entry->decoded.size();
+		delete entry;
+		vertexCache_.Remove(key);
+	}
+	vertexCache_.Maintain();
+}
+
+void DrawEngineCommon::ClearVertexCache() {
+	vertexCache_.Iterate([&](const VertsCacheKey &key, VertsCacheEntry *entry) {
+		delete entry;
+	});
+	vertexCache_.Clear();
+	vertexCacheBytes_ = 0;
+}
+
 int DrawEngineCommon::DecodeInds() {
 	// Note that this should be able to continue a partial decode - we don't necessarily start from zero here (although we do most of the time).
 
@@ -935,6 +1061,8 @@ enum {
 	DEPTH_SCREENVERTS_COMPONENT_BYTES = DEPTH_SCREENVERTS_COMPONENT_COUNT * sizeof(int) + 384,
 	DEPTH_SCREENVERTS_TOTAL_BYTES = DEPTH_SCREENVERTS_COMPONENT_BYTES * 3,
 	DEPTH_INDEXBUFFER_BYTES = DEPTH_TRANSFORMED_MAX_VERTS * 3 * sizeof(uint16_t),  // hmmm
+	// Each tile clips into its own set of screen vertices.
+	MAX_DEPTH_RASTER_TILES = 4,
 };
 
 // We process vertices for depth rendering in several stages:
@@ -943,6 +1071,8 @@ enum {
 // depthScreenVerts_, with x, y and z separated into different part of the array.
 // (Alternatively, if drawing rectangles, they're just added linearly).
 // After that, we send these groups out for SIMD setup and rasterization.
+// The last two stages run on worker threads, one vertical tile each, while we queue up the next
+// batch. We only wait for them when the result might be observed (sync, block transfer, etc.)
 void DrawEngineCommon::InitDepthRaster() {
 	switch ((DepthRasterMode)g_Config.iDepthRasterMode) {
 	case DepthRasterMode::DEFAULT:
@@ -957,23 +1087,36 @@ void DrawEngineCommon::InitDepthRaster() {
 	}
 
 	if (useDepthRaster_) {
+		depthRasterTiles_ = std::clamp(g_threadManager.GetNumLooperThreads(), 1, (int)MAX_DEPTH_RASTER_TILES);
 		depthDraws_.reserve(256);
+		depthDrawsInFlight_.reserve(256);
+		depthTileStats_.resize(depthRasterTiles_);
+		depthTileEdges_.resize(depthRasterTiles_ + 1);
 		depthTransformed_ = (float *)AllocateMemoryPages(DEPTH_TRANSFORMED_BYTES, MEM_PROT_READ | MEM_PROT_WRITE);
-		depthScreenVerts_ = (int *)AllocateMemoryPages(DEPTH_SCREENVERTS_TOTAL_BYTES, MEM_PROT_READ | MEM_PROT_WRITE);
+		depthTransformedInFlight_ = (float *)AllocateMemoryPages(DEPTH_TRANSFORMED_BYTES, MEM_PROT_READ | MEM_PROT_WRITE);
+		depthScreenVerts_ = (int *)AllocateMemoryPages(DEPTH_SCREENVERTS_TOTAL_BYTES * depthRasterTiles_, MEM_PROT_READ | MEM_PROT_WRITE);
 		depthIndices_ = (uint16_t *)AllocateMemoryPages(DEPTH_INDEXBUFFER_BYTES, MEM_PROT_READ | MEM_PROT_WRITE);
+		depthIndicesInFlight_ = (uint16_t *)AllocateMemoryPages(DEPTH_INDEXBUFFER_BYTES, MEM_PROT_READ | MEM_PROT_WRITE);
 	}
 }
 
 void DrawEngineCommon::ShutdownDepthRaster() {
+	WaitForDepthRaster();
 	if (depthTransformed_) {
 		FreeMemoryPages(depthTransformed_, DEPTH_TRANSFORMED_BYTES);
 	}
+	if (depthTransformedInFlight_) {
+		FreeMemoryPages(depthTransformedInFlight_, DEPTH_TRANSFORMED_BYTES);
+	}
 	if (depthScreenVerts_) {
-		FreeMemoryPages(depthScreenVerts_, DEPTH_SCREENVERTS_TOTAL_BYTES);
+		FreeMemoryPages(depthScreenVerts_, DEPTH_SCREENVERTS_TOTAL_BYTES * depthRasterTiles_);
 	}
 	if (depthIndices_) {
 		FreeMemoryPages(depthIndices_, DEPTH_INDEXBUFFER_BYTES);
 	}
+	if (depthIndicesInFlight_) {
+		FreeMemoryPages(depthIndicesInFlight_, DEPTH_INDEXBUFFER_BYTES);
+	}
 }
 
 Mat4F32 ComputeFinalProjMatrix() {
@@ -1040,8 +1183,11 @@ bool DrawEngineCommon::CalculateDepthDraw(DepthDraw *draw, GEPrimitiveType prim,
 	}
 
 	if (depthVertexCount_ + vertexCount >= DEPTH_TRANSFORMED_MAX_VERTS) {
-		// Can't add more. We need to flush.
-		return false;
+		// Can't add more. Send off what we have and start a new batch.
+		KickQueuedDepth();
+		if (vertexCount >= DEPTH_TRANSFORMED_MAX_VERTS) {
+			return false;
+		}
 	}
 
 	draw->depthAddr = gstate.getDepthBufRawAddress() | 0x04000000;
@@ -1152,33 +1298,113 @@ void DrawEngineCommon::DepthRasterPredecoded(GEPrimitiveType prim, const void *i
 }
 
 void DrawEngineCommon::FlushQueuedDepth() {
+	KickQueuedDepth();
+	WaitForDepthRaster();
+}
+
+void DrawEngineCommon::KickQueuedDepth() {
 	if (rasterTimeStart_ != 0.0) {
 		gpuStats.perFrame.msRasterTimeAvailable += time_now_d() - rasterTimeStart_;
 		rasterTimeStart_ = 0.0;
 	}
 
-	const bool collectStats = coreCollectDebugStats;
-	const bool lowQ = g_Config.iDepthRasterMode == (int)DepthRasterMode::LOW_QUALITY;
-	for (const auto &draw : depthDraws_) {
-		int *tx = depthScreenVerts_;
-		int *ty = depthScreenVerts_ + DEPTH_SCREENVERTS_COMPONENT_COUNT;
-		float *tz = (float *)(depthScreenVerts_ + DEPTH_SCREENVERTS_COMPONENT_COUNT * 2);
+	if (depthDraws_.empty()) {
+		return;
+	}
 
-		int outVertCount = 0;
+	// The previous batch owns the in-flight buffers, and must also finish first to keep draws in order.
+	WaitForDepthRaster();
 
-		const float *vertices = depthTransformed_ + 4 * draw.vertexOffset;
-		const uint16_t *indices = depthIndices_ + draw.indexOffset;
+	std::swap(depthTransformed_, depthTransformedInFlight_);
+	std::swap(depthIndices_, depthIndicesInFlight_);
+	std::swap(depthDraws_, depthDrawsInFlight_);
 
-		DepthScissor tileScissor = draw.scissor.Tile(0, 1);
+	// Reset queue
+	depthIndexCount_ = 0;
+	depthVertexCount_ = 0;
+	depthDraws_.clear();
+
+	// Split the batch into vertical slices of the widest depth buffer in it. The triangle rasterizer
+	// reads and writes whole groups of four pixels, so the inner edges are aligned to four pixels
+	// to keep tiles from sharing a group. The outer edges take everything the scissors can reach.
+	int width = 0;
+	for (const DepthDraw &draw : depthDrawsInFlight_) {
+		width = std::max(width, (int)draw.depthStride);
+	}
+	depthTileEdges_[0] = 0;
+	for (int tile = 1; tile < depthRasterTiles_; tile++) {
+		depthTileEdges_[tile] = (width * tile / depthRasterTiles_) & ~3;
+	}
+	depthTileEdges_[depthRasterTiles_] = 0x10000;
+
+	// These are read on the worker threads, so snapshot them.
+	depthRasterCollectStats_ = coreCollectDebugStats;
+	depthRasterLowQ_ = g_Config.iDepthRasterMode == (int)DepthRasterMode::LOW_QUALITY;
+
+	if (!g_threadManager.IsInitialized()) {
+		for (int tile = 0; tile < depthRasterTiles_; tile++) {
+			RasterizeDepthTile(tile);
+		}
+		return;
+	}
+
+	depthRasterWaitable_ = ParallelRangeLoopWaitable(&g_threadManager, [this](int lower, int upper) {
+		for (int tile = lower; tile < upper; tile++) {
+			RasterizeDepthTile(tile);
+		}
+	}, 0, depthRasterTiles_, 1, TaskPriority::HIGH);
+}
+
+void DrawEngineCommon::WaitForDepthRaster() {
+	if (depthRasterWaitable_) {
+		TimeCollector collectStat(&gpuStats.perFrame.msWaitDepth, coreCollectDebugStats);
+		depthRasterWaitable_->WaitAndRelease();
+		depthRasterWaitable_ = nullptr;
+	}
+
+	for (DepthRasterStats &stats : depthTileStats_) {
+		gpuStats.perFrame.msCullDepth += stats.cullTime;
+		gpuStats.perFrame.msRasterizeDepth += stats.rasterizeTime;
+		gpuStats.perFrame.numDepthRasterPrims += stats.prims;
+		gpuStats.perFrame.numDepthRasterEarlySize += stats.earlySize;
+		gpuStats.perFrame.numDepthRasterNoPixels += stats.noPixels;
+		gpuStats.perFrame.numDepthRasterTooSmall += stats.tooSmall;
+		gpuStats.perFrame.numDepthRasterZCulled += stats.zCulled;
+		gpuStats.perFrame.numDepthEarlyBoxCulled += stats.boxCulled;
+		stats = {};
+	}
+	depthDrawsInFlight_.clear();
+}
+
+// Runs on a worker thread. Tiles are fixed columns that don't overlap, so each one can run through
+// all the draws in order.
+void DrawEngineCommon::RasterizeDepthTile(int tile) {
+	DepthRasterStats *stats = &depthTileStats_[tile];
+	const bool collectStats = depthRasterCollectStats_;
+
+	int *tx = depthScreenVerts_ + tile * (DEPTH_SCREENVERTS_TOTAL_BYTES / sizeof(int));
+	int *ty = tx + DEPTH_SCREENVERTS_COMPONENT_COUNT;
+	float *tz = (float *)(tx + DEPTH_SCREENVERTS_COMPONENT_COUNT * 2);
+
+	for (const auto &draw : depthDrawsInFlight_) {
+		const DepthScissor tileScissor = draw.scissor.Tile(depthTileEdges_[tile], depthTileEdges_[tile + 1]);
+		if (tileScissor.x2 < tileScissor.x1) {
+			continue;
+		}
+
+		int outVertCount = 0;
+
+		const float *vertices = depthTransformedInFlight_ + 4 * draw.vertexOffset;
+		const uint16_t *indices = depthIndicesInFlight_ + draw.indexOffset;
 
 		{
-			TimeCollector collectStat(&gpuStats.perFrame.msCullDepth, collectStats);
+			TimeCollector collectStat(&stats->cullTime, collectStats);
 			switch (draw.prim) {
 			case GE_PRIM_RECTANGLES:
 				outVertCount = DepthRasterClipIndexedRectangles(tx, ty, tz, vertices, indices, draw, tileScissor);
 				break;
 			case GE_PRIM_TRIANGLES:
-				outVertCount = DepthRasterClipIndexedTriangles(tx, ty, tz, vertices, indices, draw, tileScissor);
+				outVertCount = DepthRasterClipIndexedTriangles(tx, ty, tz, vertices, indices, draw, tileScissor, stats);
 				break;
 			default:
 				_dbg_assert_(false);
@@ -1186,17 +1412,12 @@ void DrawEngineCommon::FlushQueuedDepth() {
 			}
 		}
 		if (outVertCount > 0) {
-			TimeCollector collectStat(&gpuStats.perFrame.msRasterizeDepth, collectStats);
+			TimeCollector collectStat(&stats->rasterizeTime, collectStats);
 			if (!Memory::IsValid4AlignedAddress(draw.depthAddr)) {
 				continue;
 			}
 			u16 *depthPtr = (uint16_t *)Memory::GetPointerWriteUnchecked(draw.depthAddr);
-			DepthRasterScreenVerts(depthPtr, draw.depthStride, tx, ty, tz, outVertCount, draw, tileScissor, lowQ);
+			DepthRasterScreenVerts(depthPtr, draw.depthStride, tx, ty, tz, outVertCount, draw, tileScissor, depthRasterLowQ_, stats);
 		}
 	}
-
-	// Reset queue
-	depthIndexCount_ = 0;
-	depthVertexCount_ = 0;
-	depthDraws_.clear();
 }
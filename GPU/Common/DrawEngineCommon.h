@@ -33,6 +33,8 @@
 
 class VertexDecoder;
 struct DepthDraw;
+struct DepthRasterStats;
+struct WaitableCounter;
 
 enum {
 	VERTEX_BUFFER_MAX = 65536,
@@ -171,7 +173,16 @@ class DrawEngineCommon {
 		return decoded_ + 12 * 65536;
 	}
 
+	// Rasterizes all queued depth draws, and waits until they're in memory.
 	void FlushQueuedDepth();
+	// Starts rasterizing the queued depth draws on worker threads, without waiting.
+	void KickQueuedDepth();
+
+	// Drops cached decoded vertices overlapping the range.
+	void InvalidateVertexCache(u32 addr, int size, GPUInvalidationType type);
+	int VertexCacheSize() const {
+		return (int)vertexCache_.size();
+	}
 
 protected:
 	virtual bool UpdateUseHWTessellation(bool enabled) const { return enabled; }
@@ -179,6 +190,9 @@ class DrawEngineCommon {
 	bool CheckClipFlags(bool useHwTransform) const;
 
 	void DecodeVerts(const VertexDecoder *dec, u8 *dest);
+	bool DecodeVertsCached(const VertexDecoder *dec, u8 *dest, const u8 *src, const UVScale &uvScale, int count);
+	void DecimateVertexCache();
+	void ClearVertexCache();
 	int DecodeInds();
 
 	int ComputeNumVertsToDecode() const;
@@ -190,6 +204,8 @@ class DrawEngineCommon {
 	void DepthRasterSubmitRaw(GEPrimitiveType prim, const VertexDecoder *dec, uint32_t vertTypeID, int vertexCount);
 	void DepthRasterPredecoded(GEPrimitiveType prim, const void *inVerts, int numDecoded, const VertexDecoder *dec, int vertexCount);
 	bool CalculateDepthDraw(DepthDraw *draw, GEPrimitiveType prim, int vertexCount);
+	void RasterizeDepthTile(int tile);
+	void WaitForDepthRaster();
 
 	static inline int IndexSize(u32 vtype) {
 		const u32 indexType = (vtype & GE_VTYPE_IDX_MASK);
@@ -300,6 +316,24 @@ class DrawEngineCommon {
 	VertexDecoderJitCache *decJitCache_ = nullptr;
 	VertexDecoderOptions decOptions_{};
 
+	// Optional cache of decoded vertices, for static geometry that's drawn every frame.
+	struct VertsCacheKey {
+		u32 addr;
+		u32 vertTypeID;
+		u32 count;
+		UVScale uvScale;
+	};
+	struct VertsCacheEntry {
+		std::vector<u8> decoded;
+		u64 hash;
+		u32 srcSize;
+		int lastFrame;
+		int numChanges;
+	};
+	DenseHashMap<VertsCacheKey, VertsCacheEntry *> vertexCache_;
+	size_t vertexCacheBytes_ = 0;
+	bool useVertexCache_ = false;
+
 	TransformedVertex *transformed_ = nullptr;
 	TransformedVertex *transformedExpanded_ = nullptr;
 
@@ -368,6 +402,17 @@ class DrawEngineCommon {
 	int *depthScreenVerts_ = nullptr;
 	uint16_t *depthIndices_ = nullptr;
 
+	// The batch currently being rasterized by worker threads, one tile each.
+	float *depthTransformedInFlight_ = nullptr;
+	uint16_t *depthIndicesInFlight_ = nullptr;
+	std::vector<DepthDraw> depthDrawsInFlight_;
+	std::vector<DepthRasterStats> depthTileStats_;
+	std::vector<int> depthTileEdges_;  // Column boundaries of the tiles, the same for all draws in a batch.
+	WaitableCounter *depthRasterWaitable_ = nullptr;
+	int depthRasterTiles_ = 1;
+	bool depthRasterLowQ_ = false;
+	bool depthRasterCollectStats_ = false;
+
 	// Depth tracking
 	ClipInfoFlags clipInfoFlags_{};
 	ClipInfoFlags lastClipInfoFlags_{};  // Flags at the last flush. For dirtying.
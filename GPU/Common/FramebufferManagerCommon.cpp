@@ -1089,6 +1089,8 @@ void FramebufferManagerCommon::NotifyRenderFramebufferSwitched(VirtualFramebuffe
 		}
 	}
 
+	UpdateSpeculativeReadbacks(prevVfb, vfb);
+
 	textureCache_->ForgetLastTexture();
 	shaderManager_->DirtyLastShader();
 
@@ -1745,6 +1747,14 @@ void FramebufferManagerCommon::DecimateFBOs() {
 
 	const bool persistentFramebuffers = PSP_CoreParameter().compat.flags().PersistentFramebuffers;
 
+	for (auto iter = cpuReadbackHistory_.begin(); iter != cpuReadbackHistory_.end(); ) {
+		if (iter->second.lastFrame < gpuStats.totals.numFlips - CPU_READBACK_HISTORY_MAX_AGE) {
+			iter = cpuReadbackHistory_.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
 	for (size_t i = 0; i < vfbs_.size(); ++i) {
 		VirtualFramebuffer *vfb = vfbs_[i];
 		int age = frameLastFramebufUsed_ - std::max(vfb->last_frame_render, vfb->last_frame_used);
@@ -2212,7 +2222,10 @@ bool FramebufferManagerCommon::NotifyFramebufferCopy(u32 src, u32 dst, int size,
 		if (srcH == 0 || srcY + srcH > srcBuffer->bufferHeight) {
 			WARN_LOG_ONCE(btdcpyheight, Log::FrameBuf, "Memcpy fbo download %08x -> %08x skipped, %d+%d is taller than %d", src, dst, srcY, srcH, srcBuffer->bufferHeight);
 		} else if (GetSkipGPUReadbackMode() == SkipGPUReadbackMode::NO_SKIP && (!srcBuffer->memoryUpdated || channel == RASTER_DEPTH)) {
-			ReadFramebufferToMemory(srcBuffer, 0, srcY, srcBuffer->width, srcH, channel, Draw::ReadbackMode::BLOCK);
+			Draw::ReadbackMode mode = Draw::ReadbackMode::BLOCK;
+			if (channel == RASTER_DEPTH || PrepareCPUReadback(srcBuffer, 0, srcY, srcBuffer->width, srcH, &mode)) {
+				ReadFramebufferToMemory(srcBuffer, 0, srcY, srcBuffer->width, srcH, channel, mode);
+			}
 			srcBuffer->usageFlags = (srcBuffer->usageFlags | FB_USAGE_DOWNLOAD) & ~FB_USAGE_DOWNLOAD_CLEAR;
 		}
 		return false;
@@ -2810,7 +2823,12 @@ bool FramebufferManagerCommon::NotifyBlockTransferBefore(u32 dstBasePtr, int dst
 				if (tooTall) {
 					WARN_LOG_ONCE(btdheight, Log::G3D, "Block transfer download %08x -> %08x dangerous, %d+%d is taller than %d", srcBasePtr, dstBasePtr, srcRect.y, srcRect.h, srcRect.vfb->bufferHeight);
 				}
-				ReadFramebufferToMemory(srcRect.vfb, static_cast<int>(srcX * srcXFactor), srcY, static_cast<int>(srcRect.w_bytes * srcXFactor), srcRect.h, RASTER_COLOR, Draw::ReadbackMode::BLOCK);
+				const int readX = static_cast<int>(srcX * srcXFactor);
+				const int readW = static_cast<int>(srcRect.w_bytes * srcXFactor);
+				Draw::ReadbackMode mode;
+				if (PrepareCPUReadback(srcRect.vfb, readX, srcY, readW, srcRect.h, &mode)) {
+					ReadFramebufferToMemory(srcRect.vfb, readX, srcY, readW, srcRect.h, RASTER_COLOR, mode);
+				}
 				srcRect.vfb->usageFlags = (srcRect.vfb->usageFlags | FB_USAGE_DOWNLOAD) & ~FB_USAGE_DOWNLOAD_CLEAR;
 			}
 		}
@@ -3322,6 +3340,70 @@ void FramebufferManagerCommon::FlushBeforeCopy() {
 	}
 }
 
+bool FramebufferManagerCommon::PrepareCPUReadback(VirtualFramebuffer *vfb, int x, int y, int w, int h, Draw::ReadbackMode *mode) {
+	*mode = Draw::ReadbackMode::BLOCK;
+	if (!g_Config.bAsyncReadback || !draw_->GetDeviceCaps().asyncReadbackSupported) {
+		return true;
+	}
+
+	const int frame = gpuStats.totals.numFlips;
+	auto iter = cpuReadbackHistory_.find(vfb->fb_address);
+	if (iter == cpuReadbackHistory_.end()) {
+		cpuReadbackHistory_[vfb->fb_address] = CPUReadbackHistory{ frame, 1, -1, x, y, w, h };
+		return true;
+	}
+
+	CPUReadbackHistory &history = iter->second;
+	const bool sameRect = history.x == x && history.y == y && history.w == w && history.h == h;
+	if (history.lastFrame != frame) {
+		history.streak = sameRect && history.lastFrame == frame - 1 ? history.streak + 1 : 1;
+		history.lastFrame = frame;
+	} else if (!sameRect) {
+		// Several different areas per frame, like line by line copies. Can't predict those.
+		history.streak = 0;
+	}
+	history.x = x;
+	history.y = y;
+	history.w = w;
+	history.h = h;
+
+	if (history.streak < CPU_READBACK_CONFIRM_FRAMES) {
+		return true;
+	}
+	if (history.speculativeFrame == frame) {
+		// Already read back when the game was done rendering to it.
+		return false;
+	}
+	// The backend keeps these per framebuffer and size, and returns the data from a previous frame.
+	*mode = Draw::ReadbackMode::OLD_DATA_OK;
+	return true;
+}
+
+void FramebufferManagerCommon::UpdateSpeculativeReadbacks(VirtualFramebuffer *prevVfb, VirtualFramebuffer *vfb) {
+	if (cpuReadbackHistory_.empty()) {
+		return;
+	}
+
+	const int frame = gpuStats.totals.numFlips;
+	if (prevVfb && GetSkipGPUReadbackMode() == SkipGPUReadbackMode::NO_SKIP) {
+		auto iter = cpuReadbackHistory_.find(prevVfb->fb_address);
+		if (iter != cpuReadbackHistory_.end()) {
+			CPUReadbackHistory &history = iter->second;
+			// Only for steady readers, which also read it last frame.
+			if (history.streak >= CPU_READBACK_CONFIRM_FRAMES && history.lastFrame >= frame - 1 && history.speculativeFrame != frame) {
+				history.speculativeFrame = frame;
+				ReadFramebufferToMemory(prevVfb, history.x, history.y, history.w, history.h, RASTER_COLOR, Draw::ReadbackMode::OLD_DATA_OK);
+			}
+		}
+	}
+
+	// If we render to it again, the early readback is no longer the final result.
+	auto iter = cpuReadbackHistory_.find(vfb->fb_address);
+	if (iter != cpuReadbackHistory_.end()) {
+		iter->second.speculativeFrame = -1;
+	}
+}
+
 // TODO: Replace with with depal, reading the palette from the texture on the GPU directly.
 void FramebufferManagerCommon::DownloadFramebufferForClut(u32 fb_address, u32 loadBytes) {
 	VirtualFramebuffer *vfb = GetVFBAt(fb_address);
@@ -3353,7 +3435,10 @@ void FramebufferManagerCommon::DownloadFramebufferForClut(u32 fb_address, u32 lo
 			vfb->clutUpdatedBytes = loadBytes;
 
 			// This function now handles scaling down internally.
-			ReadbackFramebuffer(vfb, x, y, w, h, RASTER_COLOR, Draw::ReadbackMode::BLOCK);
+			Draw::ReadbackMode mode;
+			if (PrepareCPUReadback(vfb, x, y, w, h, &mode)) {
+				ReadbackFramebuffer(vfb, x, y, w, h, RASTER_COLOR, mode);
+			}
 
 			textureCache_->ForgetLastTexture();
 			RebindFramebuffer("RebindFramebuffer - DownloadFramebufferForClut");
@@ -529,6 +529,12 @@ class FramebufferManagerCommon {
 	void FlushBeforeCopy();
 	virtual void DecimateFBOs();  // keeping it virtual to let D3D do a little extra
 
+	// Records a CPU read of a framebuffer's colors, and picks the readback mode. Returns false if the
+	// data was already read back ahead of time this frame.
+	bool PrepareCPUReadback(VirtualFramebuffer *vfb, int x, int y, int w, int h, Draw::ReadbackMode *mode);
+	// Reads back framebuffers the CPU reads every frame as soon as we're done rendering to them.
+	void UpdateSpeculativeReadbacks(VirtualFramebuffer *prevVfb, VirtualFramebuffer *vfb);
+
 	// Used by ReadFramebufferToMemory and later framebuffer block copies
 	void BlitFramebuffer(VirtualFramebuffer *dst, int dstX, int dstY, VirtualFramebuffer *src, int srcX, int srcY, int w, int h, int bpp, RasterChannel channel, const char *tag);
 
@@ -614,6 +620,17 @@ class FramebufferManagerCommon {
 
 	bool gameUsesSequentialCopies_ = false;
 
+	// Tracks which framebuffers the CPU reads back, keyed by color address.
+	// Once the same area has been read for a few frames in a row, it's read back with old data
+	// instead of stalling, see PrepareCPUReadback.
+	struct CPUReadbackHistory {
+		int lastFrame;
+		int streak;
+		int speculativeFrame;
+		int x, y, w, h;
+	};
+	std::unordered_map<u32, CPUReadbackHistory> cpuReadbackHistory_;
+
 	// Sampled in BeginFrame/UpdateSize for safety.
 	float renderWidth_ = 0.0f;
 	float renderHeight_ = 0.0f;
@@ -642,6 +659,12 @@ class FramebufferManagerCommon {
 		FBO_OLD_USAGE_FLAG = 15,
 	};
 
+	// A CPU read has to repeat for this many frames in a row before we expect it to keep happening.
+	enum {
+		CPU_READBACK_CONFIRM_FRAMES = 3,
+		CPU_READBACK_HISTORY_MAX_AGE = 60,
+	};
+
 	// Thin3D stuff for reinterpreting image data between the various 16-bit color formats.
 	// Safe, not optimal - there might be input attachment tricks, etc, but we can't use them
 	// since we don't want N different implementations.
@@ -1,2 +1,159 @@
+#include <utility>
+
+#include "Common/File/FileUtil.h"
+#include "Common/File/Path.h"
 #include "Common/GPU/Shader.h"
+#include "Common/Log.h"
+#include "Common/Thread/ThreadManager.h"
+#include "Common/Thread/Waitable.h"
+#include "Common/TimeUtil.h"
 #include "GPU/Common/ShaderCommon.h"
+#include "GPU/Common/ShaderId.h"
+#include "GPU/GPU.h"
+#include "GPU/GPUState.h"
+
+#define SHADER_ID_CACHE_MAGIC 0x44495348
+// Shares the ID layout with the backend shader caches, so bump this when they're bumped.
+#define SHADER_ID_CACHE_VERSION 1
+
+struct ShaderIDCacheHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t useFlags;
+	int numVertexShaders;
+	int numFragmentShaders;
+};
+
+class ShaderPrewarmTask : public Task {
+public:
+	ShaderPrewarmTask(ShaderManagerCommon *manager, std::vector<VShaderID> &&vsids, std::vector<FShaderID> &&fsids, LimitedWaitable *waitable)
+		: manager_(manager), vsids_(std::move(vsids)), fsids_(std::move(fsids)), waitable_(waitable) {}
+
+	TaskType Type() const override { return TaskType::CPU_COMPUTE; }
+	TaskPriority Priority() const override { return TaskPriority::LOW; }
+
+	void Run() override {
+		manager_->RunPrewarm(vsids_, fsids_);
+		waitable_->Notify();
+	}
+
+private:
+	ShaderManagerCommon *manager_;
+	std::vector<VShaderID> vsids_;
+	std::vector<FShaderID> fsids_;
+	LimitedWaitable *waitable_;
+};
+
+bool ShaderManagerCommon::LoadShaderIDCache(const Path &filename) {
+	File::IOFile f(filename, "rb");
+	if (!f.IsOpen()) {
+		return false;
+	}
+
+	ShaderIDCacheHeader header;
+	if (!f.ReadArray(&header, 1)) {
+		return false;
+	}
+	if (header.magic != SHADER_ID_CACHE_MAGIC || header.version != SHADER_ID_CACHE_VERSION) {
+		return false;
+	}
+	if (header.useFlags != gstate_c.GetUseFlags()) {
+		// Most of these would come out different now, not worth compiling.
+		INFO_LOG(Log::G3D, "Shader use flags changed, ignoring the shader ID cache");
+		return false;
+	}
+	if (header.numVertexShaders < 0 || header.numFragmentShaders < 0 || header.numVertexShaders > 1000 || header.numFragmentShaders > 1000) {
+		ERROR_LOG(Log::G3D, "Corrupt shader ID cache file header, aborting.");
+		return false;
+	}
+	u64 expectedSize = sizeof(header) + header.numVertexShaders * sizeof(VShaderID) + header.numFragmentShaders * sizeof(FShaderID);
+	if (f.GetSize() != expectedSize) {
+		ERROR_LOG(Log::G3D, "Shader ID cache file is wrong size: %lld instead of %lld", (long long)f.GetSize(), (long long)expectedSize);
+		return false;
+	}
+
+	std::vector<VShaderID> vsids(header.numVertexShaders);
+	std::vector<FShaderID> fsids(header.numFragmentShaders);
+	if (!vsids.empty() && !f.ReadArray(vsids.data(), vsids.size())) {
+		return false;
+	}
+	if (!fsids.empty() && !f.ReadArray(fsids.data(), fsids.size())) {
+		return false;
+	}
+
+	StopPrewarm();
+	NOTICE_LOG(Log::G3D, "Prewarming %d vertex and %d fragment shaders from '%s'", (int)vsids.size(), (int)fsids.size(), filename.c_str());
+	prewarmCancelled_ = false;
+	prewarmWaitable_ = new LimitedWaitable();
+	g_threadManager.EnqueueTask(new ShaderPrewarmTask(this, std::move(vsids), std::move(fsids), prewarmWaitable_));
+	return true;
+}
+
+void ShaderManagerCommon::SaveShaderIDCache(const Path &filename) {
+	std::vector<VShaderID> vsids;
+	std::vector<FShaderID> fsids;
+	GetShaderIDsForCache(&vsids, &fsids);
+	if (vsids.empty() && fsids.empty()) {
+		return;
+	}
+
+	INFO_LOG(Log::G3D, "Saving the shader ID cache to '%s'", filename.c_str());
+	FILE *f = File::OpenCFile(filename, "wb");
+	if (!f) {
+		return;
+	}
+	ShaderIDCacheHeader header;
+	header.magic = SHADER_ID_CACHE_MAGIC;
+	header.version = SHADER_ID_CACHE_VERSION;
+	header.useFlags = gstate_c.GetUseFlags();
+	header.numVertexShaders = (int)vsids.size();
+	header.numFragmentShaders = (int)fsids.size();
+	fwrite(&header, 1, sizeof(header), f);
+	fwrite(vsids.data(), sizeof(VShaderID), vsids.size(), f);
+	fwrite(fsids.data(), sizeof(FShaderID), fsids.size(), f);
+	fclose(f);
+}
+
+void ShaderManagerCommon::StopPrewarm() {
+	if (prewarmWaitable_) {
+		prewarmCancelled_ = true;
+		prewarmWaitable_->WaitAndRelease();
+		prewarmWaitable_ = nullptr;
+	}
+}
+
+void ShaderManagerCommon::RunPrewarm(const std::vector<VShaderID> &vsids, const std::vector<FShaderID> &fsids) {
+	double start = time_now_d();
+	int compiled = 0;
+	for (const VShaderID &id : vsids) {
+		if (prewarmCancelled_) {
+			return;
+		}
+		if (id.Bit(VS_BIT_IS_THROUGH) && id.Bit(VS_BIT_USE_HW_TRANSFORM)) {
+			// Clearly corrupt, bailing.
+			ERROR_LOG(Log::G3D, "Corrupt shader ID cache: Both IS_THROUGH and USE_HW_TRANSFORM set.");
+			return;
+		}
+		if (PrewarmVertexShader(id)) {
+			compiled++;
+		}
+	}
+	for (const FShaderID &id : fsids) {
+		if (prewarmCancelled_) {
+			return;
+		}
+		if (PrewarmFragmentShader(id)) {
+			compiled++;
+		}
+	}
+	NOTICE_LOG(Log::G3D, "Prewarm: Compiled %d of %d shaders in %0.1f milliseconds", compiled, (int)(vsids.size() + fsids.size()), 1000.0 * (time_now_d() - start));
+}
+
+void ShaderManagerCommon::CountShaderCompile() {
+	gpuStats.perFrame.numShaderCompiles++;
+	gpuStats.totals.numShaderCompiles++;
+}
+
+void ShaderManagerCommon::CountPrewarmedShaders(int count) {
+	gpuStats.totals.numShadersPrewarmed += count;
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -25,6 +26,11 @@ namespace Draw {
 	class DrawContext;
 }
 
+class LimitedWaitable;
+class Path;
+struct VShaderID;
+struct FShaderID;
+
 enum DebugShaderType {
 	SHADER_TYPE_VERTEX = 0,
 	SHADER_TYPE_FRAGMENT = 1,
@@ -144,8 +150,34 @@ class ShaderManagerCommon {
 	virtual std::vector<std::string> DebugGetShaderIDs(DebugShaderType type) = 0;
 	virtual std::string DebugGetShaderString(std::string id, DebugShaderType type, DebugShaderStringType stringType) = 0;
 
+	// Backend-neutral list of the shader IDs a game has used, for backends that don't have a shader
+	// cache of their own. Loading compiles them on a background task through the Prewarm functions,
+	// so they're ready before the game asks for them.
+	bool LoadShaderIDCache(const Path &filename);
+	void SaveShaderIDCache(const Path &filename);
+
 protected:
+	// These run on the prewarm task, concurrently with the render thread. The backend keeps the results
+	// aside and adopts them into its caches on its own thread.
+	virtual bool PrewarmVertexShader(const VShaderID &id) { return false; }
+	virtual bool PrewarmFragmentShader(const FShaderID &id) { return false; }
+	virtual void GetShaderIDsForCache(std::vector<VShaderID> *vsids, std::vector<FShaderID> *fsids) {}
+
+	// Backends that prewarm must call this before clearing their shaders or losing the device.
+	void StopPrewarm();
+
+	// For the stats overlay. A compile is a shader generated on demand in the middle of a frame.
+	static void CountShaderCompile();
+	static void CountPrewarmedShaders(int count);
+
 	Draw::DrawContext *draw_ = nullptr;
+
+private:
+	friend class ShaderPrewarmTask;
+	void RunPrewarm(const std::vector<VShaderID> &vsids, const std::vector<FShaderID> &fsids);
+
+	LimitedWaitable *prewarmWaitable_ = nullptr;
+	std::atomic<bool> prewarmCancelled_{};
 };
 
 enum DoLightComputation {
@@ -19,6 +19,7 @@
 #include "Common/Common.h"
 #include "Common/CPUDetect.h"
 #include "Common/Profiler/Profiler.h"
+#include "Common/Thread/ParallelLoop.h"
 #include "GPU/Common/SplineCommon.h"
 #include "GPU/Common/DrawEngineCommon.h"
 #include "GPU/Common/SoftwareTransformCommon.h"
@@ -314,6 +315,35 @@ class Tessellator {
 	}
 };
 
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+// Vec3f and Vec4f are backed by a SIMD register, so all components can be combined at once.
+template<typename T>
+static inline T SampleSIMD(const T p[4], const float w[4]) {
+#if defined(_M_SSE)
+	__m128 sum = _mm_mul_ps(SAFE_M128(p[0].vec), _mm_set1_ps(w[0]));
+	sum = _mm_add_ps(sum, _mm_mul_ps(SAFE_M128(p[1].vec), _mm_set1_ps(w[1])));
+	sum = _mm_add_ps(sum, _mm_mul_ps(SAFE_M128(p[2].vec), _mm_set1_ps(w[2])));
+	sum = _mm_add_ps(sum, _mm_mul_ps(SAFE_M128(p[3].vec), _mm_set1_ps(w[3])));
+#else
+	float32x4_t sum = vmulq_n_f32(p[0].vec, w[0]);
+	sum = vmlaq_n_f32(sum, p[1].vec, w[1]);
+	sum = vmlaq_n_f32(sum, p[2].vec, w[2]);
+	sum = vmlaq_n_f32(sum, p[3].vec, w[3]);
+#endif
+	return T(sum);
+}
+
+template<>
+inline Vec3f Tessellator<Vec3f>::Sample(const Vec3f p[4], const float w[4]) {
+	return SampleSIMD(p, w);
+}
+
+template<>
+inline Vec4f Tessellator<Vec4f>::Sample(const Vec4f p[4], const float w[4]) {
+	return SampleSIMD(p, w);
+}
+#endif
+
 ControlPoints::ControlPoints(const SimpleVertex *const *points, int size, SimpleBufferManager &managedBuf) {
 	pos = (Vec3f *)managedBuf.Allocate(sizeof(Vec3f) * size);
 	tex = (Vec2f *)managedBuf.Allocate(sizeof(Vec2f) * size);
@@ -331,75 +361,106 @@ void ControlPoints::Convert(const SimpleVertex *const *points, int size) {
 	defcolor = points[0]->color_32;
 }
 
+// Below this, the threading overhead isn't worth it. Typical game patches are well under.
+enum {
+	MIN_PARALLEL_TESS_VERTS = 4096,
+	MIN_TESS_VERTS_PER_TASK = 1024,
+};
+
 template<class Surface>
 class SubdivisionSurface {
 public:
+	// Tessellates U lines [lower, upper), numbered patch by patch. Lines write disjoint vertices
+	// (splines skip the line shared with the previous patch), so ranges can run in parallel.
 	template <bool sampleNrm, bool sampleCol, bool sampleTex, bool useSSE4, bool patchFacing>
-	static void Tessellate(OutputBuffers &output, const Surface &surface, const ControlPoints &points, const Weight2D &weights) {
+	static void TessellateLines(OutputBuffers &output, const Surface &surface, const ControlPoints &points, const Weight2D &weights, int lower, int upper) {
 		const float inv_u = 1.0f / (float)surface.tess_u;
 		const float inv_v = 1.0f / (float)surface.tess_v;
+		const int linesPerPatch = surface.tess_u + 1;
+
+		int line = lower;
+		while (line < upper) {
+			const int patch = line / linesPerPatch;
+			const int patch_u = patch % surface.num_patches_u;
+			const int patch_v = patch / surface.num_patches_u;
+			const int patchStart = patch * linesPerPatch;
+			const int patchEnd = std::min(upper, patchStart + linesPerPatch);
+
+			const int start_u = std::max(surface.GetTessStart(patch_u), line - patchStart);
+			const int end_u = patchEnd - patchStart;
+			const int start_v = surface.GetTessStart(patch_v);
+			line = patchEnd;
+
+			// Prepare 4x4 control points to tessellate
+			const int idx = surface.GetPointIndex(patch_u, patch_v);
+			const int idx_v[4] = { idx, idx + surface.num_points_u, idx + surface.num_points_u * 2, idx + surface.num_points_u * 3 };
+			Tessellator<Vec3f> tess_pos(points.pos, idx_v);
+			Tessellator<Vec4f> tess_col(points.col, idx_v);
+			Tessellator<Vec2f> tess_tex(points.tex, idx_v);
+			Tessellator<Vec3f> tess_nrm(points.pos, idx_v);
 
-		for (int patch_u = 0; patch_u < surface.num_patches_u; ++patch_u) {
-			const int start_u = surface.GetTessStart(patch_u);
-			for (int patch_v = 0; patch_v < surface.num_patches_v; ++patch_v) {
-				const int start_v = surface.GetTessStart(patch_v);
-
-				// Prepare 4x4 control points to tessellate
-				const int idx = surface.GetPointIndex(patch_u, patch_v);
-				const int idx_v[4] = { idx, idx + surface.num_points_u, idx + surface.num_points_u * 2, idx + surface.num_points_u * 3 };
-				Tessellator<Vec3f> tess_pos(points.pos, idx_v);
-				Tessellator<Vec4f> tess_col(points.col, idx_v);
-				Tessellator<Vec2f> tess_tex(points.tex, idx_v);
-				Tessellator<Vec3f> tess_nrm(points.pos, idx_v);
-
-				for (int tile_u = start_u; tile_u <= surface.tess_u; ++tile_u) {
-					const int index_u = surface.GetIndexU(patch_u, tile_u);
-					const Weight &wu = weights.u[index_u];
-
-					// Pre-tessellate U lines
-					tess_pos.SampleU(wu.basis);
-					if constexpr (sampleCol)
-						tess_col.SampleU(wu.basis);
-					if constexpr (sampleTex)
-						tess_tex.SampleU(wu.basis);
-					if constexpr (sampleNrm)
-						tess_nrm.SampleU(wu.deriv);
-
-					for (int tile_v = start_v; tile_v <= surface.tess_v; ++tile_v) {
-						const int index_v = surface.GetIndexV(patch_v, tile_v);
-						const Weight &wv = weights.v[index_v];
-
-						SimpleVertex &vert = output.vertices[surface.GetIndex(index_u, index_v, patch_u, patch_v)];
-
-						// Tessellate
-						vert.pos = tess_pos.SampleV(wv.basis);
-						if constexpr (sampleCol) {
-							vert.color_32 = tess_col.SampleV(wv.basis).ToRGBA();
-						} else {
-							vert.color_32 = points.defcolor;
-						}
-						if constexpr (sampleTex) {
-							tess_tex.SampleV(wv.basis).Write(vert.uv);
-						} else {
-							// Generate texcoord
-							vert.uv[0] = patch_u + tile_u * inv_u;
-							vert.uv[1] = patch_v + tile_v * inv_v;
-						}
-						if constexpr (sampleNrm) {
-							const Vec3f derivU = tess_nrm.SampleV(wv.basis);
-							const Vec3f derivV = tess_pos.SampleV(wv.deriv);
-
-							vert.nrm = Cross(derivU, derivV).Normalized(useSSE4);
-							if constexpr (patchFacing)
-								vert.nrm *= -1.0f;
-						} else {
-							vert.nrm.SetZero();
-							vert.nrm.z = 1.0f;
-						}
+			for (int tile_u = start_u; tile_u < end_u; ++tile_u) {
+				const int index_u = surface.GetIndexU(patch_u, tile_u);
+				const Weight &wu = weights.u[index_u];
+
+				// Pre-tessellate U lines
+				tess_pos.SampleU(wu.basis);
+				if constexpr (sampleCol)
+					tess_col.SampleU(wu.basis);
+				if constexpr (sampleTex)
+					tess_tex.SampleU(wu.basis);
+				if constexpr (sampleNrm)
+					tess_nrm.SampleU(wu.deriv);
+
+				for (int tile_v = start_v; tile_v <= surface.tess_v; ++tile_v) {
+					const int index_v = surface.GetIndexV(patch_v, tile_v);
+					const Weight &wv = weights.v[index_v];
+
+					SimpleVertex &vert = output.vertices[surface.GetIndex(index_u, index_v, patch_u, patch_v)];
+
+					// Tessellate
+					vert.pos = tess_pos.SampleV(wv.basis);
+					if constexpr (sampleCol) {
+						vert.color_32 = tess_col.SampleV(wv.basis).ToRGBA();
+					} else {
+						vert.color_32 = points.defcolor;
+					}
+					if constexpr (sampleTex) {
+						tess_tex.SampleV(wv.basis).Write(vert.uv);
+					} else {
+						// Generate texcoord
+						vert.uv[0] = patch_u + tile_u * inv_u;
+						vert.uv[1] = patch_v + tile_v * inv_v;
+					}
+					if constexpr (sampleNrm) {
+						const Vec3f derivU = tess_nrm.SampleV(wv.basis);
+						const Vec3f derivV = tess_pos.SampleV(wv.deriv);
+
+						vert.nrm = Cross(derivU, derivV).Normalized(useSSE4);
+						if constexpr (patchFacing)
+							vert.nrm *= -1.0f;
+					} else {
+						vert.nrm.SetZero();
+						vert.nrm.z = 1.0f;
 					}
 				}
 			}
 		}
+	}
+
+	template <bool sampleNrm, bool sampleCol, bool sampleTex, bool useSSE4, bool patchFacing>
+	static void Tessellate(OutputBuffers &output, const Surface &surface, const ControlPoints &points, const Weight2D &weights) {
+		const int numLines = surface.num_patches_u * surface.num_patches_v * (surface.tess_u + 1);
+		const int vertsPerLine = surface.tess_v + 1;
+
+		if (numLines * vertsPerLine < MIN_PARALLEL_TESS_VERTS) {
+			TessellateLines<sampleNrm, sampleCol, sampleTex, useSSE4, patchFacing>(output, surface, points, weights, 0, numLines);
+		} else {
+			const int minLines = std::max(1, MIN_TESS_VERTS_PER_TASK / vertsPerLine);
+			ParallelRangeLoop(&g_threadManager, [&](int lower, int upper) {
+				TessellateLines<sampleNrm, sampleCol, sampleTex, useSSE4, patchFacing>(output, surface, points, weights, lower, upper);
+			}, 0, numLines, minLines);
+		}
 
 		surface.BuildIndex(output.indices, output.count);
 	}
@@ -143,6 +143,10 @@ struct Weight {
 	float basis[4], deriv[4];
 };
 
+// Games only use a handful of tessellation levels, but with the quality setting and
+// per-patch knot types the set of keys could grow without bound.
+#define MAX_SPLINE_WEIGHT_CACHE_ENTRIES 64
+
 template<class T>
 class WeightCache : public T {
 private:
@@ -155,6 +159,12 @@ class WeightCache : public T {
 		return weights;
 	}
 
+	// Must be called before looking up weights, not in between, since it may free them.
+	void Trim() {
+		if (weightsCache.size() + 2 > MAX_SPLINE_WEIGHT_CACHE_ENTRIES)
+			Clear();
+	}
+
 	void Clear() {
 		for (auto it : weightsCache)
 			delete[] it.second;
@@ -168,6 +178,7 @@ struct Weight2D {
 
 	template<class T>
 	Weight2D(WeightCache<T> &cache, u32 key_u, u32 key_v) {
+		cache.Trim();
 		u = cache[key_u];
 		v = (key_u != key_v) ? cache[key_v] : u; // Use same weights if u == v
 	}
@@ -18,6 +18,9 @@
 #include "ppsspp_config.h"
 
 #include <algorithm>
+#include <atomic>
+
+#include "ext/xxhash.h"
 
 #include "Common/Common.h"
 #include "Common/Data/Convert/ColorConv.h"
@@ -26,6 +29,7 @@
 #include "Common/LogReporting.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtils.h"
+#include "Common/Thread/ParallelLoop.h"
 #include "Common/Math/SIMDHeaders.h"
 #include "Common/TimeUtil.h"
 #include "Common/Math/math_util.h"
@@ -1517,6 +1521,36 @@ void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes, GPURecord::Record
 	clutMaxBytes_ = std::max(clutMaxBytes_, loadBytes);
 }
 
+// Large textures are decoded in bands of rows on worker threads, to cut down on stutter
+// when a game streams in many new textures at once.
+static const int MIN_PARALLEL_DECODE_PIXELS = 256 * 256;
+static const int MIN_DECODE_ROWS_PER_TASK = 32;
+
+// Calls rowFunc(y, rowAlphaSum) for each row, possibly in parallel. The alpha sums are ANDed together.
+template <typename RowFunc>
+static void DecodeRows(int w, int h, u32 *alphaSum, RowFunc rowFunc) {
+	u32 unusedSum = 0xFFFFFFFF;
+	if (!alphaSum)
+		alphaSum = &unusedSum;
+
+	if (w * h < MIN_PARALLEL_DECODE_PIXELS || h < MIN_DECODE_ROWS_PER_TASK * 2) {
+		for (int y = 0; y < h; ++y) {
+			rowFunc(y, alphaSum);
+		}
+		return;
+	}
+
+	std::atomic<u32> combinedSum(*alphaSum);
+	ParallelRangeLoop(&g_threadManager, [&](int lower, int upper) {
+		u32 bandSum = 0xFFFFFFFF;
+		for (int y = lower; y < upper; ++y) {
+			rowFunc(y, &bandSum);
+		}
+		combinedSum.fetch_and(bandSum);
+	}, 0, h, MIN_DECODE_ROWS_PER_TASK, TaskPriority::HIGH);
+	*alphaSum = combinedSum;
+}
+
 void TextureCacheCommon::UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *texptr, u32 bufw, u32 height, u32 bytesPerPixel) {
 	// Note: bufw is always aligned to 16 bytes, so rowWidth is always >= 16.
 	const u32 rowWidth = (bytesPerPixel > 0) ? (bufw * bytesPerPixel) : (bufw / 2);
@@ -1534,7 +1568,15 @@ void TextureCacheCommon::UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *te
 	// The height is not always aligned to 8, but rounds up.
 	int byc = (height + 7) / 8;
 
-	DoUnswizzleTex16(texptr, dest, bxc, byc, destPitch);
+	if ((int)(bufw * height) < MIN_PARALLEL_DECODE_PIXELS) {
+		DoUnswizzleTex16(texptr, dest, bxc, byc, destPitch);
+		return;
+	}
+
+	// Each row of blocks is contiguous in memory, so they can be unswizzled separately.
+	ParallelRangeLoop(&g_threadManager, [&](int lower, int upper) {
+		DoUnswizzleTex16(texptr + lower * rowWidth * 8, (u32 *)((u8 *)dest + lower * destPitch * 8), bxc, upper - lower, destPitch);
+	}, 0, byc, MIN_DECODE_ROWS_PER_TASK / 8, TaskPriority::HIGH);
 }
 
 bool TextureCacheCommon::GetCurrentClutBuffer(GPUDebugBuffer &buffer) {
@@ -1709,24 +1751,25 @@ static CheckAlphaResult DecodeDXTBlocks(uint8_t *out, int outPitch, uint32_t tex
 	}
 
 	u32 alphaSum = 1;
-	for (int y = 0; y < h; y += 4) {
-		u32 blockIndex = (y / 4) * (bufw / 4);
+	// Each "row" here is a row of 4x4 blocks.
+	DecodeRows(minw * 4, (h + 3) / 4, &alphaSum, [&](int by, u32 *rowAlphaSum) {
+		int y = by * 4;
+		u32 blockIndex = by * (bufw / 4);
 		int blockHeight = std::min(h - y, 4);
 		for (int x = 0; x < minw; x += 4) {
 			int blockWidth = std::min(minw - x, 4);
 			if constexpr (n == 1)
-				DecodeDXT1Block(dst + outPitch32 * y + x, (const DXT1Block *)src + blockIndex, outPitch32, blockWidth, blockHeight, &alphaSum);
+				DecodeDXT1Block(dst + outPitch32 * y + x, (const DXT1Block *)src + blockIndex, outPitch32, blockWidth, blockHeight, rowAlphaSum);
 			else if constexpr (n == 3)
 				DecodeDXT3Block(dst + outPitch32 * y + x, (const DXT3Block *)src + blockIndex, outPitch32, blockWidth, blockHeight);
 			else if constexpr (n == 5)
 				DecodeDXT5Block(dst + outPitch32 * y + x, (const DXT5Block *)src + blockIndex, outPitch32, blockWidth, blockHeight);
 			blockIndex++;
 		}
-	}
-
-	if (reverseColors) {
-		ReverseColors(out, out, GE_TFMT_8888, outPitch32 * h);
-	}
+		if (reverseColors) {
+			ReverseColors(out + outPitch * y, out + outPitch * y, GE_TFMT_8888, outPitch32 * blockHeight);
+		}
+	});
 
 	if constexpr (n == 1) {
 		return alphaSum == 1 ? CHECKALPHA_FULL : CHECKALPHA_ANY;
@@ -1767,7 +1810,7 @@ static void Expand4To8Bits(u8 *dest, const u8 *src, int srcWidth) {
 	}
 }
 
-CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, TexDecodeFlags flags) {
+CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, TexDecodeFlags flags, int startRow, int numRows) {
 	u32 alphaSum = 0xFFFFFFFF;
 	u32 fullAlphaMask = 0x0;
 
@@ -1793,6 +1836,11 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 
 	int w = gstate.getTextureWidth(level);
 	int h = gstate.getTextureHeight(level);
+	if (numRows >= 0) {
+		// Since startRow is a multiple of 8, this lands on a block row for swizzled and DXT textures too.
+		texaddr += (textureBitsPerPixel[format] * bufw * startRow) / 8;
+		h = numRows;
+	}
 	const u8 *texptr = Memory::GetPointer(texaddr);
 	const uint32_t byteSize = (textureBitsPerPixel[format] * bufw * h) / 8;
 
@@ -1814,9 +1862,9 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 
 		if (toClut8) {
 			// We just need to expand from 4 to 8 bits.
-			for (int y = 0; y < h; ++y) {
+			DecodeRows(w, h, nullptr, [&](int y, u32 *) {
 				Expand4To8Bits((u8 *)out + outPitch * y, texptr + (bufw * y) / 2, w);
-			}
+			});
 			// We can't know anything about alpha.
 			return CHECKALPHA_ANY;
 		}
@@ -1832,13 +1880,13 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 				// We don't bother with fullalpha here (clutAlphaLinear_)
 				// Here, reverseColors means the CLUT is already reversed.
 				if (reverseColors) {
-					for (int y = 0; y < h; ++y) {
+					DecodeRows(w, h, nullptr, [&](int y, u32 *) {
 						DeIndexTexture4Optimal((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clutAlphaLinearColor_);
-					}
+					});
 				} else {
-					for (int y = 0; y < h; ++y) {
+					DecodeRows(w, h, nullptr, [&](int y, u32 *) {
 						DeIndexTexture4OptimalRev((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clutAlphaLinearColor_);
-					}
+					});
 				}
 			} else {
 				// Need to have the "un-reversed" (raw) CLUT here since we are using a generic conversion function.
@@ -1853,16 +1901,16 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 						ConvertFormatToRGBA8888(clutformat, expandClut_, clut, 512);
 					}
 					fullAlphaMask = 0xFF000000;
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4<u32>((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, expandClut_, &alphaSum);
-					}
+					DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+						DeIndexTexture4<u32>((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, expandClut_, rowAlphaSum);
+					});
 				} else {
 					// If we're reversing colors, the CLUT was already reversed, no special handling needed.
 					const u16 *clut = GetCurrentClut<u16>() + clutSharingOffset;
 					fullAlphaMask = ClutFormatToFullAlpha(clutformat, reverseColors);
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4<u16>((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut, &alphaSum);
-					}
+					DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+						DeIndexTexture4<u16>((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut, rowAlphaSum);
+					});
 				}
 			}
 
@@ -1877,9 +1925,9 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 		{
 			const u32 *clut = GetCurrentClut<u32>() + clutSharingOffset;
 			fullAlphaMask = 0xFF000000;
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture4<u32>((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture4<u32>((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut, rowAlphaSum);
+			});
 		}
 		break;
 
@@ -1898,19 +1946,19 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 				texptr = (u8 *)tmpTexBuf32_.data();
 			}
 			// After deswizzling, we are in the correct format and can just copy.
-			for (int y = 0; y < h; ++y) {
+			DecodeRows(w, h, nullptr, [&](int y, u32 *) {
 				memcpy((u8 *)out + outPitch * y, texptr + (bufw * y), w);
-			}
+			});
 			// We can't know anything about alpha.
 			return CHECKALPHA_ANY;
 		}
-		return ReadIndexedTex(out, outPitch, level, texptr, 1, bufw, reverseColors, expandTo32bit);
+		return ReadIndexedTex(out, outPitch, level, h, texptr, 1, bufw, reverseColors, expandTo32bit);
 
 	case GE_TFMT_CLUT16:
-		return ReadIndexedTex(out, outPitch, level, texptr, 2, bufw, reverseColors, expandTo32bit);
+		return ReadIndexedTex(out, outPitch, level, h, texptr, 2, bufw, reverseColors, expandTo32bit);
 
 	case GE_TFMT_CLUT32:
-		return ReadIndexedTex(out, outPitch, level, texptr, 4, bufw, reverseColors, expandTo32bit);
+		return ReadIndexedTex(out, outPitch, level, h, texptr, 4, bufw, reverseColors, expandTo32bit);
 
 	case GE_TFMT_4444:
 	case GE_TFMT_5551:
@@ -1920,20 +1968,20 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 			fullAlphaMask = TfmtRawToFullAlpha(format);
 			if (expandTo32bit) {
 				// This is OK even if reverseColors is on, because it expands to the 8888 format which is the same in reverse mode.
-				for (int y = 0; y < h; ++y) {
-					CheckMask16((const u16 *)(texptr + bufw * sizeof(u16) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask16((const u16 *)(texptr + bufw * sizeof(u16) * y), w, rowAlphaSum);
 					ConvertFormatToRGBA8888(format, (u32 *)(out + outPitch * y), (const u16 *)texptr + bufw * y, w);
-				}
+				});
 			} else if (reverseColors) {
 				// Just check the input's alpha to reuse code. TODO: make a specialized ReverseColors that checks as we go.
-				for (int y = 0; y < h; ++y) {
-					CheckMask16((const u16 *)(texptr + bufw * sizeof(u16) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask16((const u16 *)(texptr + bufw * sizeof(u16) * y), w, rowAlphaSum);
 					ReverseColors(out + outPitch * y, texptr + bufw * sizeof(u16) * y, format, w);
-				}
+				});
 			} else {
-				for (int y = 0; y < h; ++y) {
-					CopyAndSumMask16((u16 *)(out + outPitch * y), (u16 *)(texptr + bufw * sizeof(u16) * y), w, &alphaSum);
-				}
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CopyAndSumMask16((u16 *)(out + outPitch * y), (u16 *)(texptr + bufw * sizeof(u16) * y), w, rowAlphaSum);
+				});
 			}
 		} /* else if (h >= 8 && bufw <= w && !expandTo32bit) {
 			// TODO: Handle alpha mask. This will require special versions of UnswizzleFromMem to keep the optimization.
@@ -1952,20 +2000,20 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 			if (expandTo32bit) {
 				// This is OK even if reverseColors is on, because it expands to the 8888 format which is the same in reverse mode.
 				// Just check the swizzled input's alpha to reuse code. TODO: make a specialized ConvertFormatToRGBA8888 that checks as we go.
-				for (int y = 0; y < h; ++y) {
-					CheckMask16((const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask16((const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, rowAlphaSum);
 					ConvertFormatToRGBA8888(format, (u32 *)(out + outPitch * y), (const u16 *)unswizzled + bufw * y, w);
-				}
+				});
 			} else if (reverseColors) {
 				// Just check the swizzled input's alpha to reuse code. TODO: make a specialized ReverseColors that checks as we go.
-				for (int y = 0; y < h; ++y) {
-					CheckMask16((const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask16((const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, rowAlphaSum);
 					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u16) * y, format, w);
-				}
+				});
 			} else {
-				for (int y = 0; y < h; ++y) {
-					CopyAndSumMask16((u16 *)(out + outPitch * y), (const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, &alphaSum);
-				}
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CopyAndSumMask16((u16 *)(out + outPitch * y), (const u16 *)(unswizzled + bufw * sizeof(u16) * y), w, rowAlphaSum);
+				});
 			}
 		}
 		if (format == GE_TFMT_5650) {
@@ -1977,14 +2025,14 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 		if (!swizzled) {
 			fullAlphaMask = TfmtRawToFullAlpha(format);
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
-					CheckMask32((const u32 *)(texptr + bufw * sizeof(u32) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask32((const u32 *)(texptr + bufw * sizeof(u32) * y), w, rowAlphaSum);
 					ReverseColors(out + outPitch * y, texptr + bufw * sizeof(u32) * y, format, w);
-				}
+				});
 			} else {
-				for (int y = 0; y < h; ++y) {
-					CopyAndSumMask32((u32 *)(out + outPitch * y), (const u32 *)(texptr + bufw * sizeof(u32) * y), w, &alphaSum);
-				}
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CopyAndSumMask32((u32 *)(out + outPitch * y), (const u32 *)(texptr + bufw * sizeof(u32) * y), w, rowAlphaSum);
+				});
 			}
 		} /* else if (h >= 8 && bufw <= w) {
 			// TODO: Handle alpha mask
@@ -1999,14 +2047,14 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 
 			fullAlphaMask = TfmtRawToFullAlpha(format);
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
-					CheckMask32((const u32 *)(unswizzled + bufw * sizeof(u32) * y), w, &alphaSum);
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CheckMask32((const u32 *)(unswizzled + bufw * sizeof(u32) * y), w, rowAlphaSum);
 					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u32) * y, format, w);
-				}
+				});
 			} else {
-				for (int y = 0; y < h; ++y) {
-					CopyAndSumMask32((u32 *)(out + outPitch * y), (const u32 *)(unswizzled + bufw * sizeof(u32) * y), w, &alphaSum);
-				}
+				DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+					CopyAndSumMask32((u32 *)(out + outPitch * y), (const u32 *)(unswizzled + bufw * sizeof(u32) * y), w, rowAlphaSum);
+				});
 			}
 		}
 		break;
@@ -2028,9 +2076,8 @@ CheckAlphaResult TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, G
 	return AlphaSumIsFull(alphaSum, fullAlphaMask) ? CHECKALPHA_FULL : CHECKALPHA_ANY;
 }
 
-CheckAlphaResult TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool reverseColors, bool expandTo32Bit) {
+CheckAlphaResult TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, int h, const u8 *texptr, int bytesPerIndex, int bufw, bool reverseColors, bool expandTo32Bit) {
 	int w = gstate.getTextureWidth(level);
-	int h = gstate.getTextureHeight(level);
 
 	if (gstate.isTextureSwizzled()) {
 		tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
@@ -2072,21 +2119,21 @@ CheckAlphaResult TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int l
 	{
 		switch (bytesPerIndex) {
 		case 1:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut16, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut16, rowAlphaSum);
+			});
 			break;
 
 		case 2:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut16, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut16, rowAlphaSum);
+			});
 			break;
 
 		case 4:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut16, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut16, rowAlphaSum);
+			});
 			break;
 		}
 	}
@@ -2097,21 +2144,21 @@ CheckAlphaResult TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int l
 
 		switch (bytesPerIndex) {
 		case 1:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut32, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut32, rowAlphaSum);
+			});
 			break;
 
 		case 2:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut32, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut32, rowAlphaSum);
+			});
 			break;
 
 		case 4:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut32, &alphaSum);
-			}
+			DecodeRows(w, h, &alphaSum, [&](int y, u32 *rowAlphaSum) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut32, rowAlphaSum);
+			});
 			break;
 		}
 	}
@@ -2183,6 +2230,7 @@ void TextureCacheCommon::ApplyTexture(bool doBind) {
 		if (!CheckFullHash(entry, doDelete)) {
 			HandleTextureChange(entry, "hash fail", true, doDelete);
 			nextNeedsRebuild_ = true;
+			numFullRedecodes_++;
 		} else if (nextTexture_ != nullptr) {
 			// The secondary cache may choose an entry from its storage by setting nextTexture_.
 			// This means we should set that, instead of our previous entry.
@@ -2616,6 +2664,12 @@ bool TextureCacheCommon::CheckFullHash(TexCacheEntry *entry, bool &doDelete) {
 		return true;
 	}
 
+	// If only some rows changed, we can patch the texture we already have.
+	if (!entry->bandHashes.empty() && UpdateChangedRows(entry)) {
+		entry->fullhash = fullhash;
+		return true;
+	}
+
 	// Don't give up just yet.  Let's try the secondary cache if it's been invalidated before.
 	if (PSP_CoreParameter().compat.flags().SecondaryTextureCache) {
 		// Don't forget this one was unreliable (in case we match a secondary entry.)
@@ -2668,6 +2722,86 @@ bool TextureCacheCommon::CheckFullHash(TexCacheEntry *entry, bool &doDelete) {
 	return false;
 }
 
+bool TextureCacheCommon::ComputeBandHashes(const TexCacheEntry *entry, std::vector<u32> &hashes) const {
+	const int h = gstate.getTextureHeight(0);
+	const u32 bitsPerPixel = textureBitsPerPixel[entry->format];
+	// Swizzled textures always occupy whole blocks of 8 rows, see QuickTexHash.
+	const int rowsInRAM = gstate.isTextureSwizzled() ? ((h + 7) & ~7) : h;
+	const u32 sizeInRAM = (bitsPerPixel * entry->bufw * rowsInRAM) / 8;
+	const u32 bandSize = (bitsPerPixel * entry->bufw * TEXCACHE_HASH_BAND_ROWS) / 8;
+	if (bandSize == 0 || !Memory::IsValidRange(entry->addr, sizeInRAM)) {
+		return false;
+	}
+
+	const u8 *data = Memory::GetPointerUnchecked(entry->addr);
+	hashes.resize((sizeInRAM + bandSize - 1) / bandSize);
+	for (size_t i = 0; i < hashes.size(); ++i) {
+		u32 offset = (u32)i * bandSize;
+		hashes[i] = (u32)XXH3_64bits(data + offset, std::min(bandSize, sizeInRAM - offset));
+	}
+	gpuStats.perFrame.numTextureDataBytesHashed += sizeInRAM;
+	return true;
+}
+
+bool TextureCacheCommon::UpdateChangedRows(TexCacheEntry *entry) {
+	std::vector<u32> newHashes;
+	if (!ComputeBandHashes(entry, newHashes) || newHashes.size() != entry->bandHashes.size()) {
+		return false;
+	}
+
+	int firstBand = -1;
+	int lastBand = -1;
+	for (int i = 0; i < (int)newHashes.size(); ++i) {
+		if (newHashes[i] != entry->bandHashes[i]) {
+			if (firstBand < 0)
+				firstBand = i;
+			lastBand = i;
+		}
+	}
+	// If nothing we track changed, the hash was probably forced to mismatch. Rebuild normally.
+	if (firstBand < 0) {
+		return false;
+	}
+
+	const int h = gstate.getTextureHeight(0);
+	const int y = firstBand * TEXCACHE_HASH_BAND_ROWS;
+	const int rows = std::min(h, (lastBand + 1) * TEXCACHE_HASH_BAND_ROWS) - y;
+	// Not worth it if most of the texture changed anyway.
+	if (rows <= 0 || rows * 2 > h) {
+		return false;
+	}
+
+	{
+		PROFILE_THIS_SCOPE("decodetex");
+		if (!UpdateTextureRows(entry, y, rows)) {
+			return false;
+		}
+	}
+	entry->bandHashes = std::move(newHashes);
+
+	// Do the usual change tracking, but we keep the texture so the size estimate doesn't change.
+	HandleTextureChange(entry, "partial hash fail", true, false);
+	cacheSizeEstimate_ += EstimateTexMemoryUsage(entry);
+	numPartialRedecodes_++;
+	return true;
+}
+
+void TextureCacheCommon::DecodeTextureRows(TexCacheEntry *entry, u8 *data, int stride, int y, int h, Draw::DataFormat dstFmt, TexDecodeFlags texDecFlags) {
+	// Same decisions as LoadTextureLevel makes for unscaled, unreplaced textures.
+	GETextureFormat tfmt = (GETextureFormat)entry->format;
+	u32 texaddr = gstate.getTextureAddress(0);
+	const int bufw = GetTextureBufw(0, texaddr, tfmt);
+	if (!gstate_c.Use(GPU_USE_16BIT_FORMATS) || dstFmt == Draw::DataFormat::R8G8B8A8_UNORM) {
+		texDecFlags |= TexDecodeFlags::EXPAND32;
+	}
+
+	CheckAlphaResult alphaResult = DecodeTextureLevel(data, stride, tfmt, gstate.getClutPaletteFormat(), texaddr, 0, bufw, texDecFlags, y, h);
+	// We only saw part of the texture, so we can only make the alpha status less restrictive.
+	if (alphaResult == CHECKALPHA_ANY) {
+		entry->SetAlphaStatus(TexCacheEntry::STATUS_ALPHA_UNKNOWN);
+	}
+}
+
 void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type) {
 	// They could invalidate inside the texture, let's just give a bit of leeway.
 	// TODO: Keep track of the largest texture size in bytes, and use that instead of this
@@ -2716,6 +2850,7 @@ void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type
 				// Just random values to force the hash not to match.
 				entry->fullhash = (entry->fullhash ^ 0x12345678) + 13;
 				entry->minihash = (entry->minihash ^ 0x89ABCDEF) + 89;
+				entry->bandHashes.clear();
 			}
 			if (type != GPU_INVALIDATE_ALL) {
 				gpuStats.perFrame.numTextureInvalidations++;
@@ -3006,6 +3141,14 @@ bool TextureCacheCommon::PrepareBuildTexture(BuildTexturePlan &plan, TexCacheEnt
 
 	// Will be filled in again during decode.
 	entry->status &= ~TexCacheEntry::STATUS_ALPHA_MASK;
+
+	// Only plain single level textures can be patched in place later, see UpdateChangedRows.
+	entry->bandHashes.clear();
+	bool canUpdateRows = plan.levelsToLoad == 1 && plan.levelsToCreate == 1 && plan.baseLevelSrc == 0 && plan.depth == 1;
+	canUpdateRows = canUpdateRows && plan.scaleFactor == 1 && !plan.doReplace && !plan.saveTexture && !plan.decodeToClut8 && !plan.isVideo;
+	if (partialUpdatesSupported_ && canUpdateRows && !replacer_.Enabled()) {
+		ComputeBandHashes(entry, entry->bandHashes);
+	}
 	return true;
 }
 
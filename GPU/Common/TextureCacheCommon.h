@@ -47,6 +47,9 @@ enum FramebufferNotification {
 
 #define TEXCACHE_MAX_TEXELS_SCALED (256*256)  // Per frame
 
+// Rows per band for the partial update hashes. A multiple of 8 so bands line up with swizzle and DXT blocks.
+#define TEXCACHE_HASH_BAND_ROWS 8
+
 struct VirtualFramebuffer;
 class TextureReplacer;
 class ShaderManagerCommon;
@@ -200,6 +203,8 @@ struct TexCacheEntry {
 	u32 cluthash;
 	u16 maxSeenV;
 	ReplacedTexture *replacedTexture;
+	// Hashes of each TEXCACHE_HASH_BAND_ROWS rows of level 0. Only kept when the texture can be updated in place.
+	std::vector<u32> bandHashes;
 
 	TexStatus GetHashStatus() {
 		return TexStatus(status & STATUS_MASK);
@@ -395,6 +400,10 @@ class TextureCacheCommon {
 	const size_t CacheSizeEstimate() const { return cacheSizeEstimate_; }
 	const size_t SecondCacheSizeEstimate() const { return secondCacheSizeEstimate_; }
 
+	// Number of textures rebuilt from scratch vs. patched in place after a hash fail.
+	int NumFullRedecodes() const { return numFullRedecodes_; }
+	int NumPartialRedecodes() const { return numPartialRedecodes_; }
+
 	struct VideoInfo {
 		u32 addr;
 		u32 size;
@@ -421,12 +430,20 @@ class TextureCacheCommon {
 	virtual void BuildTexture(TexCacheEntry *const entry) = 0;
 	virtual void UpdateCurrentClut(GEPaletteFormat clutFormat, u32 clutBase, bool clutIndexIsSimple) = 0;
 	bool CheckFullHash(TexCacheEntry *entry, bool &doDelete);
+	bool ComputeBandHashes(const TexCacheEntry *entry, std::vector<u32> &hashes) const;
+	bool UpdateChangedRows(TexCacheEntry *entry);
+
+	// Re-decodes rows [y, y + h) of level 0 and uploads them over the existing texture.
+	// Only called if partialUpdatesSupported_ is set. Return false to fall back to a full rebuild.
+	virtual bool UpdateTextureRows(TexCacheEntry *entry, int y, int h) { return false; }
+	void DecodeTextureRows(TexCacheEntry *entry, u8 *data, int stride, int y, int h, Draw::DataFormat dstFmt, TexDecodeFlags texDecFlags);
 
 	virtual void BindAsClutTexture(Draw::Texture *tex, bool smooth) {}
 
-	CheckAlphaResult DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, TexDecodeFlags flags);
+	// If numRows is not negative, only rows [startRow, startRow + numRows) are decoded. startRow must be a multiple of 8.
+	CheckAlphaResult DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, TexDecodeFlags flags, int startRow = 0, int numRows = -1);
 	static void UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *texptr, u32 bufw, u32 height, u32 bytesPerPixel);
-	CheckAlphaResult ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool reverseColors, bool expandTo32Bit);
+	CheckAlphaResult ReadIndexedTex(u8 *out, int outPitch, int level, int h, const u8 *texptr, int bytesPerIndex, int bufw, bool reverseColors, bool expandTo32Bit);
 	ReplacedTexture *FindReplacement(TexCacheEntry *entry, int *w, int *h, int *d);
 	void PollReplacement(TexCacheEntry *entry, int *w, int *h, int *d);
 
@@ -509,6 +526,11 @@ class TextureCacheCommon {
 
 	bool clearCacheNextFrame_ = false;
 	bool lowMemoryMode_ = false;
+	// Set by backends that implement UpdateTextureRows.
+	bool partialUpdatesSupported_ = false;
+
+	int numFullRedecodes_ = 0;
+	int numPartialRedecodes_ = 0;
 
 	int decimationCounter_;
 	int texelsScaledThisFrame_ = 0;
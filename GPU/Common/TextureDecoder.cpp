@@ -20,6 +20,7 @@
 #include "ext/xxhash.h"
 
 #include "Common/Common.h"
+#include "Common/CPUDetect.h"
 #include "Common/Log.h"
 #include "Common/Math/SIMDHeaders.h"
 
@@ -28,6 +29,17 @@
 
 #include "Common/Math/SIMDHeaders.h"
 
+#ifdef _M_SSE
+#include <immintrin.h>
+
+// Lets us build SSSE3/AVX2 kernels without raising the baseline for the whole file.
+#if defined(__GNUC__) || defined(__clang__)
+#define TEXDEC_TARGET(x) [[gnu::target(x)]]
+#else
+#define TEXDEC_TARGET(x)
+#endif
+#endif
+
 const u8 textureBitsPerPixel[16] = {
 	16,  //GE_TFMT_5650,
 	16,  //GE_TFMT_5551,
@@ -378,7 +390,7 @@ void DoSwizzleTex16(const u32 *ysrcp, u8 *texptr, int bxc, int byc, u32 pitch) {
 	}
 }
 
-void DoUnswizzleTex16(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch) {
+static void DoUnswizzleTex16Basic(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch) {
 	// ydestp is in 32-bits, so this is convenient.
 	const u32 pitchBy32 = pitch >> 2;
 
@@ -710,6 +722,283 @@ inline u32 NEONReduce16And(uint16x8_t value) {
 }
 #endif
 
+template <typename ClutT>
+static void DeIndex4Generic(ClutT *dest, const u8 *indexed, int length, const ClutT *clut, u32 *outAlphaSum) {
+	ClutT alphaSum = (ClutT)(-1);
+	for (int i = 0; i < length / 2; ++i) {
+		u8 index = indexed[i];
+		ClutT color0 = clut[index & 0xf];
+		ClutT color1 = clut[index >> 4];
+		dest[i * 2 + 0] = color0;
+		dest[i * 2 + 1] = color1;
+		alphaSum &= color0 & color1;
+	}
+	if (length & 1) {  // Last pixel. Can really only happen in 1xY textures, but making this work generically.
+		ClutT color0 = clut[indexed[length / 2] & 0xf];
+		dest[length - 1] = color0;
+		alphaSum &= color0;
+	}
+	*outAlphaSum &= (u32)alphaSum;
+}
+
+static void DeIndex8To32Generic(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum) {
+	u32 alphaSum = 0xFFFFFFFF;
+	for (int i = 0; i < length; ++i) {
+		u32 color = clut[indexed[i]];
+		alphaSum &= color;
+		dest[i] = color;
+	}
+	*outAlphaSum &= alphaSum;
+}
+
+#ifdef _M_SSE
+// pshufb is a 16-entry byte table lookup, so a 4-bit CLUT is split into byte planes and looked up 32 pixels at a time.
+TEXDEC_TARGET("ssse3")
+static void DeIndex4To16SSSE3(u16 *dest, const u8 *indexed, int length, const u16 *clut, u32 *outAlphaSum) {
+	alignas(16) u8 planes[2][16];
+	for (int i = 0; i < 16; ++i) {
+		planes[0][i] = (u8)clut[i];
+		planes[1][i] = (u8)(clut[i] >> 8);
+	}
+	const __m128i tableLo = _mm_load_si128((const __m128i *)planes[0]);
+	const __m128i tableHi = _mm_load_si128((const __m128i *)planes[1]);
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	__m128i alphaLo = _mm_set1_epi8(-1);
+	__m128i alphaHi = _mm_set1_epi8(-1);
+
+	int i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m128i packed = _mm_loadu_si128((const __m128i *)(indexed + i / 2));
+		__m128i even = _mm_and_si128(packed, nibbleMask);
+		__m128i odd = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+		// The low nibble is the first pixel, so interleave to get indices in pixel order.
+		__m128i idx0 = _mm_unpacklo_epi8(even, odd);
+		__m128i idx1 = _mm_unpackhi_epi8(even, odd);
+
+		__m128i lo0 = _mm_shuffle_epi8(tableLo, idx0);
+		__m128i hi0 = _mm_shuffle_epi8(tableHi, idx0);
+		__m128i lo1 = _mm_shuffle_epi8(tableLo, idx1);
+		__m128i hi1 = _mm_shuffle_epi8(tableHi, idx1);
+		alphaLo = _mm_and_si128(alphaLo, _mm_and_si128(lo0, lo1));
+		alphaHi = _mm_and_si128(alphaHi, _mm_and_si128(hi0, hi1));
+
+		__m128i *d = (__m128i *)(dest + i);
+		_mm_storeu_si128(d + 0, _mm_unpacklo_epi8(lo0, hi0));
+		_mm_storeu_si128(d + 1, _mm_unpackhi_epi8(lo0, hi0));
+		_mm_storeu_si128(d + 2, _mm_unpacklo_epi8(lo1, hi1));
+		_mm_storeu_si128(d + 3, _mm_unpackhi_epi8(lo1, hi1));
+	}
+
+	__m128i alpha = _mm_and_si128(_mm_unpacklo_epi8(alphaLo, alphaHi), _mm_unpackhi_epi8(alphaLo, alphaHi));
+	*outAlphaSum &= SSEReduce16And(alpha);
+	DeIndex4Generic<u16>(dest + i, indexed + i / 2, length - i, clut, outAlphaSum);
+}
+
+TEXDEC_TARGET("ssse3")
+static inline __m128i Lookup16x4To32SSSE3(const __m128i *tables, __m128i idx, u32 *dest) {
+	__m128i c0 = _mm_shuffle_epi8(tables[0], idx);
+	__m128i c1 = _mm_shuffle_epi8(tables[1], idx);
+	__m128i c2 = _mm_shuffle_epi8(tables[2], idx);
+	__m128i c3 = _mm_shuffle_epi8(tables[3], idx);
+
+	__m128i c01lo = _mm_unpacklo_epi8(c0, c1);
+	__m128i c23lo = _mm_unpacklo_epi8(c2, c3);
+	__m128i c01hi = _mm_unpackhi_epi8(c0, c1);
+	__m128i c23hi = _mm_unpackhi_epi8(c2, c3);
+	__m128i p0 = _mm_unpacklo_epi16(c01lo, c23lo);
+	__m128i p1 = _mm_unpackhi_epi16(c01lo, c23lo);
+	__m128i p2 = _mm_unpacklo_epi16(c01hi, c23hi);
+	__m128i p3 = _mm_unpackhi_epi16(c01hi, c23hi);
+
+	__m128i *d = (__m128i *)dest;
+	_mm_storeu_si128(d + 0, p0);
+	_mm_storeu_si128(d + 1, p1);
+	_mm_storeu_si128(d + 2, p2);
+	_mm_storeu_si128(d + 3, p3);
+	return _mm_and_si128(_mm_and_si128(p0, p1), _mm_and_si128(p2, p3));
+}
+
+TEXDEC_TARGET("ssse3")
+static void DeIndex4To32SSSE3(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum) {
+	alignas(16) u8 planes[4][16];
+	for (int i = 0; i < 16; ++i) {
+		for (int p = 0; p < 4; ++p) {
+			planes[p][i] = (u8)(clut[i] >> (p * 8));
+		}
+	}
+	__m128i tables[4];
+	for (int p = 0; p < 4; ++p) {
+		tables[p] = _mm_load_si128((const __m128i *)planes[p]);
+	}
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	__m128i alpha = _mm_set1_epi32(-1);
+
+	int i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m128i packed = _mm_loadu_si128((const __m128i *)(indexed + i / 2));
+		__m128i even = _mm_and_si128(packed, nibbleMask);
+		__m128i odd = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+		alpha = _mm_and_si128(alpha, Lookup16x4To32SSSE3(tables, _mm_unpacklo_epi8(even, odd), dest + i));
+		alpha = _mm_and_si128(alpha, Lookup16x4To32SSSE3(tables, _mm_unpackhi_epi8(even, odd), dest + i + 16));
+	}
+
+	*outAlphaSum &= SSEReduce32And(alpha);
+	DeIndex4Generic<u32>(dest + i, indexed + i / 2, length - i, clut, outAlphaSum);
+}
+
+TEXDEC_TARGET("avx2")
+static void DeIndex8To32AVX2(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum) {
+	__m256i alpha = _mm256_set1_epi32(-1);
+	int i = 0;
+	for (; i + 8 <= length; i += 8) {
+		__m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(indexed + i)));
+		__m256i color = _mm256_i32gather_epi32((const int *)clut, idx, 4);
+		alpha = _mm256_and_si256(alpha, color);
+		_mm256_storeu_si256((__m256i *)(dest + i), color);
+	}
+
+	__m128i alpha128 = _mm_and_si128(_mm256_castsi256_si128(alpha), _mm256_extracti128_si256(alpha, 1));
+	*outAlphaSum &= SSEReduce32And(alpha128);
+	DeIndex8To32Generic(dest + i, indexed + i, length - i, clut, outAlphaSum);
+}
+
+// Two horizontally adjacent 16x8 byte blocks make up 32 contiguous bytes of each destination row.
+TEXDEC_TARGET("avx2")
+static void DoUnswizzleTex16AVX2(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch) {
+	if (bxc & 1) {
+		DoUnswizzleTex16Basic(texptr, ydestp, bxc, byc, pitch);
+		return;
+	}
+
+	const __m128i *src = (const __m128i *)texptr;
+	u8 *ydest = (u8 *)ydestp;
+	for (int by = 0; by < byc; by++) {
+		u8 *xdest = ydest;
+		for (int bx = 0; bx < bxc; bx += 2) {
+			u8 *dest = xdest;
+			for (int n = 0; n < 8; n++) {
+				__m256i row = _mm256_castsi128_si256(_mm_loadu_si128(src + n));
+				row = _mm256_inserti128_si256(row, _mm_loadu_si128(src + 8 + n), 1);
+				_mm256_storeu_si256((__m256i *)dest, row);
+				dest += pitch;
+			}
+			src += 16;
+			xdest += 32;
+		}
+		ydest += pitch * 8;
+	}
+}
+#endif
+
+#if PPSSPP_ARCH(ARM64_NEON)
+// Same idea as the SSSE3 path, but tbl plus interleaved stores do most of the work.
+static void DeIndex4To16NEON(u16 *dest, const u8 *indexed, int length, const u16 *clut, u32 *outAlphaSum) {
+	uint8x16x2_t tables = vld2q_u8((const u8 *)clut);
+	const uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+	uint8x16_t alphaLo = vdupq_n_u8(0xFF);
+	uint8x16_t alphaHi = vdupq_n_u8(0xFF);
+
+	int i = 0;
+	for (; i + 32 <= length; i += 32) {
+		uint8x16_t packed = vld1q_u8(indexed + i / 2);
+		uint8x16_t even = vandq_u8(packed, nibbleMask);
+		uint8x16_t odd = vshrq_n_u8(packed, 4);
+		uint8x16_t idx0 = vzip1q_u8(even, odd);
+		uint8x16_t idx1 = vzip2q_u8(even, odd);
+
+		uint8x16x2_t out0, out1;
+		out0.val[0] = vqtbl1q_u8(tables.val[0], idx0);
+		out0.val[1] = vqtbl1q_u8(tables.val[1], idx0);
+		out1.val[0] = vqtbl1q_u8(tables.val[0], idx1);
+		out1.val[1] = vqtbl1q_u8(tables.val[1], idx1);
+		alphaLo = vandq_u8(alphaLo, vandq_u8(out0.val[0], out1.val[0]));
+		alphaHi = vandq_u8(alphaHi, vandq_u8(out0.val[1], out1.val[1]));
+
+		vst2q_u8((u8 *)(dest + i), out0);
+		vst2q_u8((u8 *)(dest + i + 16), out1);
+	}
+
+	uint16x8_t alpha = vandq_u16(vreinterpretq_u16_u8(vzip1q_u8(alphaLo, alphaHi)), vreinterpretq_u16_u8(vzip2q_u8(alphaLo, alphaHi)));
+	*outAlphaSum &= NEONReduce16And(alpha);
+	DeIndex4Generic<u16>(dest + i, indexed + i / 2, length - i, clut, outAlphaSum);
+}
+
+static void DeIndex4To32NEON(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum) {
+	uint8x16x4_t tables = vld4q_u8((const u8 *)clut);
+	const uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+	uint8x16_t alphaPlanes[4];
+	for (int p = 0; p < 4; ++p) {
+		alphaPlanes[p] = vdupq_n_u8(0xFF);
+	}
+
+	int i = 0;
+	for (; i + 32 <= length; i += 32) {
+		uint8x16_t packed = vld1q_u8(indexed + i / 2);
+		uint8x16_t even = vandq_u8(packed, nibbleMask);
+		uint8x16_t odd = vshrq_n_u8(packed, 4);
+		uint8x16_t idx[2] = { vzip1q_u8(even, odd), vzip2q_u8(even, odd) };
+
+		for (int half = 0; half < 2; ++half) {
+			uint8x16x4_t out;
+			for (int p = 0; p < 4; ++p) {
+				out.val[p] = vqtbl1q_u8(tables.val[p], idx[half]);
+				alphaPlanes[p] = vandq_u8(alphaPlanes[p], out.val[p]);
+			}
+			vst4q_u8((u8 *)(dest + i + half * 16), out);
+		}
+	}
+
+	// Each plane holds one byte of every color, so reduce them separately.
+	u32 alphaSum = 0;
+	for (int p = 0; p < 4; ++p) {
+		u8 bytes[16];
+		vst1q_u8(bytes, alphaPlanes[p]);
+		u8 planeSum = 0xFF;
+		for (int j = 0; j < 16; ++j) {
+			planeSum &= bytes[j];
+		}
+		alphaSum |= (u32)planeSum << (p * 8);
+	}
+	*outAlphaSum &= alphaSum;
+	DeIndex4Generic<u32>(dest + i, indexed + i / 2, length - i, clut, outAlphaSum);
+}
+#endif
+
+const TextureDecodeFuncs genericTextureDecodeFuncs = {
+	&DoUnswizzleTex16Basic,
+	&DeIndex4Generic<u16>,
+	&DeIndex4Generic<u32>,
+	&DeIndex8To32Generic,
+};
+
+TextureDecodeFuncs textureDecodeFuncs = {
+	&DoUnswizzleTex16Basic,
+	&DeIndex4Generic<u16>,
+	&DeIndex4Generic<u32>,
+	&DeIndex8To32Generic,
+};
+
+void SetupTextureDecoder() {
+	textureDecodeFuncs = genericTextureDecodeFuncs;
+#ifdef _M_SSE
+	if (cpu_info.bSSSE3) {
+		textureDecodeFuncs.deIndex4To16 = &DeIndex4To16SSSE3;
+		textureDecodeFuncs.deIndex4To32 = &DeIndex4To32SSSE3;
+	}
+	if (cpu_info.bAVX2) {
+		textureDecodeFuncs.unswizzleTex16 = &DoUnswizzleTex16AVX2;
+		textureDecodeFuncs.deIndex8To32 = &DeIndex8To32AVX2;
+	}
+#elif PPSSPP_ARCH(ARM64_NEON)
+	textureDecodeFuncs.deIndex4To16 = &DeIndex4To16NEON;
+	textureDecodeFuncs.deIndex4To32 = &DeIndex4To32NEON;
+#endif
+}
+
+void DoUnswizzleTex16(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch) {
+	textureDecodeFuncs.unswizzleTex16(texptr, ydestp, bxc, byc, pitch);
+}
+
 // TODO: SSE/SIMD
 // At least on x86, compiler actually SIMDs these pretty well.
 void CopyAndSumMask16(u16 *dst, const u16 *src, int width, u32 *outMask) {
@@ -43,6 +43,22 @@ void CopyAndSumMask32(u32 *dst, const u32 *src, int width, u32 *outMask);
 void CheckMask16(const u16 *src, int width, u32 *outMask);
 void CheckMask32(const u32 *src, int width, u32 *outMask);
 
+// CPU-specific versions of the hottest decode loops, picked at runtime by SetupTextureDecoder().
+// The deIndex functions assume a naked CLUT index (no shift, mask or offset), and AND into outAlphaSum.
+struct TextureDecodeFuncs {
+	void (*unswizzleTex16)(const u8 *texptr, u32 *ydestp, int bxc, int byc, u32 pitch);
+	void (*deIndex4To16)(u16 *dest, const u8 *indexed, int length, const u16 *clut, u32 *outAlphaSum);
+	void (*deIndex4To32)(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum);
+	void (*deIndex8To32)(u32 *dest, const u8 *indexed, int length, const u32 *clut, u32 *outAlphaSum);
+};
+
+// Plain C++ versions, mainly for comparison in tests.
+extern const TextureDecodeFuncs genericTextureDecodeFuncs;
+extern TextureDecodeFuncs textureDecodeFuncs;
+
+// Called by GPU_Init. Safe to call more than once. Until it's called, the generic versions are used.
+void SetupTextureDecoder();
+
 // All these DXT structs are in the reverse order, as compared to PC.
 // On PC, alpha comes before color, and interpolants are before the tile data.
 
@@ -114,7 +130,10 @@ inline void DeIndexTexture(/*WRITEONLY*/ ClutT *dest, const IndexT *indexed, int
 	ClutT alphaSum = (ClutT)(-1);
 
 	if (nakedIndex) {
-		if (sizeof(IndexT) == 1) {
+		if (sizeof(IndexT) == 1 && sizeof(ClutT) == 4) {
+			textureDecodeFuncs.deIndex8To32((u32 *)dest, (const u8 *)indexed, length, (const u32 *)clut, outAlphaSum);
+			return;
+		} else if (sizeof(IndexT) == 1) {
 			for (int i = 0; i < length; ++i) {
 				ClutT color = clut[*indexed++];
 				alphaSum &= color;
@@ -149,39 +168,30 @@ inline void DeIndexTexture4(/*WRITEONLY*/ ClutT *dest, const u8 *indexed, int le
 	// Usually, there is no special offset, mask, or shift.
 	const bool nakedIndex = gstate.isClutIndexSimple();
 
-	ClutT alphaSum = (ClutT)(-1);
 	if (nakedIndex) {
-		while (length >= 2) {
-			u8 index = *indexed++;
-			ClutT color0 = clut[index & 0xf];
-			ClutT color1 = clut[index >> 4];
-			*dest++ = color0;
-			*dest++ = color1;
-			alphaSum &= color0 & color1;
-			length -= 2;
-		}
-		if (length) {  // Last pixel. Can really only happen in 1xY textures, but making this work generically.
-			u8 index = *indexed++;
-			ClutT color0 = clut[index & 0xf];
-			*dest = color0;
-			alphaSum &= color0;
-		}
-	} else {
-		while (length >= 2) {
-			u8 index = *indexed++;
-			ClutT color0 = clut[gstate.transformClutIndex((index >> 0) & 0xf)];
-			ClutT color1 = clut[gstate.transformClutIndex((index >> 4) & 0xf)];
-			*dest++ = color0;
-			*dest++ = color1;
-			alphaSum &= color0 & color1;
-			length -= 2;
-		}
-		if (length) {
-			u8 index = *indexed++;
-			ClutT color0 = clut[gstate.transformClutIndex((index >> 0) & 0xf)];
-			*dest = color0;
-			alphaSum &= color0;
+		if (sizeof(ClutT) == 2) {
+			textureDecodeFuncs.deIndex4To16((u16 *)dest, indexed, length, (const u16 *)clut, outAlphaSum);
+		} else {
+			textureDecodeFuncs.deIndex4To32((u32 *)dest, indexed, length, (const u32 *)clut, outAlphaSum);
 		}
+		return;
+	}
+
+	ClutT alphaSum = (ClutT)(-1);
+	while (length >= 2) {
+		u8 index = *indexed++;
+		ClutT color0 = clut[gstate.transformClutIndex((index >> 0) & 0xf)];
+		ClutT color1 = clut[gstate.transformClutIndex((index >> 4) & 0xf)];
+		*dest++ = color0;
+		*dest++ = color1;
+		alphaSum &= color0 & color1;
+		length -= 2;
+	}
+	if (length) {
+		u8 index = *indexed++;
+		ClutT color0 = clut[gstate.transformClutIndex((index >> 0) & 0xf)];
+		*dest = color0;
+		alphaSum &= color0;
 	}
 
 	*outAlphaSum &= (u32)alphaSum;
@@ -1440,6 +1440,11 @@ void VertexDecoder::SetVertexType(u32 fmt, const VertexDecoderOptions &options,
 			WARN_LOG(Log::G3D, "Vertex decoder JIT failed! fmt = %08x (%s)", fmt_, GetString(SHADER_STRING_SHORT_DESC).c_str());
 		}
 	}
+
+	// Without a JIT, the unrolled decoders still beat stitching together step functions by a lot.
+	if (!jitted_ && !options.disableUnrolledDecoders) {
+		jitted_ = GetUnrolledVertexDecoder(fmt_, options);
+	}
 }
 
 void VertexDecoder::DecodeVerts(u8 *decodedptr, const u8 *startPtr, const UVScale *uvScaleOffset, int count) const {
@@ -341,6 +341,8 @@ typedef void (*JittedVertexDecoder)(const u8 *src, u8 *dst, int count, const UVS
 struct VertexDecoderOptions {
 	bool expandAllWeightsToFloat;
 	bool expand8BitNormalsToFloat;
+	// Forces the step functions when there's no JIT, instead of the unrolled decoders. For testing.
+	bool disableUnrolledDecoders;
 };
 
 inline uint32_t GetVertTypeID(uint32_t vertType, int uvGenMode, bool skinInDecode) {
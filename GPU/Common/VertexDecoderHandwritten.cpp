@@ -1,9 +1,16 @@
+#include <algorithm>
+#include <cstring>
+
 #include "Common/CommonTypes.h"
 #include "Common/Data/Convert/ColorConv.h"
+#include "Core/HDRemaster.h"
 #include "GPU/Common/VertexDecoderCommon.h"
+#include "GPU/Common/VertexDecoderHandwritten.h"
+#include "GPU/ge_constants.h"
 #include "GPU/GPUState.h"
 
 #include "Common/Math/SIMDHeaders.h"
+#include "Common/Math/CrossSIMD.h"
 
 // Candidates for hand-writing
 // (found using our custom Very Sleepy).
@@ -295,3 +302,234 @@ void VtxDec_Tu8_C5551_Ps16(const u8 *srcp, u8 *dstp, int numVerts, const UVScale
 
 	gstate_c.vertexFullAlpha = (alpha >> 15) & 1;
 }
+
+// Fully unrolled, compile-time specialized decoders. These cover the remaining common formats
+// (see the list at the top of this file) on platforms where we have no vertex JIT, like IR-only
+// builds. The output must match the step functions exactly - only non-morph, non-weighted formats
+// are handled, and the UV gen mode must either be through or prescale.
+
+namespace {
+
+// Source sizes, indexed by the vtype component fields. Alignment equals the element size.
+constexpr int unrolledTcSize[4] = { 0, 2, 4, 8 };
+constexpr int unrolledTcAlign[4] = { 0, 1, 2, 4 };
+constexpr int unrolledColSize[8] = { 0, 0, 0, 0, 2, 2, 2, 4 };
+// Shared by normals and positions.
+constexpr int unrolledVec3Size[4] = { 0, 3, 6, 12 };
+constexpr int unrolledVec3Align[4] = { 0, 1, 2, 4 };
+// Decoded normal sizes (DEC_S8_3, DEC_S16_3, DEC_FLOAT_3).
+constexpr int unrolledDecNrmSize[4] = { 0, 4, 8, 12 };
+
+constexpr int UnrolledAlign(int n, int a) {
+	return a > 1 ? ((n + a - 1) & ~(a - 1)) : n;
+}
+
+constexpr int UnrolledMax(int a, int b) {
+	return a > b ? a : b;
+}
+
+// Mirrors the offset computations in VertexDecoder::SetVertexType.
+template <int tc, int col, int nrm, int pos>
+struct UnrolledLayout {
+	static constexpr int tcOff = 0;
+	static constexpr int colOff = UnrolledAlign(tcOff + unrolledTcSize[tc], unrolledColSize[col]);
+	static constexpr int nrmOff = UnrolledAlign(colOff + unrolledColSize[col], unrolledVec3Align[nrm]);
+	static constexpr int posOff = UnrolledAlign(nrmOff + unrolledVec3Size[nrm], unrolledVec3Align[pos]);
+	static constexpr int biggest = UnrolledMax(UnrolledMax(unrolledTcAlign[tc], unrolledColSize[col]), UnrolledMax(unrolledVec3Align[nrm], unrolledVec3Align[pos]));
+	static constexpr int size = UnrolledAlign(posOff + unrolledVec3Size[pos], biggest);
+
+	static constexpr int decUVOff = 0;
+	static constexpr int decColOff = decUVOff + (tc ? 8 : 0);
+	static constexpr int decNrmOff = decColOff + (col ? 4 : 0);
+	static constexpr int decPosOff = decNrmOff + unrolledDecNrmSize[nrm];
+	static constexpr int stride = decPosOff + 12;
+};
+
+}  // namespace
+
+template <int tc, int col, int nrm, int pos, bool through>
+static void VtxDec_Unrolled(const u8 *src, u8 *dst, int count, const UVScale *uvScaleOffset) {
+	typedef UnrolledLayout<tc, col, nrm, pos> L;
+	static_assert(pos != 0, "Position is required");
+	static_assert(!through || tc != 1, "8-bit through UVs are not handled");
+
+	constexpr float tcNorm = tc == 1 ? 1.0f / 128.0f : (tc == 2 ? 1.0f / 32768.0f : 1.0f);
+	const float uscale = through ? 1.0f : uvScaleOffset->uScale;
+	const float vscale = through ? 1.0f : uvScaleOffset->vScale;
+	const float uoff = through ? 0.0f : uvScaleOffset->uOff;
+	const float voff = through ? 0.0f : uvScaleOffset->vOff;
+
+	bool fullAlpha = true;
+	KnownVertexBounds bounds = gstate_c.vertBounds;
+
+	for (int i = 0; i < count; i++) {
+		if constexpr (tc != 0) {
+			float *uv = (float *)(dst + L::decUVOff);
+			float u, v;
+			if constexpr (tc == 1) {
+				u = (float)src[L::tcOff];
+				v = (float)src[L::tcOff + 1];
+			} else if constexpr (tc == 2) {
+				const u16_le *uvdata = (const u16_le *)(src + L::tcOff);
+				u = (float)uvdata[0];
+				v = (float)uvdata[1];
+			} else {
+				const float_le *uvdata = (const float_le *)(src + L::tcOff);
+				u = uvdata[0];
+				v = uvdata[1];
+			}
+			if constexpr (through) {
+				uv[0] = u;
+				uv[1] = v;
+				bounds.minU = std::min(bounds.minU, (u16)u);
+				bounds.maxU = std::max(bounds.maxU, (u16)u);
+				bounds.minV = std::min(bounds.minV, (u16)v);
+				bounds.maxV = std::max(bounds.maxV, (u16)v);
+			} else {
+				uv[0] = u * tcNorm * uscale + uoff;
+				uv[1] = v * tcNorm * vscale + voff;
+			}
+		}
+
+		if constexpr (col != 0) {
+			u32 *c = (u32 *)(dst + L::decColOff);
+			if constexpr (col == 7) {
+				u32 cdata;
+				memcpy(&cdata, src + L::colOff, 4);
+				fullAlpha = fullAlpha && (cdata >> 24) == 0xFF;
+				*c = cdata;
+			} else {
+				u16 cdata = *(const u16_le *)(src + L::colOff);
+				if constexpr (col == 4) {
+					*c = RGB565ToRGBA8888(cdata);
+				} else if constexpr (col == 5) {
+					fullAlpha = fullAlpha && (cdata >> 15) != 0;
+					*c = RGBA5551ToRGBA8888(cdata);
+				} else {
+					fullAlpha = fullAlpha && (cdata >> 12) == 0xF;
+					*c = RGBA4444ToRGBA8888(cdata);
+				}
+			}
+		}
+
+		if constexpr (nrm == 1) {
+			s8 *normal = (s8 *)(dst + L::decNrmOff);
+			const s8 *sv = (const s8 *)(src + L::nrmOff);
+			normal[0] = sv[0];
+			normal[1] = sv[1];
+			normal[2] = sv[2];
+			normal[3] = 0;
+		} else if constexpr (nrm == 2) {
+			s16 *normal = (s16 *)(dst + L::decNrmOff);
+			const s16_le *sv = (const s16_le *)(src + L::nrmOff);
+			normal[0] = sv[0];
+			normal[1] = sv[1];
+			normal[2] = sv[2];
+			normal[3] = 0;
+		} else if constexpr (nrm == 3) {
+			memcpy(dst + L::decNrmOff, src + L::nrmOff, 12);
+		}
+
+		float *v = (float *)(dst + L::decPosOff);
+		if constexpr (pos == 1) {
+			const s8 *sv = (const s8 *)(src + L::posOff);
+			if constexpr (through) {
+				// 8-bit positions in throughmode always decode to 0, depth included.
+				v[0] = 0.0f;
+				v[1] = 0.0f;
+				v[2] = 0.0f;
+			} else {
+				v[0] = sv[0] * (1.0f / 128.0f);
+				v[1] = sv[1] * (1.0f / 128.0f);
+				v[2] = sv[2] * (1.0f / 128.0f);
+			}
+		} else if constexpr (pos == 2) {
+			const s16_le *sv = (const s16_le *)(src + L::posOff);
+			if constexpr (through) {
+				v[0] = sv[0];
+				v[1] = sv[1];
+				v[2] = (u16)sv[2];
+			} else {
+				v[0] = sv[0] * (1.0f / 32768.0f);
+				v[1] = sv[1] * (1.0f / 32768.0f);
+				v[2] = sv[2] * (1.0f / 32768.0f);
+			}
+		} else {
+			const float *fv = (const float *)(src + L::posOff);
+			if constexpr (through) {
+				v[0] = fv[0];
+				v[1] = fv[1];
+				v[2] = fv[2] > 65535.0f ? 65535.0f : (fv[2] < 0.0f ? 0.0f : fv[2]);
+			} else {
+				Vec4F32::Load(fv).CleanNaNInfs().Store3(v);
+			}
+		}
+
+		src += L::size;
+		dst += L::stride;
+	}
+
+	if constexpr (col != 0 && col != 4) {
+		if (!fullAlpha) {
+			gstate_c.vertexFullAlpha = false;
+		}
+	}
+	if constexpr (through && tc != 0) {
+		gstate_c.vertBounds = bounds;
+	}
+}
+
+struct UnrolledVertexDecoder {
+	u32 vtype;
+	JittedVertexDecoder func;
+};
+
+#define UNROLLED_DECODER(tc, col, nrm, pos, through) \
+	{ (tc) | (col) | (nrm) | (pos) | ((through) ? GE_VTYPE_THROUGH : 0), \
+	  &VtxDec_Unrolled<((tc) >> GE_VTYPE_TC_SHIFT), ((col) >> GE_VTYPE_COL_SHIFT), ((nrm) >> GE_VTYPE_NRM_SHIFT), ((pos) >> GE_VTYPE_POS_SHIFT), (through)> }
+
+// The most common formats seen in frame dumps (see the list at the top of this file), plus the
+// usual 2D formats used for UI and post-processing in through mode.
+static const UnrolledVertexDecoder unrolledDecoders[] = {
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_8888, GE_VTYPE_NRM_8BIT, GE_VTYPE_POS_FLOAT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_8BIT, GE_VTYPE_COL_5551, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_8BIT, GE_VTYPE_COL_565, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_FLOAT, GE_VTYPE_COL_8888, GE_VTYPE_NRM_8BIT, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_NONE, GE_VTYPE_NRM_8BIT, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_5551, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_NONE, GE_VTYPE_COL_NONE, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_FLOAT, GE_VTYPE_COL_8888, GE_VTYPE_NRM_FLOAT, GE_VTYPE_POS_FLOAT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_NONE, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_FLOAT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_FLOAT, GE_VTYPE_COL_NONE, GE_VTYPE_NRM_FLOAT, GE_VTYPE_POS_FLOAT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_NONE, GE_VTYPE_COL_8888, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_FLOAT, false),
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_8888, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, true),
+	UNROLLED_DECODER(GE_VTYPE_TC_16BIT, GE_VTYPE_COL_NONE, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, true),
+	UNROLLED_DECODER(GE_VTYPE_TC_FLOAT, GE_VTYPE_COL_8888, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_FLOAT, true),
+	UNROLLED_DECODER(GE_VTYPE_TC_NONE, GE_VTYPE_COL_8888, GE_VTYPE_NRM_NONE, GE_VTYPE_POS_16BIT, true),
+};
+
+#undef UNROLLED_DECODER
+
+JittedVertexDecoder GetUnrolledVertexDecoder(u32 vertTypeID, const VertexDecoderOptions &options) {
+	if (g_DoubleTextureCoordinates) {
+		return nullptr;
+	}
+	if (options.expand8BitNormalsToFloat && (vertTypeID & GE_VTYPE_NRM_MASK) == GE_VTYPE_NRM_8BIT) {
+		return nullptr;
+	}
+
+	// Index format and the skin flag don't affect decoding (none of these have weights).
+	u32 key = vertTypeID & 0x00FFFFFF & ~GE_VTYPE_IDX_MASK;
+	GETexMapMode uvGenMode = VertTypeIDUVGenMode(vertTypeID);
+	bool prescale = uvGenMode == GE_TEXMAP_TEXTURE_COORDS || uvGenMode == GE_TEXMAP_UNKNOWN;
+	if ((key & GE_VTYPE_TC_MASK) != 0 && !(key & GE_VTYPE_THROUGH) && !prescale) {
+		return nullptr;
+	}
+
+	for (const auto &entry : unrolledDecoders) {
+		if (entry.vtype == key) {
+			return entry.func;
+		}
+	}
+	return nullptr;
+}
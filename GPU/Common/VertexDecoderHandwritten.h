@@ -5,3 +5,8 @@
 
 void VtxDec_Tu16_C8888_Pfloat(const u8 *srcp, u8 *dstp, int count, const UVScale *uvScaleOffset);
 void VtxDec_Tu8_C5551_Ps16(const u8 *srcp, u8 *dstp, int count, const UVScale *uvScaleOffset);
+
+// Compile-time specialized decoders for a fixed list of common formats. Portable C++, so unlike
+// the above they're also used where there's neither SIMD nor a vertex JIT. Returns nullptr if
+// vertTypeID isn't covered.
+JittedVertexDecoder GetUnrolledVertexDecoder(u32 vertTypeID, const VertexDecoderOptions &options);
@@ -21,6 +21,12 @@
 #include "Common/GraphicsContext.h"
 #include "Common/Profiler/Profiler.h"
 #include "Common/Data/Text/StringWriter.h"
+#include "Common/File/FileUtil.h"
+
+#include "Core/Config.h"
+#include "Core/Core.h"
+#include "Core/ELF/ParamSFO.h"
+#include "Core/System.h"
 
 #include "GPU/GPUState.h"
 
@@ -74,9 +80,29 @@ GPU_D3D11::GPU_D3D11(GraphicsContext *gfxCtx, Draw::DrawContext *draw)
 	// Some of our defaults are different from hw defaults, let's assert them.
 	// We restore each frame anyway, but here is convenient for tests.
 	textureCache_->NotifyConfigChanged();
+
+	// D3D11 has no shader cache of its own, so use the shared shader ID cache. The shaders
+	// are compiled in the background while the game boots.
+	std::string discID = g_paramSFO.GetDiscID();
+	if (discID.size()) {
+		if (g_Config.bShaderCache) {
+			File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+			shaderCachePath_ = GetSysDirectory(DIRECTORY_APP_CACHE) / (discID + ".d3d11shadercache");
+			shaderManagerD3D11_->LoadShaderIDCache(shaderCachePath_);
+		} else {
+			INFO_LOG(Log::G3D, "Shader cache disabled. Not loading.");
+		}
+	}
 }
 
 GPU_D3D11::~GPU_D3D11() {
+	if (shaderCachePath_.Valid()) {
+		if (g_Config.bShaderCache) {
+			shaderManagerD3D11_->SaveShaderIDCache(shaderCachePath_);
+		} else {
+			INFO_LOG(Log::G3D, "Shader cache disabled. Not saving.");
+		}
+	}
 }
 
 u32 GPU_D3D11::CheckGPUFeatures() const {
@@ -116,6 +142,12 @@ void GPU_D3D11::BeginHostFrame(const DisplayLayoutConfig &config) {
 	textureCache_->StartFrame();
 	drawEngine_.BeginFrame();
 
+	// Save the cache from time to time, like GLES. We save on exit too.
+	constexpr int saveShaderCacheFrameInterval = 32767;  // power of 2 - 1. About every 10 minutes at 60fps.
+	if (shaderCachePath_.Valid() && !(gpuStats.totals.numFlips & saveShaderCacheFrameInterval) && coreState == CORE_RUNNING_CPU) {
+		shaderManagerD3D11_->SaveShaderIDCache(shaderCachePath_);
+	}
+	shaderManagerD3D11_->AdoptPrewarmedShaders();
 	shaderManager_->DirtyLastShader();
 
 	framebufferManager_->BeginFrame(config);
@@ -23,6 +23,7 @@
 #include "Common/CommonWindows.h"
 #include <d3d11.h>
 
+#include "Common/File/Path.h"
 #include "GPU/GPUCommonHW.h"
 #include "GPU/D3D11/DrawEngineD3D11.h"
 #include "GPU/Common/VertexDecoderCommon.h"
@@ -56,4 +57,6 @@ class GPU_D3D11 : public GPUCommonHW {
 	TextureCacheD3D11 *textureCacheD3D11_;
 	DrawEngineD3D11 drawEngine_;
 	ShaderManagerD3D11 *shaderManagerD3D11_;
+
+	Path shaderCachePath_;
 };
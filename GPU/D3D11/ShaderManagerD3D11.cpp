@@ -21,6 +21,7 @@
 #include <D3Dcompiler.h>
 
 #include <map>
+#include <memory>
 
 #include "Common/GPU/thin3d.h"
 #include "Common/Log.h"
@@ -125,6 +126,16 @@ void ShaderManagerD3D11::DeviceRestore(Draw::DrawContext *draw) {
 }
 
 void ShaderManagerD3D11::Clear() {
+	StopPrewarm();
+	for (const auto &[_, fs] : prewarmedFS_) {
+		delete fs;
+	}
+	for (const auto &[_, vs] : prewarmedVS_) {
+		delete vs;
+	}
+	prewarmedFS_.clear();
+	prewarmedVS_.clear();
+
 	for (const auto &[_, fs] : fsCache_) {
 		delete fs;
 	}
@@ -213,9 +224,15 @@ void ShaderManagerD3D11::GetShaders(int prim, u32 vertexType, D3D11VertexShader
 	}
 
 	VSCache::iterator vsIter = vsCache_.find(VSID);
+	if (vsIter == vsCache_.end()) {
+		// The prewarm task might have it ready.
+		AdoptPrewarmedShaders();
+		vsIter = vsCache_.find(VSID);
+	}
 	D3D11VertexShader *vs;
 	if (vsIter == vsCache_.end()) {
 		// Vertex shader not in cache. Let's compile it.
+		CountShaderCompile();
 		std::string genErrorString;
 		uint32_t attrMask;
 		uint64_t uniformMask;
@@ -231,9 +248,14 @@ void ShaderManagerD3D11::GetShaders(int prim, u32 vertexType, D3D11VertexShader
 	lastVSID_ = VSID;
 
 	FSCache::iterator fsIter = fsCache_.find(FSID);
+	if (fsIter == fsCache_.end()) {
+		AdoptPrewarmedShaders();
+		fsIter = fsCache_.find(FSID);
+	}
 	D3D11FragmentShader *fs;
 	if (fsIter == fsCache_.end()) {
 		// Fragment shader not in cache. Let's compile it.
+		CountShaderCompile();
 		std::string genErrorString;
 		uint64_t uniformMask;
 		FragmentShaderFlags flags;
@@ -260,6 +282,81 @@ void ShaderManagerD3D11::GetShaders(int prim, u32 vertexType, D3D11VertexShader
 	*fshader = fs;
 }
 
+bool ShaderManagerD3D11::PrewarmVertexShader(const VShaderID &id) {
+	// codeBuffer_ belongs to the render thread.
+	std::unique_ptr<char[]> code(new char[CODE_BUFFER_SIZE]);
+	std::string genErrorString;
+	uint32_t attrMask;
+	uint64_t uniformMask;
+	VertexShaderFlags flags;
+	if (!GenerateVertexShader(id, code.get(), draw_->GetShaderLanguageDesc(), draw_->GetBugs(), &attrMask, &uniformMask, &flags, &genErrorString)) {
+		return false;
+	}
+	// ID3D11Device is free-threaded, so we can create the shader right here.
+	D3D11VertexShader *vs = new D3D11VertexShader(device_, featureLevel_, id, code.get(), id.Bit(VS_BIT_USE_HW_TRANSFORM));
+	if (vs->Failed()) {
+		delete vs;
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(prewarmLock_);
+	prewarmedVS_.emplace_back(id, vs);
+	return true;
+}
+
+bool ShaderManagerD3D11::PrewarmFragmentShader(const FShaderID &id) {
+	std::unique_ptr<char[]> code(new char[CODE_BUFFER_SIZE]);
+	std::string genErrorString;
+	uint64_t uniformMask;
+	FragmentShaderFlags flags;
+	if (!GenerateFragmentShader(id, code.get(), draw_->GetShaderLanguageDesc(), draw_->GetBugs(), &uniformMask, &flags, &genErrorString)) {
+		return false;
+	}
+	D3D11FragmentShader *fs = new D3D11FragmentShader(device_, featureLevel_, id, code.get(), true);
+	if (fs->Failed()) {
+		delete fs;
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(prewarmLock_);
+	prewarmedFS_.emplace_back(id, fs);
+	return true;
+}
+
+void ShaderManagerD3D11::AdoptPrewarmedShaders() {
+	std::lock_guard<std::mutex> guard(prewarmLock_);
+	int count = 0;
+	for (const auto &[id, vs] : prewarmedVS_) {
+		// If the game got to it first, the one we compiled on demand wins.
+		if (vsCache_.emplace(id, vs).second) {
+			count++;
+		} else {
+			delete vs;
+		}
+	}
+	for (const auto &[id, fs] : prewarmedFS_) {
+		if (fsCache_.emplace(id, fs).second) {
+			count++;
+		} else {
+			delete fs;
+		}
+	}
+	prewarmedVS_.clear();
+	prewarmedFS_.clear();
+	CountPrewarmedShaders(count);
+}
+
+void ShaderManagerD3D11::GetShaderIDsForCache(std::vector<VShaderID> *vsids, std::vector<FShaderID> *fsids) {
+	for (const auto &[id, vs] : vsCache_) {
+		if (!vs->Failed()) {
+			vsids->push_back(id);
+		}
+	}
+	for (const auto &[id, fs] : fsCache_) {
+		if (!fs->Failed()) {
+			fsids->push_back(id);
+		}
+	}
+}
+
 std::vector<std::string> ShaderManagerD3D11::DebugGetShaderIDs(DebugShaderType type) {
 	std::string id;
 	std::vector<std::string> ids;
@@ -18,6 +18,9 @@
 #pragma once
 
 #include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <d3d11.h>
 #include <wrl/client.h>
@@ -103,6 +106,9 @@ class ShaderManagerD3D11 : public ShaderManagerCommon {
 	std::vector<std::string> DebugGetShaderIDs(DebugShaderType type) override;
 	std::string DebugGetShaderString(std::string id, DebugShaderType type, DebugShaderStringType stringType) override;
 
+	// Moves shaders compiled by the prewarm task into the caches. Call once per frame.
+	void AdoptPrewarmedShaders();
+
 	uint64_t UpdateUniforms(bool useBufferedRendering);
 	void BindUniforms();
 
@@ -112,6 +118,11 @@ class ShaderManagerD3D11 : public ShaderManagerCommon {
 	bool IsLightDirty() { return true; }
 	bool IsBoneDirty() { return true; }
 
+protected:
+	bool PrewarmVertexShader(const VShaderID &id) override;
+	bool PrewarmFragmentShader(const FShaderID &id) override;
+	void GetShaderIDsForCache(std::vector<VShaderID> *vsids, std::vector<FShaderID> *fsids) override;
+
 private:
 	void Clear();
 
@@ -127,6 +138,11 @@ class ShaderManagerD3D11 : public ShaderManagerCommon {
 
 	char *codeBuffer_;
 
+	// Filled by the prewarm task, adopted into the caches on the render thread.
+	std::mutex prewarmLock_;
+	std::vector<std::pair<VShaderID, D3D11VertexShader *>> prewarmedVS_;
+	std::vector<std::pair<FShaderID, D3D11FragmentShader *>> prewarmedFS_;
+
 	// Uniform block scratchpad. These (the relevant ones) are copied to the current pushbuffer at draw time.
 	UB_VS_FS_Base ub_base;
 	UB_VS_Lights ub_lights;
@@ -136,6 +136,7 @@ TextureCacheD3D11::TextureCacheD3D11(Draw::DrawContext *draw, Draw2D *draw2D)
 	context_ = (ID3D11DeviceContext *)draw->GetNativeObject(Draw::NativeObject::CONTEXT);
 
 	lastBoundTexture_ = D3D11_INVALID_TEX;
+	partialUpdatesSupported_ = true;
 
 	InitDeviceObjects();
 }
@@ -465,6 +466,35 @@ DXGI_FORMAT GetClutDestFormatD3D11(GEPaletteFormat format) {
 	return DXGI_FORMAT_B8G8R8A8_UNORM;
 }
 
+bool TextureCacheD3D11::UpdateTextureRows(TexCacheEntry *entry, int y, int h) {
+	ID3D11Resource *texture = DxTex(entry);
+	if (!texture) {
+		return false;
+	}
+
+	DXGI_FORMAT dstFmt = GetDestFormat(GETextureFormat(entry->format), gstate.getClutPaletteFormat());
+	int w = gstate.getTextureWidth(0);
+	int bpp = dstFmt == DXGI_FORMAT_B8G8R8A8_UNORM ? 4 : 2;
+	int stride = std::max(w * bpp, 16);
+	u8 *data = (u8 *)AllocateAlignedMemory(stride * h, 16);
+	if (!data) {
+		return false;
+	}
+
+	DecodeTextureRows(entry, data, stride, y, h, FromD3D11Format(dstFmt), TexDecodeFlags{});
+
+	D3D11_BOX box{};
+	box.left = 0;
+	box.right = w;
+	box.top = y;
+	box.bottom = y + h;
+	box.front = 0;
+	box.back = 1;
+	context_->UpdateSubresource(texture, 0, &box, data, stride, 0);
+	FreeAlignedMemory(data);
+	return true;
+}
+
 DXGI_FORMAT TextureCacheD3D11::GetDestFormat(GETextureFormat format, GEPaletteFormat clutFormat) const {
 	if (!gstate_c.Use(GPU_USE_16BIT_FORMATS)) {
 		return DXGI_FORMAT_B8G8R8A8_UNORM;
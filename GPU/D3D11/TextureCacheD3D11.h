@@ -76,6 +76,7 @@ class TextureCacheD3D11 : public TextureCacheCommon {
 	void UpdateCurrentClut(GEPaletteFormat clutFormat, u32 clutBase, bool clutIndexIsSimple) override;
 
 	void BuildTexture(TexCacheEntry *const entry) override;
+	bool UpdateTextureRows(TexCacheEntry *entry, int y, int h) override;
 
 	ID3D11Device *device_;
 	ID3D11DeviceContext *context_;
@@ -16,6 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <mutex>
@@ -85,6 +86,15 @@ static std::string lastExecFilename;
 static uint32_t lastExecVersion;
 static std::vector<Command> lastExecCommands;
 static std::vector<u8> lastExecPushbuf;
+// Frames of the dump. The pushbuf data of each is only decompressed once a replayed frame needs it.
+static std::vector<FrameChunk> lastExecChunks;
+static std::vector<std::vector<u8>> lastExecChunkBufs;
+static std::vector<bool> lastExecChunkLoaded;
+// lastExecChunks.size() for other threads (the debugger), which can't look at the vector itself.
+static std::atomic<int> lastExecFrameCount;
+// Commands of the frame currently being replayed.
+static std::vector<Command> lastExecFrameCommands;
+static std::atomic<int> lastExecFrame;
 
 // This thread is restarted every frame (dump execution) for simplicity. TODO: Make persistent?
 // Alternatively, get rid of it, but the code is written in a way that makes it difficult (you'll see if you try).
@@ -844,12 +854,100 @@ static bool ReadCompressed(u32 fp, void *dest, size_t sz, uint32_t version) {
 	return real_size == sz;
 }
 
+static bool ReadChunkedReplay(u32 fp) {
+	u32 numChunks = 0;
+	pspFileSystem.ReadFile(fp, (u8 *)&numChunks, sizeof(numChunks));
+	u32 sz = 0;
+	pspFileSystem.ReadFile(fp, (u8 *)&sz, sizeof(sz));
+	u32 bufsz = 0;
+	pspFileSystem.ReadFile(fp, (u8 *)&bufsz, sizeof(bufsz));
+	if (numChunks == 0)
+		return false;
+
+	lastExecChunks.resize(numChunks);
+	size_t indexSize = sizeof(FrameChunk) * numChunks;
+	if (pspFileSystem.ReadFile(fp, (u8 *)lastExecChunks.data(), indexSize) != indexSize)
+		return false;
+
+	lastExecCommands.resize(sz);
+	lastExecPushbuf.resize(bufsz);
+	lastExecChunkBufs.clear();
+	lastExecChunkBufs.resize(numChunks);
+	lastExecChunkLoaded.assign(numChunks, false);
+
+	// Commands are small, so we decompress them all now. Data waits until a frame uses it.
+	std::vector<u8> compressed;
+	for (u32 i = 0; i < numChunks; ++i) {
+		const FrameChunk &chunk = lastExecChunks[i];
+		if (chunk.firstCommand + chunk.numCommands > sz || chunk.bufStart + chunk.bufSize > bufsz)
+			return false;
+
+		// The file system only seeks with 32-bit offsets. Dumps this big aren't realistic anyway.
+		if (chunk.fileOffset > 0x7FFFFFFF) {
+			ERROR_LOG(Log::GeDebugger, "GE dump chunk at offset %llx, files over 2GB are not supported", (unsigned long long)chunk.fileOffset);
+			return false;
+		}
+		pspFileSystem.SeekFile(fp, (s32)chunk.fileOffset, FILEMOVE_BEGIN);
+		compressed.resize(chunk.commandsCompressedSize);
+		if (pspFileSystem.ReadFile(fp, compressed.data(), compressed.size()) != compressed.size())
+			return false;
+
+		size_t commandBytes = chunk.numCommands * sizeof(Command);
+		if (ZSTD_decompress(lastExecCommands.data() + chunk.firstCommand, commandBytes, compressed.data(), compressed.size()) != commandBytes)
+			return false;
+
+		std::vector<u8> &buf = lastExecChunkBufs[i];
+		buf.resize(chunk.bufCompressedSize);
+		if (pspFileSystem.ReadFile(fp, buf.data(), buf.size()) != buf.size())
+			return false;
+	}
+
+	return true;
+}
+
+static bool LoadChunkBuf(size_t i) {
+	if (lastExecChunkLoaded[i])
+		return true;
+
+	const FrameChunk &chunk = lastExecChunks[i];
+	const std::vector<u8> &compressed = lastExecChunkBufs[i];
+	size_t real_size = ZSTD_decompress(lastExecPushbuf.data() + chunk.bufStart, chunk.bufSize, compressed.data(), compressed.size());
+	if (real_size != chunk.bufSize)
+		return false;
+
+	lastExecChunkLoaded[i] = true;
+	std::vector<u8>().swap(lastExecChunkBufs[i]);
+	return true;
+}
+
+// Makes sure all the data a frame refers to (possibly stored with earlier frames) is decompressed.
+static bool PrepareReplayFrame(int frame) {
+	const FrameChunk &frameChunk = lastExecChunks[frame];
+	for (u32 i = 0; i < frameChunk.numCommands; ++i) {
+		const Command &cmd = lastExecCommands[frameChunk.firstCommand + i];
+		auto it = std::upper_bound(lastExecChunks.begin(), lastExecChunks.end(), cmd.ptr, [](u32 ptr, const FrameChunk &chunk) {
+			return ptr < chunk.bufStart;
+		});
+		size_t c = it == lastExecChunks.begin() ? 0 : it - lastExecChunks.begin() - 1;
+		for (; c < lastExecChunks.size(); ++c) {
+			if (!LoadChunkBuf(c))
+				return false;
+			if (lastExecChunks[c].bufStart + lastExecChunks[c].bufSize >= cmd.ptr + cmd.sz)
+				break;
+		}
+	}
+
+	lastExecFrameCommands.assign(lastExecCommands.begin() + frameChunk.firstCommand, lastExecCommands.begin() + frameChunk.firstCommand + frameChunk.numCommands);
+	return true;
+}
+
 static u32 LoadReplay(const std::string &filename) {
 	PROFILE_THIS_SCOPE("ReplayLoad");
 
 	NOTICE_LOG(Log::GeDebugger, "LoadReplay %s", filename.c_str());
 
 	g_cancelled = false;
+	lastExecFrameCount = 0;
 
 	u32 fp = pspFileSystem.OpenFile(filename, FILEACCESS_READ);
 	Header header;
@@ -882,17 +980,27 @@ static u32 LoadReplay(const std::string &filename) {
 		System_SetWindowTitle("(GE frame dump: old format, missing DISC_ID)");
 	}
 
-	u32 sz = 0;
-	pspFileSystem.ReadFile(fp, (u8 *)&sz, sizeof(sz));
-	u32 bufsz = 0;
-	pspFileSystem.ReadFile(fp, (u8 *)&bufsz, sizeof(bufsz));
-
-	lastExecCommands.resize(sz);
-	lastExecPushbuf.resize(bufsz);
-
 	bool truncated = false;
-	truncated = truncated || !ReadCompressed(fp, lastExecCommands.data(), sizeof(Command) * sz, header.version);
-	truncated = truncated || !ReadCompressed(fp, lastExecPushbuf.data(), bufsz, header.version);
+	if (header.version >= CHUNKED_VERSION) {
+		truncated = !ReadChunkedReplay(fp);
+	} else {
+		u32 sz = 0;
+		pspFileSystem.ReadFile(fp, (u8 *)&sz, sizeof(sz));
+		u32 bufsz = 0;
+		pspFileSystem.ReadFile(fp, (u8 *)&bufsz, sizeof(bufsz));
+
+		lastExecCommands.resize(sz);
+		lastExecPushbuf.resize(bufsz);
+
+		truncated = truncated || !ReadCompressed(fp, lastExecCommands.data(), sizeof(Command) * sz, header.version);
+		truncated = truncated || !ReadCompressed(fp, lastExecPushbuf.data(), bufsz, header.version);
+
+		// Older dumps are always a single frame, with everything loaded.
+		lastExecChunks.assign(1, FrameChunk{ 0, sz, 0, bufsz });
+		lastExecChunkBufs.clear();
+		lastExecChunkBufs.resize(1);
+		lastExecChunkLoaded.assign(1, true);
+	}
 
 	pspFileSystem.CloseFile(fp);
 
@@ -903,6 +1011,8 @@ static u32 LoadReplay(const std::string &filename) {
 
 	lastExecFilename = filename;
 	lastExecVersion = version;
+	lastExecFrame = 0;
+	lastExecFrameCount = (int)lastExecChunks.size();
 	return version;
 }
 
@@ -921,10 +1031,16 @@ void Replay_Unload() {
 
 	_dbg_assert_(!replayThread.joinable());
 
+	lastExecFrameCount = 0;
 	lastExecFilename.clear();
 	lastExecVersion = 0;
 	lastExecCommands.clear();
 	lastExecPushbuf.clear();
+	lastExecChunks.clear();
+	lastExecChunkBufs.clear();
+	lastExecChunkLoaded.clear();
+	lastExecFrameCommands.clear();
+	lastExecFrame = 0;
 
 	g_opDone = true;
 	g_retVal = 0;
@@ -988,9 +1104,14 @@ ReplayResult RunMountedReplay(const std::string &filename) {
 	if (!replayThread.joinable()) {
 		_dbg_assert_(g_opToExec.type == OpType::None);
 		g_opToExec = Operation{ OpType::None };
+		int frame = lastExecFrame;
+		if (frame >= (int)lastExecChunks.size() || !PrepareReplayFrame(frame)) {
+			ERROR_LOG(Log::GeDebugger, "Unable to load data for GE dump frame %d", frame);
+			return ReplayResult::Error;
+		}
 		replayThread = std::thread([version]() {
 			SetCurrentThreadName("Replay");
-			DumpExecute executor(lastExecPushbuf, lastExecCommands, version);
+			DumpExecute executor(lastExecPushbuf, lastExecFrameCommands, version);
 			GPURecord::ReplayResult retval = executor.Run();
 			// Finish up
 			ExecuteOnMain(Operation{ OpType::Done });
@@ -1056,6 +1177,10 @@ ReplayResult RunMountedReplay(const std::string &filename) {
 		}
 		replayThread.join();
 		g_opToExec = { OpType::None };
+
+		// Multi-frame dumps play each frame in turn, unless seeked in the meantime.
+		int frame = lastExecFrame;
+		lastExecFrame.compare_exchange_strong(frame, (frame + 1) % std::max((int)lastExecChunks.size(), 1));
 		break;
 	}
 	case OpType::None:
@@ -1064,4 +1189,14 @@ ReplayResult RunMountedReplay(const std::string &filename) {
 	return ReplayResult::Done;
 }
 
+int Replay_GetFrameCount() {
+	return lastExecFrameCount;
+}
+
+void Replay_SeekFrame(int frame) {
+	// The replay also checks the frame against the chunks before using it, in case a new dump was loaded since.
+	if (frame >= 0 && frame < lastExecFrameCount)
+		lastExecFrame = frame;
+}
+
 }  // namespace GPURecord
@@ -34,4 +34,9 @@ ReplayResult RunMountedReplay(const std::string &filename);
 // Will also cancel a currently running replay.
 void Replay_Unload();
 
+// Multi-frame dumps replay each frame in turn. Seeking applies from the next replayed frame.
+// These two are safe to call from any thread.
+int Replay_GetFrameCount();
+void Replay_SeekFrame(int frame);
+
 }  // namespace GPURecord
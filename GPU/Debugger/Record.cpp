@@ -45,6 +45,7 @@
 #include "GPU/Common/VertexDecoderCommon.h"
 #include "GPU/Debugger/Record.h"
 #include "GPU/Debugger/RecordFormat.h"
+#include "ext/xxhash.h"
 
 namespace GPURecord {
 
@@ -133,43 +134,63 @@ bool Recorder::BeginRecording() {
 
 	active = true;
 	nextFrame = false;
-	lastTextures.clear();
+	framesLeft = framesToRecord;
 	lastRenderTargets.clear();
+	knownBlocks.clear();
+	chunks.clear();
 	flipLastAction = gpuStats.totals.numFlips;
 	flipFinishAt = -1;
-
-	u32 ptr = (u32)pushbuf.size();
-	u32 sz = 512 * 4;
-	pushbuf.resize(pushbuf.size() + sz);
-	gstate.Save((u32_le *)(pushbuf.data() + ptr));
-	commands.push_back({ CommandType::INIT, sz, ptr });
 	lastVRAM.resize(2 * 1024 * 1024);
 
+	BeginFrameChunk();
+	return true;
+}
+
+void Recorder::BeginFrameChunk() {
+	FrameChunk chunk{};
+	chunk.firstCommand = (u32)commands.size();
+	chunk.bufStart = (u32)pushbuf.size();
+	chunks.push_back(chunk);
+
+	// Each frame starts with the full state, so it can be replayed on its own.
+	u32_le state[512];
+	gstate.Save(state);
+	EmitCommandWithRAM(CommandType::INIT, state, (u32)sizeof(state), 4);
+
 	// Also save the initial CLUT.
 	GPUDebugBuffer clut;
 	if (gpu->GetCurrentClut(clut)) {
-		sz = clut.GetStride() * clut.PixelSize();
+		u32 sz = clut.GetStride() * clut.PixelSize();
 		_assert_msg_(sz == 1024, "CLUT should be 1024 bytes");
-		ptr = (u32)pushbuf.size();
-		pushbuf.resize(pushbuf.size() + sz);
-		memcpy(pushbuf.data() + ptr, clut.GetData(), sz);
-		commands.push_back({ CommandType::CLUT, sz, ptr });
+		EmitCommandWithRAM(CommandType::CLUT, clut.GetData(), sz, 16);
 	}
 
+	// This also makes sure VRAM data is sent again in every frame.
 	DirtyAllVRAM(DirtyVRAMFlag::DIRTY);
-	return true;
 }
 
-static void WriteCompressed(FILE *fp, const void *p, size_t sz) {
-	size_t compressed_size = ZSTD_compressBound(sz);
-	u8 *compressed = new u8[compressed_size];
-	compressed_size = ZSTD_compress(compressed, compressed_size, p, sz, 6);
+void Recorder::EndFrameChunk() {
+	FlushRegisters();
+
+	FrameChunk &chunk = chunks.back();
+	chunk.numCommands = (u32)commands.size() - chunk.firstCommand;
+	chunk.bufSize = (u32)pushbuf.size() - chunk.bufStart;
+}
+
+// Returns true if the recording continues with another frame.
+bool Recorder::EndFrame() {
+	EndFrameChunk();
+	if (--framesLeft <= 0)
+		return false;
 
-	u32 write_size = (u32)compressed_size;
-	fwrite(&write_size, sizeof(write_size), 1, fp);
-	fwrite(compressed, compressed_size, 1, fp);
+	BeginFrameChunk();
+	return true;
+}
 
-	delete[] compressed;
+static void CompressChunkData(std::vector<u8> &out, const void *p, size_t sz) {
+	out.resize(ZSTD_compressBound(sz));
+	size_t compressed_size = ZSTD_compress(out.data(), out.size(), p, sz, 6);
+	out.resize(ZSTD_isError(compressed_size) ? 0 : compressed_size);
 }
 
 Path Recorder::WriteRecording() {
@@ -177,7 +198,26 @@ Path Recorder::WriteRecording() {
 
 	const Path filename = GenRecordingFilename();
 
-	NOTICE_LOG(Log::G3D, "Recording filename: %s", filename.c_str());
+	NOTICE_LOG(Log::G3D, "Recording filename: %s (%d frames)", filename.c_str(), (int)chunks.size());
+
+	// Each frame is compressed separately, so playback only needs to decompress the frames it runs.
+	std::vector<std::vector<u8>> compressedCommands(chunks.size());
+	std::vector<std::vector<u8>> compressedBufs(chunks.size());
+	ParallelRangeLoop(&g_threadManager, [&](int l, int h) {
+		for (int i = l; i < h; ++i) {
+			const FrameChunk &chunk = chunks[i];
+			CompressChunkData(compressedCommands[i], commands.data() + chunk.firstCommand, chunk.numCommands * sizeof(Command));
+			CompressChunkData(compressedBufs[i], pushbuf.data() + chunk.bufStart, chunk.bufSize);
+		}
+	}, 0, (int)chunks.size(), 1, TaskPriority::HIGH);
+
+	u64 offset = sizeof(Header) + 3 * sizeof(u32) + chunks.size() * sizeof(FrameChunk);
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		chunks[i].commandsCompressedSize = (u32)compressedCommands[i].size();
+		chunks[i].bufCompressedSize = (u32)compressedBufs[i].size();
+		chunks[i].fileOffset = offset;
+		offset += chunks[i].commandsCompressedSize + chunks[i].bufCompressedSize;
+	}
 
 	FILE *fp = File::OpenCFile(filename, "wb");
 	Header header{};
@@ -186,13 +226,18 @@ Path Recorder::WriteRecording() {
 	strncpy(header.gameID, g_paramSFO.GetDiscID().c_str(), sizeof(header.gameID));
 	fwrite(&header, sizeof(header), 1, fp);
 
+	u32 numChunks = (u32)chunks.size();
+	fwrite(&numChunks, sizeof(numChunks), 1, fp);
 	u32 sz = (u32)commands.size();
 	fwrite(&sz, sizeof(sz), 1, fp);
 	u32 bufsz = (u32)pushbuf.size();
 	fwrite(&bufsz, sizeof(bufsz), 1, fp);
+	fwrite(chunks.data(), sizeof(FrameChunk), chunks.size(), fp);
 
-	WriteCompressed(fp, commands.data(), commands.size() * sizeof(Command));
-	WriteCompressed(fp, pushbuf.data(), bufsz);
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		fwrite(compressedCommands[i].data(), 1, compressedCommands[i].size(), fp);
+		fwrite(compressedBufs[i].data(), 1, compressedBufs[i].size(), fp);
+	}
 
 	fclose(fp);
 
@@ -272,21 +317,47 @@ static const u8 *mymemmem(const u8 *haystack, size_t off, size_t hlen, const u8
 	return result;
 }
 
+static u64 HashBlock(const void *p, u32 sz) {
+	return XXH3_64bits_withSeed(p, sz, sz);
+}
+
+const u8 *Recorder::FindKnownBlock(const void *p, u32 sz, u32 align) const {
+	auto it = knownBlocks.find(HashBlock(p, sz));
+	if (it == knownBlocks.end())
+		return nullptr;
+
+	u32 ptr = it->second;
+	if ((ptr & (align - 1)) != 0 || ptr + sz > pushbuf.size())
+		return nullptr;
+	if (memcmp(pushbuf.data() + ptr, p, sz) != 0)
+		return nullptr;
+	return pushbuf.data() + ptr;
+}
+
+void Recorder::RememberBlock(u32 ptr, u32 sz) {
+	// Keep the first position, it's the one most likely to already be loaded during playback.
+	knownBlocks.emplace(HashBlock(pushbuf.data() + ptr, sz), ptr);
+}
+
 Command Recorder::EmitCommandWithRAM(CommandType t, const void *p, u32 sz, u32 align) {
 	FlushRegisters();
 
 	Command cmd{ t, sz, 0 };
 
 	if (sz) {
-		// If at all possible, try to find it already in the buffer.
-		const u8 *prev = nullptr;
+		// Exact repeats (textures, vertices, often from previous frames) are found by hash.
+		const u8 *prev = FindKnownBlock(p, sz, align);
+
+		// Otherwise, try to find it inside data already in this frame.
+		// Searching all previous frames too would get very slow for long recordings.
+		const size_t chunkStart = chunks.empty() ? 0 : chunks.back().bufStart;
 		const size_t NEAR_WINDOW = std::max((int)sz * 2, 1024 * 10);
 		// Let's try nearby first... it will often be nearby.
-		if (pushbuf.size() > NEAR_WINDOW) {
+		if (!prev && pushbuf.size() > chunkStart + NEAR_WINDOW) {
 			prev = mymemmem(pushbuf.data(), pushbuf.size() - NEAR_WINDOW, pushbuf.size(), (const u8 *)p, sz, align);
 		}
-		if (!prev) {
-			prev = mymemmem(pushbuf.data(), 0, pushbuf.size(), (const u8 *)p, sz, align);
+		if (!prev && pushbuf.size() >= chunkStart + sz) {
+			prev = mymemmem(pushbuf.data(), chunkStart, pushbuf.size(), (const u8 *)p, sz, align);
 		}
 
 		if (prev) {
@@ -304,6 +375,7 @@ Command Recorder::EmitCommandWithRAM(CommandType t, const void *p, u32 sz, u32 a
 			}
 			memcpy(pushbuf.data() + cmd.ptr, p, sz);
 		}
+		RememberBlock(cmd.ptr, sz);
 	}
 
 	commands.push_back(cmd);
@@ -427,24 +499,8 @@ void Recorder::EmitTextureData(int level, u32 texaddr) {
 	}
 
 	if (bytes > 0) {
-		FlushRegisters();
-
-		// Dumps are huge - let's try to find this already emitted.
-		for (u32 prevptr : lastTextures) {
-			if (pushbuf.size() < prevptr + bytes) {
-				continue;
-			}
-
-			if (memcmp(pushbuf.data() + prevptr, p, bytes) == 0) {
-				commands.push_back({ type, bytes, prevptr });
-				// Okay, that was easy.  Bail out.
-				return;
-			}
-		}
-
-		// Not there, gotta emit anew.
-		Command cmd = EmitCommandWithRAM(type, p, bytes, 16);
-		lastTextures.push_back(cmd.ptr);
+		// Dumps are huge, but this will reuse the data if it was already emitted.
+		EmitCommandWithRAM(type, p, bytes, 16);
 	}
 }
 
@@ -573,10 +629,11 @@ void Recorder::EmitBezierSpline(u32 op) {
 	DirtyDrawnVRAM();
 }
 
-bool Recorder::RecordNextFrame(const std::function<void(const Path &)> callback) {
+bool Recorder::RecordNextFrames(int frameCount, const std::function<void(const Path &)> callback) {
 	if (!nextFrame) {
 		flipLastAction = gpuStats.totals.numFlips;
 		flipFinishAt = -1;
+		framesToRecord = std::max(frameCount, 1);
 		writeCallback = callback;
 		nextFrame = true;
 		return true;
@@ -594,6 +651,8 @@ void Recorder::FinishRecording() {
 	commands.clear();
 	pushbuf.clear();
 	lastVRAM.clear();
+	chunks.clear();
+	knownBlocks.clear();
 
 	NOTICE_LOG(Log::System, "Recording finished");
 	active = false;
@@ -734,8 +793,10 @@ bool Recorder::HasDrawCommands() const {
 	if (commands.empty())
 		return false;
 
-	for (const Command &cmd : commands) {
-		switch (cmd.type) {
+	// Only look at the frame currently being recorded.
+	size_t first = chunks.empty() ? 0 : chunks.back().firstCommand;
+	for (size_t i = first; i < commands.size(); ++i) {
+		switch (commands[i].type) {
 		case CommandType::INIT:
 		case CommandType::DISPLAY:
 			continue;
@@ -779,8 +840,13 @@ void Recorder::NotifyDisplay(u32 framebuf, int stride, int fmt) {
 	commands.push_back({ CommandType::DISPLAY, sz, ptr });
 
 	if (writePending) {
-		NOTICE_LOG(Log::System, "Recording complete on display");
-		FinishRecording();
+		if (EndFrame()) {
+			// Don't let NotifyBeginFrame() think there was no display for a while.
+			flipLastAction = gpuStats.totals.numFlips;
+		} else {
+			NOTICE_LOG(Log::System, "Recording complete on display");
+			FinishRecording();
+		}
 	}
 }
 
@@ -788,8 +854,6 @@ void Recorder::NotifyBeginFrame() {
 	const bool noDisplayAction = flipLastAction + 4 < gpuStats.totals.numFlips;
 	// We do this only to catch things that don't call NotifyDisplay.
 	if (active && HasDrawCommands() && (noDisplayAction || gpuStats.totals.numFlips == flipFinishAt)) {
-		NOTICE_LOG(Log::System, "Recording complete on frame");
-
 		CheckEdramTrans();
 		struct DisplayBufData {
 			PSPPointer<u8> topaddr;
@@ -807,7 +871,12 @@ void Recorder::NotifyBeginFrame() {
 
 		commands.push_back({ CommandType::DISPLAY, sz, ptr });
 
-		FinishRecording();
+		if (EndFrame()) {
+			flipFinishAt = gpuStats.totals.numFlips + 1;
+		} else {
+			NOTICE_LOG(Log::System, "Recording complete on frame");
+			FinishRecording();
+		}
 	}
 	if (!active && nextFrame && (gstate_c.skipDrawReason & SKIPDRAW_SKIPFRAME) == 0 && noDisplayAction) {
 		NOTICE_LOG(Log::System, "Recording starting on frame...");
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "GPU/Debugger/RecordFormat.h"
@@ -48,7 +49,11 @@ class Recorder {
 	bool IsActivePending() const {
 		return nextFrame || active;
 	}
-	bool RecordNextFrame(const std::function<void(const Path &)> callback);
+	bool RecordNextFrame(const std::function<void(const Path &)> callback) {
+		return RecordNextFrames(1, callback);
+	}
+	// Records frameCount consecutive frames into a single dump, each replayable on its own.
+	bool RecordNextFrames(int frameCount, const std::function<void(const Path &)> callback);
 	void ClearCallback() {
 		// Not super thread safe..
 		writeCallback = nullptr;
@@ -68,6 +73,9 @@ class Recorder {
 	void DirtyDrawnVRAM();
 
 	bool BeginRecording();
+	void BeginFrameChunk();
+	void EndFrameChunk();
+	bool EndFrame();
 	Path WriteRecording();
 
 	bool HasDrawCommands() const;
@@ -75,6 +83,8 @@ class Recorder {
 	void FinishRecording();
 
 	Command EmitCommandWithRAM(CommandType t, const void *p, u32 sz, u32 align);
+	const u8 *FindKnownBlock(const void *p, u32 sz, u32 align) const;
+	void RememberBlock(u32 ptr, u32 sz);
 
 	void UpdateLastVRAM(u32 addr, u32 bytes);
 	void ClearLastVRAM(u32 addr, u8 c, u32 bytes);
@@ -91,6 +101,8 @@ class Recorder {
 
 	bool active = false;
 	std::atomic<bool> nextFrame = false;
+	int framesToRecord = 1;
+	int framesLeft = 0;
 	int flipLastAction = -1;
 	int flipFinishAt = -1;
 	uint32_t lastEdramTrans = 0x400;
@@ -99,9 +111,11 @@ class Recorder {
 	std::vector<u8> pushbuf;
 	std::vector<Command> commands;
 	std::vector<u32> lastRegisters;
-	std::vector<u32> lastTextures;
 	std::set<u32> lastRenderTargets;
 	std::vector<u8> lastVRAM;
+	std::vector<FrameChunk> chunks;
+	// Content hash -> pushbuf position, so data repeated across frames is stored once.
+	std::unordered_map<u64, u32> knownBlocks;
 
 	DirtyVRAMFlag dirtyVRAM[DIRTY_VRAM_SIZE];
 };
@@ -35,7 +35,10 @@ static const char * const HEADER_MAGIC = "PPSSPPGE";
 // Version 4: Expanded header with game ID
 // Version 5: Uses zstd
 // Version 6: Corrects dirty VRAM flag
-static const int VERSION = 6;
+// Version 7: Split into per-frame chunks with an index, compressed separately
+static const int VERSION = 7;
+// First version with a FrameChunk index after the header.
+static const int CHUNKED_VERSION = 7;
 static const int MIN_VERSION = 2;
 
 enum class CommandType : u8 {
@@ -79,6 +82,21 @@ struct Command {
 	u32 ptr;
 };
 
+// Version 7+ files: Header, u32 chunk count, u32 total commands, u32 total pushbuf size,
+// FrameChunk[chunk count], then the zstd compressed commands and data of each chunk.
+// Each recorded frame is a chunk: its commands, plus the pushbuf data first emitted during that frame.
+// Commands may point back into the data of earlier chunks (that's how repeated data is shared.)
+struct FrameChunk {
+	u32 firstCommand;
+	u32 numCommands;
+	u32 bufStart;
+	u32 bufSize;
+	u32 commandsCompressedSize;
+	u32 bufCompressedSize;
+	// Where the compressed commands start, followed directly by the compressed buffer data.
+	u64 fileOffset;
+};
+
 #pragma pack(pop)
 
 };
@@ -786,6 +786,7 @@ Shader *ShaderManagerGLES::ApplyVertexShader(bool useHWTransform, bool useHWTess
 	}
 
 	// Vertex shader not in cache. Let's compile it.
+	CountShaderCompile();
 	vs = CompileVertexShader(*VSID);
 	if (!vs) {
 		ERROR_LOG(Log::G3D, "Vertex shader generation failed, falling back to software transform");
@@ -837,6 +838,7 @@ LinkedShader *ShaderManagerGLES::ApplyFragmentShader(VShaderID VSID, Shader *vs,
 		// Fragment shader not in cache. Let's compile it.
 		// Can't really tell if we succeeded since the compile is on the GPU thread later.
 		// Could fail to generate, in which case we're kinda screwed.
+		CountShaderCompile();
 		fs = CompileFragmentShader(FSID);
 		if (!fs) {
 			ERROR_LOG(Log::G3D, "Failed to generate fragment shader with ID %08x:%08x", FSID.d[0], FSID.d[1]);
@@ -1134,6 +1136,7 @@ bool ShaderManagerGLES::LoadCache(File::IOFile &f) {
 	double finish = time_now_d();
 
 	NOTICE_LOG(Log::G3D, "Precompile: Compiled and linked %d programs (%d vertex, %d fragment) in %0.1f milliseconds", (int)pending.link.size(), (int)pending.vert.size(), (int)pending.frag.size(), 1000 * (finish - pending.start));
+	CountPrewarmedShaders((int)(pending.vert.size() + pending.frag.size()));
 	pending.Clear();
 
 	return true;
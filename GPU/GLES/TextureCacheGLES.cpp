@@ -39,6 +39,7 @@ TextureCacheGLES::TextureCacheGLES(Draw::DrawContext *draw, Draw2D *draw2D)
 	render_ = (GLRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
 
 	nextTexture_ = nullptr;
+	partialUpdatesSupported_ = true;
 }
 
 TextureCacheGLES::~TextureCacheGLES() {
@@ -355,6 +356,28 @@ void TextureCacheGLES::BuildTexture(TexCacheEntry *const entry) {
 	}
 }
 
+bool TextureCacheGLES::UpdateTextureRows(TexCacheEntry *entry, int y, int h) {
+	// TextureSubImage is recorded as a render command.
+	if (!entry->textureName || !render_->IsInRenderPass()) {
+		return false;
+	}
+
+	Draw::DataFormat dstFmt = GetDestFormat(GETextureFormat(entry->format), gstate.getClutPaletteFormat());
+	int w = gstate.getTextureWidth(0);
+	int stride = w * (int)Draw::DataFormatSizeInBytes(dstFmt);
+	u8 *data = (u8 *)AllocateAlignedMemory(stride * h, 16);
+	if (!data) {
+		return false;
+	}
+
+	DecodeTextureRows(entry, data, stride, y, h, dstFmt, TexDecodeFlags::REVERSE_COLORS);
+
+	// NOTE: TextureSubImage takes ownership of data. It also binds the texture, so forget what we had bound.
+	render_->TextureSubImage(TEX_SLOT_PSP_TEXTURE, entry->textureName, 0, 0, y, w, h, dstFmt, data, GLRAllocType::ALIGNED);
+	ForgetLastTexture();
+	return true;
+}
+
 Draw::DataFormat TextureCacheGLES::GetDestFormat(GETextureFormat format, GEPaletteFormat clutFormat) {
 	switch (format) {
 	case GE_TFMT_CLUT4:
@@ -70,6 +70,7 @@ class TextureCacheGLES : public TextureCacheCommon {
 
 	void UpdateCurrentClut(GEPaletteFormat clutFormat, u32 clutBase, bool clutIndexIsSimple) override;
 	void BuildTexture(TexCacheEntry *const entry) override;
+	bool UpdateTextureRows(TexCacheEntry *entry, int y, int h) override;
 
 	GLRenderManager *render_;
 
@@ -17,13 +17,17 @@
 
 #include "ppsspp_config.h"
 
+#include <algorithm>
+
 #include "Common/TimeUtil.h"
 #include "Common/GraphicsContext.h"
+#include "Common/Data/Format/JSONWriter.h"
 #include "Core/Core.h"
 #include "Core/System.h"
 
 #include "GPU/GPU.h"
 #include "GPU/GPUCommon.h"
+#include "GPU/Common/TextureDecoder.h"
 
 #if PPSSPP_API(ANY_GL)
 #include "GPU/GLES/GPU_GLES.h"
@@ -36,6 +40,7 @@
 #endif
 
 GPUStatistics gpuStats;
+GPUStatsHistory gpuStatsHistory;
 GPUCommon *gpu;
 
 #ifdef USE_CRT_DBG
@@ -77,6 +82,9 @@ bool GPU_Init(GPUCore gpuCore, GraphicsContext *ctx, Draw::DrawContext *draw) {
 	_dbg_assert_(draw || gpuCore == GPUCORE_SOFTWARE);
 	_dbg_assert_(!gpu);
 
+	// Picks the CPU-specific texture decode functions. Cheap, but keep it out of the GPU constructors.
+	SetupTextureDecoder();
+
 	GPUCommon *createdGPU = CreateGPUCore(gpuCore, ctx, draw);
 
 	gpu = createdGPU;
@@ -93,6 +101,99 @@ void GPU_Shutdown() {
 	gpu = nullptr;
 }
 
+void GPUStatsHistory::Record(const GPUStatsPerFrame &stats, int flips) {
+	double now = time_now_d();
+	std::lock_guard<std::mutex> guard(lock_);
+	GPUStatsFrameRecord &record = records_[nextId_ % SIZE];
+	record.id = nextId_++;
+	record.flips = flips;
+	record.timestamp = now;
+	record.frameTime = lastTimestamp_ == 0.0 ? 0.0 : now - lastTimestamp_;
+	record.stats = stats;
+	lastTimestamp_ = now;
+}
+
+std::vector<GPUStatsFrameRecord> GPUStatsHistory::GetSince(uint32_t afterId, int maxCount) const {
+	std::lock_guard<std::mutex> guard(lock_);
+	std::vector<GPUStatsFrameRecord> result;
+	// Nothing newer, or afterId is from the future. Don't fall through to returning older records.
+	if (afterId >= nextId_ - 1)
+		return result;
+	uint32_t first = std::max(afterId + 1, nextId_ > SIZE ? nextId_ - SIZE : 1);
+	if (maxCount >= 0 && nextId_ - first > (uint32_t)maxCount)
+		first = nextId_ - maxCount;
+
+	result.reserve(nextId_ - first);
+	for (uint32_t id = first; id < nextId_; ++id)
+		result.push_back(records_[id % SIZE]);
+	return result;
+}
+
+void GPUStatsFrameRecordToJSON(json::JsonWriter &j, const GPUStatsFrameRecord &record) {
+	const GPUStatsPerFrame &s = record.stats;
+	j.writeUint("id", record.id);
+	j.writeInt("flips", record.flips);
+	j.writeFloat("timestamp", record.timestamp);
+	j.writeFloat("frameTime", record.frameTime);
+
+#define STAT(name) j.writeInt(#name, s.name)
+	STAT(numDrawCalls);
+	STAT(numVertexDecodes);
+	STAT(numCulledDraws);
+	STAT(numDrawSyncs);
+	STAT(numListSyncs);
+	STAT(numFlushes);
+	STAT(numPrimLoopStateSkips);
+	STAT(numSoftTransformedDraws);
+	STAT(numSoftClippedTriangles);
+	STAT(numBBOXJumps);
+	STAT(numVertsSubmitted);
+	STAT(numVertsDecoded);
+	STAT(numVertexCacheHits);
+	STAT(numVertexCacheMisses);
+	STAT(numUncachedVertsDrawn);
+	STAT(numTextureInvalidations);
+	STAT(numTextureInvalidationsByFramebuffer);
+	STAT(numTexturesHashed);
+	STAT(numTextureDataBytesHashed);
+	STAT(numTexturesDecoded);
+	STAT(numFramebufferEvaluations);
+	STAT(numFBOsCreated);
+	STAT(numBlockingReadbacks);
+	STAT(numReadbacks);
+	STAT(numUploads);
+	STAT(numCachedUploads);
+	STAT(numDepal);
+	STAT(numClears);
+	STAT(numDepthCopies);
+	STAT(numReinterpretCopies);
+	STAT(numColorCopies);
+	STAT(numCopiesForShaderBlend);
+	STAT(numCopiesForSelfTex);
+	STAT(numBlockTransfers);
+	STAT(numReplacerTrackedTex);
+	STAT(numCachedReplacedTextures);
+	STAT(numClutTextures);
+	STAT(numShaderCompiles);
+	STAT(vertexGPUCycles);
+	STAT(otherGPUCycles);
+	STAT(numDepthRasterPrims);
+	STAT(numDepthRasterEarlySize);
+	STAT(numDepthRasterNoPixels);
+	STAT(numDepthRasterTooSmall);
+	STAT(numDepthRasterZCulled);
+	STAT(numDepthEarlyBoxCulled);
+#undef STAT
+#define STAT(name) j.writeFloat(#name, s.name)
+	STAT(msProcessingDisplayLists);
+	STAT(msPrepareDepth);
+	STAT(msCullDepth);
+	STAT(msRasterizeDepth);
+	STAT(msRasterTimeAvailable);
+	STAT(msWaitDepth);
+#undef STAT
+}
+
 const char *RasterChannelToString(RasterChannel channel) {
 	return channel == RASTER_COLOR ? "COLOR" : "DEPTH";
 }
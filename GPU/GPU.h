@@ -20,6 +20,8 @@
 
 #include <cstring>
 #include <cstdint>
+#include <mutex>
+#include <vector>
 
 enum GPUCore : int;
 
@@ -98,11 +100,14 @@ struct GPUStatsPerFrame {
 	int numDrawSyncs;
 	int numListSyncs;
 	int numFlushes;
+	int numPrimLoopStateSkips;
 	int numSoftTransformedDraws;
 	int numSoftClippedTriangles;
 	int numBBOXJumps;
 	int numVertsSubmitted;
 	int numVertsDecoded;
+	int numVertexCacheHits;
+	int numVertexCacheMisses;
 	int numUncachedVertsDrawn;
 	int numTextureInvalidations;
 	int numTextureInvalidationsByFramebuffer;
@@ -126,11 +131,13 @@ struct GPUStatsPerFrame {
 	int numReplacerTrackedTex;
 	int numCachedReplacedTextures;
 	int numClutTextures;
+	int numShaderCompiles;
 	double msProcessingDisplayLists;
 	double msPrepareDepth;
 	double msCullDepth;
 	double msRasterizeDepth;
 	double msRasterTimeAvailable;
+	double msWaitDepth;
 	int vertexGPUCycles;
 	int otherGPUCycles;
 	int numDepthRasterPrims;
@@ -144,6 +151,9 @@ struct GPUStatsPerFrame {
 struct GPUStatsTotals {
 	// Flip count. Doesn't really belong here.
 	int numFlips;
+	// Shaders compiled on demand during frames, vs. ahead of time from a shader cache.
+	int numShaderCompiles;
+	int numShadersPrewarmed;
 };
 
 // The ToString function lives in GPUCommonHW.cpp.
@@ -162,7 +172,41 @@ struct GPUStatistics {
 	GPUStatsTotals totals;
 };
 
+// A snapshot of GPUStatsPerFrame, taken each time the per-frame stats are reset.
+struct GPUStatsFrameRecord {
+	uint32_t id;  // Increases by one per record, so readers can ask for what's new.
+	int flips;  // gpuStats.totals.numFlips when recorded.
+	double timestamp;  // time_now_d() when recorded.
+	double frameTime;  // Seconds since the previous record.
+	GPUStatsPerFrame stats;
+};
+
+// Fixed-size ring of the most recent per-frame stats, for plotting spikes against GPU events.
+// Recorded on the emu thread, can be read from any thread.
+class GPUStatsHistory {
+public:
+	static constexpr int SIZE = 600;
+
+	void Record(const GPUStatsPerFrame &stats, int flips);
+	// Returns records with id > afterId, oldest first. At most maxCount (the newest ones.)
+	std::vector<GPUStatsFrameRecord> GetSince(uint32_t afterId, int maxCount = SIZE) const;
+
+private:
+	mutable std::mutex lock_;
+	GPUStatsFrameRecord records_[SIZE]{};
+	uint32_t nextId_ = 1;
+	double lastTimestamp_ = 0.0;
+};
+
+namespace json {
+class JsonWriter;
+}
+
+// Writes the record's fields into the currently open JSON dict.
+void GPUStatsFrameRecordToJSON(json::JsonWriter &j, const GPUStatsFrameRecord &record);
+
 extern GPUStatistics gpuStats;
+extern GPUStatsHistory gpuStatsHistory;
 extern GPUCommon *gpu;
 extern GPUCommon *gpu;
 
@@ -997,6 +997,7 @@ void GPUCommon::Execute_Ret(u32 op, u32 diff) {
 
 void GPUCommon::Execute_End(u32 op, u32 diff) {
 	if (flushOnParams_) {
+		// Wait here: once the list ends, the game can read the depth buffer without a sync call.
 		drawEngineCommon_->FlushQueuedDepth();
 		Flush();
 	}
@@ -524,6 +524,7 @@ void GPUCommonHW::PreExecuteOp(u32 op, u32 diff) {
 }
 
 void GPUCommonHW::PrepareCopyDisplayToOutput(const DisplayLayoutConfig &config) {
+	// The frame is over, don't leave workers writing to RAM while the CPU runs ahead.
 	drawEngineCommon_->FlushQueuedDepth();
 	// Flush anything left over.
 	drawEngineCommon_->Flush();
@@ -544,6 +545,8 @@ bool GPUCommonHW::PresentedThisFrame() const {
 }
 
 void GPUCommonHW::DoState(PointerWrap &p) {
+	// Depth raster workers write to RAM, which must be settled before it's saved or loaded.
+	drawEngineCommon_->FlushQueuedDepth();
 	GPUCommon::DoState(p);
 
 	// TODO: Some of these things may not be necessary.
@@ -755,6 +758,7 @@ void GPUCommonHW::InvalidateCache(u32 addr, int size, GPUInvalidationType type)
 		textureCache_->Invalidate(addr, size, type);
 	else
 		textureCache_->InvalidateAll(type);
+	drawEngineCommon_->InvalidateVertexCache(addr, size, type);
 
 	if (type != GPU_INVALIDATE_ALL && framebufferManager_->MayIntersectFramebufferColor(addr)) {
 		// Vempire invalidates (with writeback) after drawing, but before blitting.
@@ -878,6 +882,21 @@ void GPUCommonHW::Execute_VertexTypeSkinning(u32 op, u32 diff) {
 		gstate_c.Dirty(DIRTY_RASTER_STATE | DIRTY_VERTEXSHADER_STATE | DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_FRAGMENTSHADER_STATE);
 }
 
+// Returns how many matrix data commands follow op at src, if they exactly reload the current
+// values of the matrix. Returns -1 if the load would change anything, or is incomplete.
+static int SkipRedundantMatrixLoad(const u32_le *src, const u32_le *stall, u32 op, GECommand dataCmd, const u32 *matrix) {
+	const int first = op & 0xF;
+	const int count = 12 - first;
+	if (count <= 0 || (stall && src + count >= stall))
+		return -1;
+	for (int i = 0; i < count; i++) {
+		const u32 data = src[i + 1];
+		if ((data >> 24) != dataCmd || (data << 8) != matrix[first + i])
+			return -1;
+	}
+	return count;
+}
+
 void GPUCommonHW::Execute_Prim(u32 op, u32 diff) {
 	// This drives all drawing. All other state we just buffer up, then we apply it only
 	// when it's time to draw. As most PSP games set state redundantly ALL THE TIME, this is a huge optimization.
@@ -939,7 +958,9 @@ void GPUCommonHW::Execute_Prim(u32 op, u32 diff) {
 	}
 
 	if (changed) {
-		drawEngineCommon_->FlushQueuedDepth();
+		// No need to wait: the next kick waits for this batch before starting, so draws stay in
+		// order, and anything that reads the old depth buffer (copies, readbacks, syncs) flushes.
+		drawEngineCommon_->KickQueuedDepth();
 	}
 
 	if (gstate_c.dirty & DIRTY_VERTEXSHADER_STATE) {
@@ -1244,14 +1265,33 @@ void GPUCommonHW::Execute_Prim(u32 op, u32 diff) {
 			break;
 		}
 
-		// Keep going if these commands don't change state.
-		case GE_CMD_TEXBUFWIDTH0:
-		case GE_CMD_TEXADDR0:
-			if (data != gstate.cmdmem[data >> 24])
+		case GE_CMD_WORLDMATRIXNUMBER:
+		case GE_CMD_VIEWMATRIXNUMBER:
+		{
+			// Many games reload the same world/view matrix before each prim. If the whole reload
+			// is redundant, we can just skip over it and keep joining draws.
+			const bool world = (data >> 24) == GE_CMD_WORLDMATRIXNUMBER;
+			const int count = SkipRedundantMatrixLoad(src, stall, data, world ? GE_CMD_WORLDMATRIXDATA : GE_CMD_VIEWMATRIXDATA, (const u32 *)(world ? gstate.worldMatrix : gstate.viewMatrix));
+			if (count < 0)
 				goto bail;
+			const u32 num = ((data >> 24) << 24) | ((data & 0xF) + count);
+			if (world)
+				gstate.worldmtxnum = num;
+			else
+				gstate.viewmtxnum = num;
+			src += count;
+			gpuStats.perFrame.numPrimLoopStateSkips += count + 1;
 			break;
+		}
 
 		default:
+			// Keep going if the command doesn't change state and has no side effects, like
+			// TEXADDR0 / TEXBUFWIDTH0 being set again to the same value between prims.
+			// The regular run loop would ignore it as well.
+			if (data == gstate.cmdmem[data >> 24] && !(cmdInfo_[data >> 24].flags & FLAG_EXECUTE)) {
+				gpuStats.perFrame.numPrimLoopStateSkips++;
+				break;
+			}
 			// All other commands might need a flush or something, stop this inner loop.
 			goto bail;
 		}
@@ -1295,7 +1335,7 @@ void GPUCommonHW::Execute_Bezier(u32 op, u32 diff) {
 	bool changed;
 	VirtualFramebuffer *vfb = framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason, &changed);
 	if (changed) {
-		drawEngineCommon_->FlushQueuedDepth();
+		drawEngineCommon_->KickQueuedDepth();
 	}
 	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
 		// TODO: Should this eat some cycles?  Probably yes.  Not sure if important.
@@ -1373,7 +1413,7 @@ void GPUCommonHW::Execute_Spline(u32 op, u32 diff) {
 	bool changed;
 	VirtualFramebuffer *vfb = framebufferManager_->SetRenderFrameBuffer(gstate_c.IsDirty(DIRTY_FRAMEBUF), gstate_c.skipDrawReason, &changed);
 	if (changed) {
-		drawEngineCommon_->FlushQueuedDepth();
+		drawEngineCommon_->KickQueuedDepth();
 	}
 	if (gstate_c.skipDrawReason & (SKIPDRAW_SKIPFRAME | SKIPDRAW_NON_DISPLAYED_FB)) {
 		// TODO: Should this eat some cycles?  Probably yes.  Not sure if important.
@@ -1807,15 +1847,18 @@ void GPUCommonHW::FormatGPUStatsCommon(StringWriter &w) {
 	w.F(
 		"DL processing time: %0.2f ms, %d drawsync, %d listsync\n"
 		"Draw: %d (%d dec, %d culled), flushes %d, clears %d, bbox jumps %d\n"
+		"Batching: %0.1f prims/flush, %d redundant state cmds skipped\n"
 		"%d soft. Vertices: %d dec: %d drawn: %d clipped tris: %d\n"
+		"Vertex cache: %d entries, %d hits, %d misses\n"
 		"FBOs active: %d (evaluations: %d, created %d)\n"
 		"Textures: %d, dec: %d, invalidated: %d, hashed: %d kB, clut %d\n"
 		"readbacks %d (%d non-block), upload %d (cached %d), depal %d\n"
 		"block transfers: %d\n"
+		"Shader compiles: %d (total %d in-frame, %d prewarmed)\n"
 		"replacer: tracks %d references, %d unique textures\n"
 		"Cpy: depth %d, color %d, reint %d, blend %d, self %d\n"
 		"GPU cycles: %d (%0.1f per vertex)\n"
-		"Z-rast: %0.2f+%0.2f+%0.2f (total %0.2f/%0.2f) ms\n"
+		"Z-rast: %0.2f+%0.2f+%0.2f (total %0.2f/%0.2f) ms, waited %0.2f ms\n"
 		"Z-rast: %d prim, %d nopix, %d small, %d earlysize, %d zcull, %d box\n%s",
 		gpuStats.perFrame.msProcessingDisplayLists * 1000.0f,
 		gpuStats.perFrame.numDrawSyncs,
@@ -1826,11 +1869,16 @@ void GPUCommonHW::FormatGPUStatsCommon(StringWriter &w) {
 		gpuStats.perFrame.numFlushes,
 		gpuStats.perFrame.numClears,
 		gpuStats.perFrame.numBBOXJumps,
+		gpuStats.perFrame.numFlushes > 0 ? (float)gpuStats.perFrame.numDrawCalls / (float)gpuStats.perFrame.numFlushes : 0.0f,
+		gpuStats.perFrame.numPrimLoopStateSkips,
 		gpuStats.perFrame.numSoftTransformedDraws,
 		gpuStats.perFrame.numVertsSubmitted,
 		gpuStats.perFrame.numVertsDecoded,
 		gpuStats.perFrame.numUncachedVertsDrawn,
 		gpuStats.perFrame.numSoftClippedTriangles,
+		drawEngineCommon_->VertexCacheSize(),
+		gpuStats.perFrame.numVertexCacheHits,
+		gpuStats.perFrame.numVertexCacheMisses,
 		(int)framebufferManager_->NumVFBs(),
 		gpuStats.perFrame.numFramebufferEvaluations,
 		gpuStats.perFrame.numFBOsCreated,
@@ -1845,6 +1893,9 @@ void GPUCommonHW::FormatGPUStatsCommon(StringWriter &w) {
 		gpuStats.perFrame.numCachedUploads,
 		gpuStats.perFrame.numDepal,
 		gpuStats.perFrame.numBlockTransfers,
+		gpuStats.perFrame.numShaderCompiles,
+		gpuStats.totals.numShaderCompiles,
+		gpuStats.totals.numShadersPrewarmed,
 		gpuStats.perFrame.numReplacerTrackedTex,
 		gpuStats.perFrame.numCachedReplacedTextures,
 		gpuStats.perFrame.numDepthCopies,
@@ -1859,6 +1910,7 @@ void GPUCommonHW::FormatGPUStatsCommon(StringWriter &w) {
 		gpuStats.perFrame.msRasterizeDepth * 1000.0,
 		(gpuStats.perFrame.msPrepareDepth + gpuStats.perFrame.msCullDepth + gpuStats.perFrame.msRasterizeDepth) * 1000.0,
 		gpuStats.perFrame.msRasterTimeAvailable * 1000.0,
+		gpuStats.perFrame.msWaitDepth * 1000.0,
 		gpuStats.perFrame.numDepthRasterPrims,
 		gpuStats.perFrame.numDepthRasterNoPixels,
 		gpuStats.perFrame.numDepthRasterTooSmall,
@@ -441,6 +441,7 @@ SoftGPU::SoftGPU(GraphicsContext *gfxCtx, Draw::DrawContext *draw)
 
 	// No need to flush for simple parameter changes.
 	flushOnParams_ = false;
+	deferListFlush_ = PSP_CoreParameter().softGPUDeferListFlush;
 
 	if (gfxCtx && draw) {
 		presentation_ = new PresentationCommon(draw_);
@@ -472,6 +473,8 @@ void SoftGPU::DeviceRestore(Draw::DrawContext *draw) {
 }
 
 SoftGPU::~SoftGPU() {
+	// Rasterizer threads may still be running if we deferred the last flush.
+	drawEngine_->transformUnit.Flush(this, "shutdown");
 	if (fbTex) {
 		fbTex->Release();
 		fbTex = nullptr;
@@ -1253,10 +1256,20 @@ void SoftGPU::Execute_Call(u32 op, u32 diff) {
 }
 
 void SoftGPU::FinishDeferred() {
+	if (deferListFlush_) {
+		// Let the rasterizer threads keep going while the CPU runs. Syncs and reads flush below.
+		drawEngine_->transformUnit.Kick();
+		return;
+	}
 	// Need to flush before going back to CPU, so drawing is appropriately visible.
 	drawEngine_->transformUnit.Flush(this, "finish");
 }
 
+void SoftGPU::DoState(PointerWrap &p) {
+	drawEngine_->transformUnit.Flush(this, "savestate");
+	GPUCommon::DoState(p);
+}
+
 int SoftGPU::ListSync(int listid, int mode) {
 	// Take this as a cue that we need to finish drawing.
 	drawEngine_->transformUnit.Flush(this, "listsync");
@@ -1284,6 +1297,9 @@ void SoftGPU::PerformWriteFormattedFromMemory(u32 addr, int size, int width, GEB
 }
 
 bool SoftGPU::PerformMemoryCopy(u32 dest, u32 src, int size, GPUCopyFlag flags) {
+	// Only matters if FinishDeferred() left drawing in flight.
+	drawEngine_->transformUnit.FlushIfOverlap(this, "memcpy", false, src, size, size, 1);
+	drawEngine_->transformUnit.FlushIfOverlap(this, "memcpy", true, dest, size, size, 1);
 	// Nothing to update.
 	InvalidateCache(dest, size, GPU_INVALIDATE_HINT);
 	if (!(flags & GPUCopyFlag::DEBUG_NOTIFIED))
@@ -1295,6 +1311,7 @@ bool SoftGPU::PerformMemoryCopy(u32 dest, u32 src, int size, GPUCopyFlag flags)
 
 bool SoftGPU::PerformMemorySet(u32 dest, u8 v, int size)
 {
+	drawEngine_->transformUnit.FlushIfOverlap(this, "memset", true, dest, size, size, 1);
 	// Nothing to update.
 	InvalidateCache(dest, size, GPU_INVALIDATE_HINT);
 	recorder_.NotifyMemset(dest, v, size);
@@ -1305,6 +1322,7 @@ bool SoftGPU::PerformMemorySet(u32 dest, u8 v, int size)
 
 bool SoftGPU::PerformReadbackToMemory(u32 dest, int size)
 {
+	drawEngine_->transformUnit.FlushIfOverlap(this, "readback", false, dest, size, size, 1);
 	// Nothing to update.
 	InvalidateCache(dest, size, GPU_INVALIDATE_HINT);
 	return false;
@@ -1351,6 +1369,7 @@ static DrawingCoords GetTargetSize(int stride) {
 }
 
 bool SoftGPU::GetCurrentFramebuffer(GPUDebugBuffer &buffer, GPUDebugFramebufferType type, int maxRes) {
+	drawEngine_->transformUnit.Flush(this, "debugbuf");
 	int stride = gstate.FrameBufStride();
 	DrawingCoords size = GetTargetSize(stride);
 	GEBufferFormat fmt = gstate.FrameBufFormat();
@@ -1385,6 +1404,7 @@ bool SoftGPU::GetOutputFramebuffer(GPUDebugBuffer &buffer) {
 }
 
 bool SoftGPU::GetCurrentDepthbuffer(GPUDebugBuffer &buffer) {
+	drawEngine_->transformUnit.Flush(this, "debugbuf");
 	DrawingCoords size = GetTargetSize(gstate.DepthBufStride());
 	buffer.Allocate(size.x, size.y, GPU_DBG_FORMAT_16BIT);
 
@@ -1413,6 +1433,7 @@ static inline u8 GetPixelStencil(GEBufferFormat fmt, int fbStride, int x, int y)
 }
 
 bool SoftGPU::GetCurrentStencilbuffer(GPUDebugBuffer &buffer) {
+	drawEngine_->transformUnit.Flush(this, "debugbuf");
 	DrawingCoords size = GetTargetSize(gstate.FrameBufStride());
 	buffer.Allocate(size.x, size.y, GPU_DBG_FORMAT_8BIT);
 
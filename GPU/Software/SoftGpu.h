@@ -131,6 +131,7 @@ class SoftGPU : public GPUCommon {
 	u32 CheckGPUFeatures() const override { return 0; }
 	void ExecuteOp(u32 op, u32 diff) override;
 	void FinishDeferred() override;
+	void DoState(PointerWrap &p) override;
 	int ListSync(int listid, int mode) override;
 	u32 DrawSync(int mode) override;
 	void UpdateCmdInfo() override {}
@@ -238,6 +239,9 @@ class SoftGPU : public GPUCommon {
 
 	Draw::Texture *fbTex = nullptr;
 	std::vector<u32> fbTexBuffer_;
+
+	// See CoreParameter::softGPUDeferListFlush.
+	bool deferListFlush_ = false;
 };
 
 // TODO: These shouldn't be global.
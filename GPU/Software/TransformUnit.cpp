@@ -890,6 +890,12 @@ void TransformUnit::Flush(GPUCommon *common, const char *reason) {
 	hasDraws_ = false;
 }
 
+void TransformUnit::Kick() {
+	if (!hasDraws_)
+		return;
+	binner_->Drain(true);
+}
+
 void TransformUnit::GetStats(StringWriter &w) {
 	// TODO: More stats?
 	binner_->GetStats(w);
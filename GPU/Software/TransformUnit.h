@@ -134,6 +134,8 @@ class TransformUnit {
 
 	void Flush(GPUCommon *common, const char *reason);
 	void FlushIfOverlap(GPUCommon *common, const char *reason, bool modifying, uint32_t addr, uint32_t stride, uint32_t w, uint32_t h);
+	// Hands everything queued so far to the rasterizer threads, without waiting for it.
+	void Kick();
 	void NotifyClutUpdate(const void *src);
 
 	void GetStats(StringWriter &w);
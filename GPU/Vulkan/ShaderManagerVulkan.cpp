@@ -19,16 +19,23 @@
 //#define SHADERLOG
 #endif
 
+#include <atomic>
+
+#include "Common/Data/Text/I18n.h"
 #include "Common/LogReporting.h"
 #include "Common/Profiler/Profiler.h"
 #include "Common/GPU/thin3d.h"
 #include "Common/MemoryUtil.h"
+#include "Common/System/OSD.h"
 
 #include "Common/StringUtils.h"
 #include "Common/GPU/Vulkan/VulkanContext.h"
 #include "Common/Log.h"
 #include "Common/TimeUtil.h"
 #include "Common/GPU/Vulkan/VulkanMemory.h"
+#include "Common/Thread/ParallelLoop.h"
+#include "Core/Config.h"
+#include "ext/xxhash.h"
 
 #include "GPU/GPUState.h"
 #include "GPU/Common/FragmentShaderGenerator.h"
@@ -38,52 +45,66 @@
 
 // Most drivers treat vkCreateShaderModule as pretty much a memcpy. What actually
 // takes time here, and makes this worthy of parallelization, is GLSLtoSPV.
-// Takes ownership over tag.
-// This always returns something, checking the return value for null is not meaningful.
-static Promise<VkShaderModule> *CompileShaderModuleAsync(VulkanContext *vulkan, VkShaderStageFlagBits stage, const char *code, std::string *tag) {
-	auto compile = [=] {
-		PROFILE_THIS_SCOPE("shadercomp");
-
-		std::string errorMessage;
-		std::vector<uint32_t> spirv;
+static bool CompileShaderToSPIRV(VkShaderStageFlagBits stage, const char *code, std::vector<uint32_t> *spirv) {
+	PROFILE_THIS_SCOPE("shadercomp");
 
-		bool success = GLSLtoSPV(stage, code, GLSLVariant::VULKAN, spirv, &errorMessage);
+	std::string errorMessage;
+	bool success = GLSLtoSPV(stage, code, GLSLVariant::VULKAN, *spirv, &errorMessage);
 
-		if (!errorMessage.empty()) {
-			if (success) {
-				ERROR_LOG(Log::G3D, "Warnings in shader compilation!");
-			} else {
-				ERROR_LOG(Log::G3D, "Error in shader compilation!");
-			}
-			std::string numberedSource = LineNumberString(code);
-			ERROR_LOG(Log::G3D, "Messages: %s", errorMessage.c_str());
-			ERROR_LOG(Log::G3D, "Shader source:\n%s", numberedSource.c_str());
+	if (!errorMessage.empty()) {
+		if (success) {
+			ERROR_LOG(Log::G3D, "Warnings in shader compilation!");
+		} else {
+			ERROR_LOG(Log::G3D, "Error in shader compilation!");
+		}
+		std::string numberedSource = LineNumberString(code);
+		ERROR_LOG(Log::G3D, "Messages: %s", errorMessage.c_str());
+		ERROR_LOG(Log::G3D, "Shader source:\n%s", numberedSource.c_str());
 #if PPSSPP_PLATFORM(WINDOWS)
-			OutputDebugStringA("Error messages:\n");
-			OutputDebugStringA(errorMessage.c_str());
-			OutputDebugStringA(numberedSource.c_str());
+		OutputDebugStringA("Error messages:\n");
+		OutputDebugStringA(errorMessage.c_str());
+		OutputDebugStringA(numberedSource.c_str());
 #endif
-			Reporting::ReportMessage("Vulkan error in shader compilation: info: %s / code: %s", errorMessage.c_str(), code);
-		}
+		Reporting::ReportMessage("Vulkan error in shader compilation: info: %s / code: %s", errorMessage.c_str(), code);
+	}
+	return success;
+}
 
-		VkShaderModule shaderModule = VK_NULL_HANDLE;
-		if (success) {
-			const char *createTag = tag ? tag->c_str() : nullptr;
-			if (!createTag) {
-				switch (stage) {
-				case VK_SHADER_STAGE_VERTEX_BIT: createTag = "game_vertex"; break;
-				case VK_SHADER_STAGE_FRAGMENT_BIT: createTag = "game_fragment"; break;
-				case VK_SHADER_STAGE_GEOMETRY_BIT: createTag = "game_geometry"; break;
-				case VK_SHADER_STAGE_COMPUTE_BIT: createTag = "game_compute"; break;
-				default: break;
-				}
-			}
+// Takes ownership over tag.
+static VkShaderModule CreateShaderModuleFromSPIRV(VulkanContext *vulkan, VkShaderStageFlagBits stage, const std::vector<uint32_t> &spirv, std::string *tag) {
+	const char *createTag = tag ? tag->c_str() : nullptr;
+	if (!createTag) {
+		switch (stage) {
+		case VK_SHADER_STAGE_VERTEX_BIT: createTag = "game_vertex"; break;
+		case VK_SHADER_STAGE_FRAGMENT_BIT: createTag = "game_fragment"; break;
+		case VK_SHADER_STAGE_GEOMETRY_BIT: createTag = "game_geometry"; break;
+		case VK_SHADER_STAGE_COMPUTE_BIT: createTag = "game_compute"; break;
+		default: break;
+		}
+	}
 
-			success = vulkan->CreateShaderModule(spirv, &shaderModule, createTag);
+	VkShaderModule shaderModule = VK_NULL_HANDLE;
+	vulkan->CreateShaderModule(spirv, &shaderModule, createTag);
 #ifdef SHADERLOG
-			OutputDebugStringA("OK");
+	OutputDebugStringA("OK");
 #endif
+	delete tag;
+	return shaderModule;
+}
+
+// Takes ownership over tag. If keepSpirv is non-null, the SPIR-V is moved there before the promise resolves,
+// so it can be read after BlockUntilReady() (used to store it in the shader cache.)
+// This always returns something, checking the return value for null is not meaningful.
+static Promise<VkShaderModule> *CompileShaderModuleAsync(VulkanContext *vulkan, VkShaderStageFlagBits stage, const char *code, std::string *tag, std::vector<uint32_t> *keepSpirv) {
+	auto compile = [=] {
+		std::vector<uint32_t> spirv;
+		if (!CompileShaderToSPIRV(stage, code, &spirv)) {
 			delete tag;
+			return (VkShaderModule)VK_NULL_HANDLE;
+		}
+		VkShaderModule shaderModule = CreateShaderModuleFromSPIRV(vulkan, stage, spirv, tag);
+		if (keepSpirv && shaderModule != VK_NULL_HANDLE) {
+			*keepSpirv = std::move(spirv);
 		}
 		return shaderModule;
 	};
@@ -102,14 +123,28 @@ static Promise<VkShaderModule> *CompileShaderModuleAsync(VulkanContext *vulkan,
 	}
 }
 
-VulkanFragmentShader::VulkanFragmentShader(VulkanContext *vulkan, FShaderID id, FragmentShaderFlags flags, const char *code)
+VulkanFragmentShader::VulkanFragmentShader(VulkanContext *vulkan, FShaderID id, FragmentShaderFlags flags, const char *code, std::vector<uint32_t> *spirv)
 	: vulkan_(vulkan), id_(id), flags_(flags) {
 	_assert_(!id.is_invalid());
 	source_ = code;
-	module_ = CompileShaderModuleAsync(vulkan, VK_SHADER_STAGE_FRAGMENT_BIT, source_.c_str(), new std::string(FragmentShaderDesc(id)));
+	std::vector<uint32_t> *keepSpirv = g_Config.bShaderCacheSPIRV ? &spirv_ : nullptr;
+	if (spirv && !spirv->empty()) {
+		// Already compiled (shader cache load), only need to create the module.
+		module_ = Promise<VkShaderModule>::AlreadyDone(CreateShaderModuleFromSPIRV(vulkan, VK_SHADER_STAGE_FRAGMENT_BIT, *spirv, new std::string(FragmentShaderDesc(id))));
+		if (keepSpirv)
+			spirv_ = std::move(*spirv);
+	} else {
+		module_ = CompileShaderModuleAsync(vulkan, VK_SHADER_STAGE_FRAGMENT_BIT, source_.c_str(), new std::string(FragmentShaderDesc(id)), keepSpirv);
+	}
 	VERBOSE_LOG(Log::G3D, "Compiled fragment shader:\n%s\n", (const char *)code);
 }
 
+const std::vector<uint32_t> &VulkanFragmentShader::GetSPIRV() {
+	if (module_)
+		module_->BlockUntilReady();
+	return spirv_;
+}
+
 VulkanFragmentShader::~VulkanFragmentShader() {
 	if (module_) {
 		VkShaderModule shaderModule = module_->BlockUntilReady();
@@ -134,14 +169,27 @@ std::string VulkanFragmentShader::GetShaderString(DebugShaderStringType type) co
 	}
 }
 
-VulkanVertexShader::VulkanVertexShader(VulkanContext *vulkan, VShaderID id, VertexShaderFlags flags, const char *code, bool useHWTransform)
+VulkanVertexShader::VulkanVertexShader(VulkanContext *vulkan, VShaderID id, VertexShaderFlags flags, const char *code, bool useHWTransform, std::vector<uint32_t> *spirv)
 	: vulkan_(vulkan), useHWTransform_(useHWTransform), flags_(flags), id_(id) {
 	_assert_(!id.is_invalid());
 	source_ = code;
-	module_ = CompileShaderModuleAsync(vulkan, VK_SHADER_STAGE_VERTEX_BIT, source_.c_str(), new std::string(VertexShaderDesc(id)));
+	std::vector<uint32_t> *keepSpirv = g_Config.bShaderCacheSPIRV ? &spirv_ : nullptr;
+	if (spirv && !spirv->empty()) {
+		module_ = Promise<VkShaderModule>::AlreadyDone(CreateShaderModuleFromSPIRV(vulkan, VK_SHADER_STAGE_VERTEX_BIT, *spirv, new std::string(VertexShaderDesc(id))));
+		if (keepSpirv)
+			spirv_ = std::move(*spirv);
+	} else {
+		module_ = CompileShaderModuleAsync(vulkan, VK_SHADER_STAGE_VERTEX_BIT, source_.c_str(), new std::string(VertexShaderDesc(id)), keepSpirv);
+	}
 	VERBOSE_LOG(Log::G3D, "Compiled vertex shader:\n%s\n", (const char *)code);
 }
 
+const std::vector<uint32_t> &VulkanVertexShader::GetSPIRV() {
+	if (module_)
+		module_->BlockUntilReady();
+	return spirv_;
+}
+
 VulkanVertexShader::~VulkanVertexShader() {
 	if (module_) {
 		VkShaderModule shaderModule = module_->BlockUntilReady();
@@ -260,6 +308,7 @@ void ShaderManagerVulkan::GetShaders(int prim, u32 vertexType, VulkanVertexShade
 			vs = lastVShader_;
 		} else if (!vsCache_.Get(VSID, &vs)) {
 			// Vertex shader not in cache. Let's compile it.
+			CountShaderCompile();
 			std::string genErrorString;
 			uint64_t uniformMask = 0;  // Not used
 			uint32_t attributeMask = 0;  // Not used
@@ -291,6 +340,7 @@ void ShaderManagerVulkan::GetShaders(int prim, u32 vertexType, VulkanVertexShade
 			fs = lastFShader_;
 		} else if (!fsCache_.Get(FSID, &fs)) {
 			// Fragment shader not in cache. Let's compile it.
+			CountShaderCompile();
 			std::string genErrorString;
 			uint64_t uniformMask = 0;  // Not used
 			FragmentShaderFlags flags{};
@@ -410,7 +460,7 @@ enum class VulkanCacheDetectFlags {
 };
 
 #define CACHE_HEADER_MAGIC 0xff51f420 
-#define CACHE_VERSION 55
+#define CACHE_VERSION 56
 
 struct VulkanCacheHeader {
 	uint32_t magic;
@@ -420,8 +470,39 @@ struct VulkanCacheHeader {
 	int numVertexShaders;
 	int numFragmentShaders;
 	int numGeometryShaders;
+	// If set, each shader ID is followed (after all IDs) by a source hash and its SPIR-V.
+	uint32_t hasSPIRV;
+};
+
+// Per-shader state while loading the cache. Generated and compiled on worker threads,
+// then turned into shader objects in file order on the loading thread.
+struct VulkanCacheLoadItem {
+	std::string code;
+	uint64_t sourceHash = 0;
+	std::vector<uint32_t> spirv;
+	VertexShaderFlags vsFlags{};
+	FragmentShaderFlags fsFlags{};
+	bool failed = false;
 };
 
+static bool ReadCachedSPIRV(FILE *f, VulkanCacheLoadItem *item) {
+	uint32_t numWords = 0;
+	if (fread(&item->sourceHash, sizeof(item->sourceHash), 1, f) != 1 || fread(&numWords, sizeof(numWords), 1, f) != 1)
+		return false;
+	// Sanity check, our shaders are nowhere near this big.
+	if (numWords > 1024 * 1024)
+		return false;
+	item->spirv.resize(numWords);
+	return numWords == 0 || fread(item->spirv.data(), sizeof(uint32_t), numWords, f) == numWords;
+}
+
+static bool WriteCachedSPIRV(FILE *f, const std::string &source, const std::vector<uint32_t> &spirv) {
+	uint64_t sourceHash = XXH3_64bits(source.data(), source.size());
+	uint32_t numWords = (uint32_t)spirv.size();
+	bool success = fwrite(&sourceHash, sizeof(sourceHash), 1, f) == 1 && fwrite(&numWords, sizeof(numWords), 1, f) == 1;
+	return success && (numWords == 0 || fwrite(spirv.data(), sizeof(uint32_t), numWords, f) == numWords);
+}
+
 bool ShaderManagerVulkan::LoadCacheFlags(FILE *f, DrawEngineVulkan *drawEngine) {
 	VulkanCacheHeader header{};
 	int64_t pos = File::Ftell(f);
@@ -440,6 +521,22 @@ bool ShaderManagerVulkan::LoadCacheFlags(FILE *f, DrawEngineVulkan *drawEngine)
 	return true;
 }
 
+// Called from the cache loading workers. The loading screen shows the progress bar, and every
+// tenth of the way we also log, to see where the time goes on slow devices.
+static void ReportCacheLoadProgress(int done, int total, std::atomic<int> &shownPercent, double start) {
+	int percent = done * 100 / total;
+	int shown = shownPercent.load();
+	do {
+		if (percent <= shown)
+			return;
+	} while (!shownPercent.compare_exchange_weak(shown, percent));
+
+	auto gr = GetI18NCategory(I18NCat::GRAPHICS);
+	g_OSD.SetProgressBar("shadercache", gr->T("Loading shader cache"), 0.0f, (float)total, (float)done, 0.5f);
+	if (percent / 10 != shown / 10)
+		INFO_LOG(Log::G3D, "ShaderCache: %d/%d shaders compiled after %0.1f ms", done, total, (time_now_d() - start) * 1000.0);
+}
+
 bool ShaderManagerVulkan::LoadCache(FILE *f) {
 	VulkanCacheHeader header{};
 	bool success = fread(&header, sizeof(header), 1, f) == 1;
@@ -454,58 +551,113 @@ bool ShaderManagerVulkan::LoadCache(FILE *f) {
 		gstate_c.useFlagsChanged = false;
 	}
 
-	int failCount = 0;
+	if (header.numVertexShaders < 0 || header.numFragmentShaders < 0 || header.numVertexShaders + header.numFragmentShaders > 65536) {
+		ERROR_LOG(Log::G3D, "Vulkan shader cache has bad shader counts");
+		return false;
+	}
 
-	VulkanContext *vulkan = (VulkanContext *)draw_->GetNativeObject(Draw::NativeObject::CONTEXT);
-	for (int i = 0; i < header.numVertexShaders; i++) {
-		VShaderID id;
-		if (fread(&id, sizeof(id), 1, f) != 1) {
-			ERROR_LOG(Log::G3D, "Vulkan shader cache truncated (in VertexShaders)");
-			return false;
-		}
-		bool useHWTransform = id.Bit(VS_BIT_USE_HW_TRANSFORM);
-		std::string genErrorString;
-		uint32_t attributeMask = 0;
-		uint64_t uniformMask = 0;
-		VertexShaderFlags flags;
-		if (!GenerateVertexShader(id, codeBuffer_, compat_, draw_->GetBugs(), &attributeMask, &uniformMask, &flags, &genErrorString)) {
-			ERROR_LOG(Log::G3D, "Failed to generate vertex shader during cache load");
-			// We just ignore this one and carry on.
-			failCount++;
-			continue;
-		}
-		_assert_msg_(strlen(codeBuffer_) < CODE_BUFFER_SIZE, "VS length error: %d", (int)strlen(codeBuffer_));
-		// Don't add the new shader if already compiled - though this should no longer happen.
-		if (!vsCache_.ContainsKey(id)) {
-			VulkanVertexShader *vs = new VulkanVertexShader(vulkan, id, flags, codeBuffer_, useHWTransform);
-			vsCache_.Insert(id, vs);
+	// Read everything up front, the pipeline cache follows in the same file.
+	std::vector<VShaderID> vsIDs(header.numVertexShaders);
+	std::vector<FShaderID> fsIDs(header.numFragmentShaders);
+	if (!vsIDs.empty() && fread(vsIDs.data(), sizeof(VShaderID), vsIDs.size(), f) != vsIDs.size()) {
+		ERROR_LOG(Log::G3D, "Vulkan shader cache truncated (in VertexShaders)");
+		return false;
+	}
+	if (!fsIDs.empty() && fread(fsIDs.data(), sizeof(FShaderID), fsIDs.size(), f) != fsIDs.size()) {
+		ERROR_LOG(Log::G3D, "Vulkan shader cache truncated (in FragmentShaders)");
+		return false;
+	}
+
+	const int numVS = header.numVertexShaders;
+	const int total = numVS + header.numFragmentShaders;
+	std::vector<VulkanCacheLoadItem> items(total);
+	if (header.hasSPIRV) {
+		for (int i = 0; i < total; i++) {
+			if (!ReadCachedSPIRV(f, &items[i])) {
+				ERROR_LOG(Log::G3D, "Vulkan shader cache truncated (in SPIR-V)");
+				return false;
+			}
 		}
 	}
-	uint32_t vendorID = vulkan->GetPhysicalDeviceProperties().properties.vendorID;
 
-	for (int i = 0; i < header.numFragmentShaders; i++) {
-		FShaderID id;
-		if (fread(&id, sizeof(id), 1, f) != 1) {
-			ERROR_LOG(Log::G3D, "Vulkan shader cache truncated (in FragmentShaders)");
-			return false;
+	std::atomic<int> reusedSPIRV{};
+	std::atomic<int> done{};
+	std::atomic<int> shownPercent{};
+	double start = time_now_d();
+
+	// Shader generation is cheap but GLSLtoSPV is not, so do both on worker threads.
+	// Stored SPIR-V is only used if the generated source still matches what it was compiled from.
+	const Draw::Bugs bugs = draw_->GetBugs();
+	auto generateAndCompile = [&](int lower, int upper) {
+		std::unique_ptr<char[]> buffer(new char[CODE_BUFFER_SIZE]);
+		for (int i = lower; i < upper; i++) {
+			VulkanCacheLoadItem &item = items[i];
+			std::string genErrorString;
+			uint64_t uniformMask = 0;
+			VkShaderStageFlagBits stage;
+			bool generated;
+			if (i < numVS) {
+				uint32_t attributeMask = 0;
+				generated = GenerateVertexShader(vsIDs[i], buffer.get(), compat_, bugs, &attributeMask, &uniformMask, &item.vsFlags, &genErrorString);
+				stage = VK_SHADER_STAGE_VERTEX_BIT;
+			} else {
+				generated = GenerateFragmentShader(fsIDs[i - numVS], buffer.get(), compat_, bugs, &uniformMask, &item.fsFlags, &genErrorString);
+				stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+			}
+			if (!generated) {
+				ERROR_LOG(Log::G3D, "Failed to generate %s shader during cache load", i < numVS ? "vertex" : "fragment");
+				// We just ignore this one and carry on.
+				item.failed = true;
+				item.spirv.clear();
+			} else {
+				_assert_msg_(strlen(buffer.get()) < CODE_BUFFER_SIZE, "Shader length error: %d", (int)strlen(buffer.get()));
+				item.code = buffer.get();
+				if (!item.spirv.empty() && item.sourceHash == XXH3_64bits(item.code.data(), item.code.size())) {
+					reusedSPIRV++;
+				} else {
+					item.spirv.clear();
+					item.failed = !CompileShaderToSPIRV(stage, item.code.c_str(), &item.spirv);
+				}
+			}
+			ReportCacheLoadProgress(++done, total, shownPercent, start);
 		}
-		std::string genErrorString;
-		uint64_t uniformMask = 0;
-		FragmentShaderFlags flags;
-		if (!GenerateFragmentShader(id, codeBuffer_, compat_, draw_->GetBugs(), &uniformMask, &flags, &genErrorString)) {
-			ERROR_LOG(Log::G3D, "Failed to generate fragment shader during cache load");
-			// We just ignore this one and carry on.
+	};
+
+#if defined(_DEBUG)
+	// See CompileShaderModuleAsync, glslang is pathologically slow in parallel in debug builds.
+	generateAndCompile(0, total);
+#else
+	ParallelRangeLoop(&g_threadManager, generateAndCompile, 0, total, 1);
+#endif
+	if (total > 0)
+		g_OSD.RemoveProgressBar("shadercache", true, 0.5f);
+
+	// Insert in file order, so the result doesn't depend on thread timing.
+	int failCount = 0;
+	VulkanContext *vulkan = (VulkanContext *)draw_->GetNativeObject(Draw::NativeObject::CONTEXT);
+	for (int i = 0; i < total; i++) {
+		VulkanCacheLoadItem &item = items[i];
+		if (item.failed) {
 			failCount++;
 			continue;
 		}
-		_assert_msg_(strlen(codeBuffer_) < CODE_BUFFER_SIZE, "FS length error: %d", (int)strlen(codeBuffer_));
-		if (!fsCache_.ContainsKey(id)) {
-			VulkanFragmentShader *fs = new VulkanFragmentShader(vulkan, id, flags, codeBuffer_);
-			fsCache_.Insert(id, fs);
+		// Don't add the new shader if already compiled - though this should no longer happen.
+		if (i < numVS) {
+			const VShaderID &id = vsIDs[i];
+			if (!vsCache_.ContainsKey(id)) {
+				bool useHWTransform = id.Bit(VS_BIT_USE_HW_TRANSFORM);
+				vsCache_.Insert(id, new VulkanVertexShader(vulkan, id, item.vsFlags, item.code.c_str(), useHWTransform, &item.spirv));
+			}
+		} else {
+			const FShaderID &id = fsIDs[i - numVS];
+			if (!fsCache_.ContainsKey(id)) {
+				fsCache_.Insert(id, new VulkanFragmentShader(vulkan, id, item.fsFlags, item.code.c_str(), &item.spirv));
+			}
 		}
 	}
 
-	NOTICE_LOG(Log::G3D, "ShaderCache: Loaded %d vertex, %d fragment shaders and %d geometry shaders (failed %d)", header.numVertexShaders, header.numFragmentShaders, header.numGeometryShaders, failCount);
+	NOTICE_LOG(Log::G3D, "ShaderCache: Loaded %d vertex, %d fragment shaders and %d geometry shaders (failed %d, %d from stored SPIR-V) in %0.1f ms", header.numVertexShaders, header.numFragmentShaders, header.numGeometryShaders, failCount, reusedSPIRV.load(), (time_now_d() - start) * 1000.0);
+	CountPrewarmedShaders(total - failCount);
 	return true;
 }
 
@@ -518,6 +670,7 @@ void ShaderManagerVulkan::SaveCache(FILE *f, DrawEngineVulkan *drawEngine) {
 	header.numVertexShaders = (int)vsCache_.size();
 	header.numFragmentShaders = (int)fsCache_.size();
 	header.numGeometryShaders = 0;
+	header.hasSPIRV = g_Config.bShaderCacheSPIRV ? 1 : 0;
 	bool writeFailed = fwrite(&header, sizeof(header), 1, f) != 1;
 	vsCache_.Iterate([&](const VShaderID &id, VulkanVertexShader *vs) {
 		writeFailed = writeFailed || fwrite(&id, sizeof(id), 1, f) != 1;
@@ -525,6 +678,15 @@ void ShaderManagerVulkan::SaveCache(FILE *f, DrawEngineVulkan *drawEngine) {
 	fsCache_.Iterate([&](const FShaderID &id, VulkanFragmentShader *fs) {
 		writeFailed = writeFailed || fwrite(&id, sizeof(id), 1, f) != 1;
 	});
+	if (header.hasSPIRV) {
+		// Same order as the IDs. Shaders compiled before the option was enabled just get an empty entry.
+		vsCache_.Iterate([&](const VShaderID &id, VulkanVertexShader *vs) {
+			writeFailed = writeFailed || !WriteCachedSPIRV(f, vs->source(), vs->GetSPIRV());
+		});
+		fsCache_.Iterate([&](const FShaderID &id, VulkanFragmentShader *fs) {
+			writeFailed = writeFailed || !WriteCachedSPIRV(f, fs->source(), fs->GetSPIRV());
+		});
+	}
 	if (writeFailed) {
 		ERROR_LOG(Log::G3D, "Failed to write Vulkan shader cache, disk full?");
 	} else {
@@ -20,6 +20,7 @@
 #include <cstdio>
 #include <cstdint>
 #include <mutex>
+#include <vector>
 
 #include "Common/Thread/Promise.h"
 #include "Common/Data/Collections/Hashmaps.h"
@@ -40,7 +41,8 @@ class VulkanPushPool;
 
 class VulkanFragmentShader {
 public:
-	VulkanFragmentShader(VulkanContext *vulkan, FShaderID id, FragmentShaderFlags flags, const char *code);
+	// If spirv is non-empty, it's used as-is (moved from) instead of compiling code.
+	VulkanFragmentShader(VulkanContext *vulkan, FShaderID id, FragmentShaderFlags flags, const char *code, std::vector<uint32_t> *spirv = nullptr);
 	~VulkanFragmentShader();
 
 	const std::string &source() const { return source_; }
@@ -48,6 +50,8 @@ class VulkanFragmentShader {
 	std::string GetShaderString(DebugShaderStringType type) const;
 	Promise<VkShaderModule> *GetModule() { return module_; }
 	const FShaderID &GetID() const { return id_; }
+	// Blocks until compiled. Empty unless bShaderCacheSPIRV is enabled.
+	const std::vector<uint32_t> &GetSPIRV();
 
 	FragmentShaderFlags Flags() const { return flags_;  }
 
@@ -56,6 +60,7 @@ class VulkanFragmentShader {
 
 	VulkanContext *vulkan_;
 	std::string source_;
+	std::vector<uint32_t> spirv_;
 	bool failed_ = false;
 	FShaderID id_;
 	FragmentShaderFlags flags_;
@@ -63,7 +68,7 @@ class VulkanFragmentShader {
 
 class VulkanVertexShader {
 public:
-	VulkanVertexShader(VulkanContext *vulkan, VShaderID id, VertexShaderFlags flags, const char *code, bool useHWTransform);
+	VulkanVertexShader(VulkanContext *vulkan, VShaderID id, VertexShaderFlags flags, const char *code, bool useHWTransform, std::vector<uint32_t> *spirv = nullptr);
 	~VulkanVertexShader();
 
 	const std::string &source() const { return source_; }
@@ -74,12 +79,15 @@ class VulkanVertexShader {
 	std::string GetShaderString(DebugShaderStringType type) const;
 	Promise<VkShaderModule> *GetModule() { return module_; }
 	const VShaderID &GetID() const { return id_; }
+	// Blocks until compiled. Empty unless bShaderCacheSPIRV is enabled.
+	const std::vector<uint32_t> &GetSPIRV();
 
 protected:
 	Promise<VkShaderModule> *module_ = nullptr;
 
 	VulkanContext *vulkan_;
 	std::string source_;
+	std::vector<uint32_t> spirv_;
 	bool useHWTransform_;
 	VShaderID id_;
 	VertexShaderFlags flags_;
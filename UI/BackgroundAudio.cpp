@@ -208,7 +208,7 @@ class AT3PlusReader {
 	~AT3PlusReader() {
 		delete[] buffer_;
 		buffer_ = nullptr;
-		delete decoder_;
+		ReleaseAudioDecoder(decoder_);
 		decoder_ = nullptr;
 	}
 
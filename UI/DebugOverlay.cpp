@@ -8,6 +8,7 @@
 
 #include "Core/MIPS/MIPS.h"
 #include "Core/HW/Display.h"
+#include "Core/HW/SimpleAudioDec.h"
 #include "Core/FrameTiming.h"
 #include "Core/HLE/sceSas.h"
 #include "Core/HLE/sceKernel.h"
@@ -81,6 +82,7 @@ static void DrawAudioDebugStats(UIContext *ctx, const Bounds &bounds) {
 	float left = std::max(bounds.w / 2 - 20.0f, 500.0f);
 
 	__SasGetDebugStats(statbuf, sizeof(statbuf));
+	GetAudioDecoderPoolDebugText(statbuf, sizeof(statbuf));
 	ctx->Draw()->DrawTextRect(ubuntu24, statbuf, bounds.x + left + 21, bounds.y + 31, bounds.w - left, bounds.h - 30, 0xc0000000, FLAG_DYNAMIC_ASCII);
 	ctx->Draw()->DrawTextRect(ubuntu24, statbuf, bounds.x + left + 20, bounds.y + 30, bounds.w - left, bounds.h - 30, 0xFFFFFFFF, FLAG_DYNAMIC_ASCII);
 
@@ -193,6 +195,8 @@ static void DrawFrameTiming(UIContext *ctx, const Bounds &bounds) {
 				"* Past fence: %0.1f ms\n"
 				"* Submit #1: %0.1f ms\n"
 				"* Queue-p: %0.1f ms\n"
+				"* Host wait: %0.2f ms\n"
+				"* RT idle: %0.2f ms\n"
 				"%s",
 				stride * 1000.0,
 				data.waitCount,
@@ -200,6 +204,8 @@ static void DrawFrameTiming(UIContext *ctx, const Bounds &bounds) {
 				fenceLatency_s * 1000.0,
 				submitLatency_s * 1000.0,
 				queuePresentLatency_s * 1000.0,
+				data.hostHandoffWait * 1000.0,
+				data.renderThreadIdle * 1000.0,
 				presentStats
 			);
 		}
@@ -46,6 +46,7 @@
 #include "Core/HLE/sceAudiocodec.h"
 #include "Core/HLE/sceMp3.h"
 #include "Core/HLE/AtracCtx.h"
+#include "Core/HLE/AtracCtx2.h"
 #include "Core/HLE/sceSas.h"
 #include "Core/HW/SasAudio.h"
 #include "Core/HW/Display.h"
@@ -1204,6 +1205,13 @@ void DrawMediaDecodersView(ImConfig &cfg, ImControl &control) {
 
 	if (ImGui::CollapsingHeaderWithCount("sceAtrac", atracCount, ImGuiTreeNodeFlags_DefaultOpen)) {
 		ImGui::Checkbox("Force FFMPEG", &g_Config.bForceFfmpegForAudioDec);
+		if (g_Config.bAtracSpeculativeDecode) {
+			u64 hits, misses;
+			GetAtracSpeculationStats(&hits, &misses);
+			ImGui::Text("Speculative decode: %llu hits, %llu misses", (unsigned long long)hits, (unsigned long long)misses);
+		}
+		const AudioDecoderPoolStats poolStats = GetAudioDecoderPoolStats();
+		ImGui::Text("Decoders: %u created, %u reused, %u released, %u freed, %u pooled", poolStats.created, poolStats.reused, poolStats.released, poolStats.freed, poolStats.pooled);
 		if (ImGui::BeginTable("atracs", 8, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersH)) {
 			ImGui::TableSetupColumn("Index", ImGuiTableColumnFlags_WidthFixed);
 			ImGui::TableSetupColumn("Mute", ImGuiTableColumnFlags_WidthFixed);
@@ -603,6 +603,7 @@ EXEC_AND_LIB_FILES := \
   $(SRC)/Core/HW/MediaEngine.cpp.arm \
   $(SRC)/Core/HW/SasAudio.cpp.arm \
   $(SRC)/Core/HW/SasReverb.cpp.arm \
+  $(SRC)/Core/HW/PolyphaseFilter.cpp \
   $(SRC)/Core/HW/StereoResampler.cpp.arm \
   $(SRC)/Core/HW/GranularMixer.cpp.arm \
   $(SRC)/Core/ControlMapper.cpp \
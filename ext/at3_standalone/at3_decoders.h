@@ -14,13 +14,20 @@ struct ATRAC3PContext;
 
 // If the block_align passed in is 0, tries to audio detect.
 // flush_buffers should be called when seeking before the next decode_frame.
+// reset returns the context to the state it had right after alloc, to start a new stream with the same parameters.
+// copy_state makes dst continue the stream exactly like src would. Both must have been allocated with the same
+// parameters, returns -1 if they weren't.
 
 ATRAC3Context *atrac3_alloc(int channels, int *block_align, const uint8_t *extra_data, int extra_data_size);
 void atrac3_free(ATRAC3Context *ctx);
 void atrac3_flush_buffers(ATRAC3Context *ctx);
+void atrac3_reset(ATRAC3Context *ctx);
+int atrac3_copy_state(ATRAC3Context *dst, const ATRAC3Context *src);
 int atrac3_decode_frame(ATRAC3Context *ctx, float *out_data[2], int *nb_samples, const uint8_t *buf, int buf_size);
 
 ATRAC3PContext *atrac3p_alloc(int channels, int *block_align);
 void atrac3p_free(ATRAC3PContext *ctx);
 void atrac3p_flush_buffers(ATRAC3PContext *ctx);
+void atrac3p_reset(ATRAC3PContext *ctx);
+int atrac3p_copy_state(ATRAC3PContext *dst, const ATRAC3PContext *src);
 int atrac3p_decode_frame(ATRAC3PContext *ctx, float *out_data[2], int *nb_samples, const uint8_t *buf, int buf_size);
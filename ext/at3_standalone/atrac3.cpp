@@ -771,6 +771,45 @@ void atrac3_flush_buffers(ATRAC3Context *c) {
 	memset(c->temp_buf, 0, sizeof(c->temp_buf));
 }
 
+static void init_joint_stereo(ATRAC3Context *q) {
+    int i;
+
+    q->weighting_delay[0] = 0;
+    q->weighting_delay[1] = 7;
+    q->weighting_delay[2] = 0;
+    q->weighting_delay[3] = 7;
+    q->weighting_delay[4] = 0;
+    q->weighting_delay[5] = 7;
+
+    for (i = 0; i < 4; i++) {
+        q->matrix_coeff_index_prev[i] = 3;
+        q->matrix_coeff_index_now[i]  = 3;
+        q->matrix_coeff_index_next[i] = 3;
+    }
+}
+
+void atrac3_reset(ATRAC3Context *c) {
+	// Unlike flush_buffers, this clears everything a previous stream can leave behind.
+	memset(c->temp_buf, 0, sizeof(c->temp_buf));
+	memset(c->units, 0, c->channels * sizeof(*c->units));
+	init_joint_stereo(c);
+}
+
+int atrac3_copy_state(ATRAC3Context *dst, const ATRAC3Context *src) {
+	if (dst->channels != src->channels || dst->block_align != src->block_align ||
+		dst->coding_mode != src->coding_mode || dst->scrambled_stream != src->scrambled_stream) {
+		return -1;
+	}
+	// Everything that carries over from one frame to the next. The rest is either constant or rebuilt every frame.
+	memcpy(dst->units, src->units, src->channels * sizeof(*src->units));
+	memcpy(dst->matrix_coeff_index_prev, src->matrix_coeff_index_prev, sizeof(dst->matrix_coeff_index_prev));
+	memcpy(dst->matrix_coeff_index_now, src->matrix_coeff_index_now, sizeof(dst->matrix_coeff_index_now));
+	memcpy(dst->matrix_coeff_index_next, src->matrix_coeff_index_next, sizeof(dst->matrix_coeff_index_next));
+	memcpy(dst->weighting_delay, src->weighting_delay, sizeof(dst->weighting_delay));
+	memcpy(dst->temp_buf, src->temp_buf, sizeof(dst->temp_buf));
+	return 0;
+}
+
 static void atrac3_init_static_data(void)
 {
     int i;
@@ -792,7 +831,7 @@ static void atrac3_init_static_data(void)
 static int static_init_done;
 
 ATRAC3Context *atrac3_alloc(int channels, int *block_align, const uint8_t *extra_data, int extra_data_size) {
-    int i, ret;
+    int ret;
     int version, delay, samples_per_frame, frame_factor;
 
     const uint8_t *edata_ptr = extra_data;
@@ -910,18 +949,7 @@ ATRAC3Context *atrac3_alloc(int channels, int *block_align, const uint8_t *extra
     }
 
     /* init the joint-stereo decoding data */
-    q->weighting_delay[0] = 0;
-    q->weighting_delay[1] = 7;
-    q->weighting_delay[2] = 0;
-    q->weighting_delay[3] = 7;
-    q->weighting_delay[4] = 0;
-    q->weighting_delay[5] = 7;
-
-    for (i = 0; i < 4; i++) {
-        q->matrix_coeff_index_prev[i] = 3;
-        q->matrix_coeff_index_now[i]  = 3;
-        q->matrix_coeff_index_next[i] = 3;
-    }
+    init_joint_stereo(q);
 
     ff_atrac_init_gain_compensation(&q->gainc_ctx, 4, 3);
 
@@ -125,8 +125,27 @@ static int set_channel_params(ATRAC3PContext *ctx, int channels) {
     return 0;
 }
 
+static void init_channel_units(ATRAC3PContext *ctx) {
+    int i, ch;
+
+    for (i = 0; i < ctx->num_channel_blocks; i++) {
+        for (ch = 0; ch < 2; ch++) {
+            ctx->ch_units[i].channels[ch].ch_num          = ch;
+            ctx->ch_units[i].channels[ch].wnd_shape       = &ctx->ch_units[i].channels[ch].wnd_shape_hist[0][0];
+            ctx->ch_units[i].channels[ch].wnd_shape_prev  = &ctx->ch_units[i].channels[ch].wnd_shape_hist[1][0];
+            ctx->ch_units[i].channels[ch].gain_data       = &ctx->ch_units[i].channels[ch].gain_data_hist[0][0];
+            ctx->ch_units[i].channels[ch].gain_data_prev  = &ctx->ch_units[i].channels[ch].gain_data_hist[1][0];
+            ctx->ch_units[i].channels[ch].tones_info      = &ctx->ch_units[i].channels[ch].tones_info_hist[0][0];
+            ctx->ch_units[i].channels[ch].tones_info_prev = &ctx->ch_units[i].channels[ch].tones_info_hist[1][0];
+        }
+
+        ctx->ch_units[i].waves_info      = &ctx->ch_units[i].wave_synth_hist[0];
+        ctx->ch_units[i].waves_info_prev = &ctx->ch_units[i].wave_synth_hist[1];
+    }
+}
+
 ATRAC3PContext *atrac3p_alloc(int channels, int *block_align) {
-    int i, ch, ret;
+    int ret;
 
     ATRAC3PContext *ctx = (ATRAC3PContext *)av_mallocz(sizeof(ATRAC3PContext));
 	ctx->block_align = *block_align;
@@ -159,21 +178,7 @@ ATRAC3PContext *atrac3p_alloc(int channels, int *block_align) {
         return nullptr;
     }
 
-    for (i = 0; i < ctx->num_channel_blocks; i++) {
-        for (ch = 0; ch < 2; ch++) {
-            ctx->ch_units[i].channels[ch].ch_num          = ch;
-            ctx->ch_units[i].channels[ch].wnd_shape       = &ctx->ch_units[i].channels[ch].wnd_shape_hist[0][0];
-            ctx->ch_units[i].channels[ch].wnd_shape_prev  = &ctx->ch_units[i].channels[ch].wnd_shape_hist[1][0];
-            ctx->ch_units[i].channels[ch].gain_data       = &ctx->ch_units[i].channels[ch].gain_data_hist[0][0];
-            ctx->ch_units[i].channels[ch].gain_data_prev  = &ctx->ch_units[i].channels[ch].gain_data_hist[1][0];
-            ctx->ch_units[i].channels[ch].tones_info      = &ctx->ch_units[i].channels[ch].tones_info_hist[0][0];
-            ctx->ch_units[i].channels[ch].tones_info_prev = &ctx->ch_units[i].channels[ch].tones_info_hist[1][0];
-        }
-
-        ctx->ch_units[i].waves_info      = &ctx->ch_units[i].wave_synth_hist[0];
-        ctx->ch_units[i].waves_info_prev = &ctx->ch_units[i].wave_synth_hist[1];
-    }
-
+    init_channel_units(ctx);
     return ctx;
 }
 
@@ -362,3 +367,46 @@ int atrac3p_decode_frame(ATRAC3PContext *ctx, float *out_data[2], int *nb_sample
 void atrac3p_flush_buffers(ATRAC3PContext *ctx) {
 	// TODO: Not sure what should be zeroed here.
 }
+
+void atrac3p_reset(ATRAC3PContext *ctx) {
+	// Back to the state right after alloc, so the context can be reused for a new stream.
+	memset(ctx->samples, 0, sizeof(ctx->samples));
+	memset(ctx->mdct_buf, 0, sizeof(ctx->mdct_buf));
+	memset(ctx->time_buf, 0, sizeof(ctx->time_buf));
+	memset(ctx->outp_buf, 0, sizeof(ctx->outp_buf));
+	memset(ctx->ch_units, 0, ctx->num_channel_blocks * sizeof(*ctx->ch_units));
+	init_channel_units(ctx);
+}
+
+// The history pointers in a channel unit point into the unit itself, so they have to follow it when copied.
+template <class T>
+static T *rebase_ptr(T *ptr, const Atrac3pChanUnitCtx *src, Atrac3pChanUnitCtx *dst) {
+	return (T *)((uint8_t *)dst + ((const uint8_t *)ptr - (const uint8_t *)src));
+}
+
+int atrac3p_copy_state(ATRAC3PContext *dst, const ATRAC3PContext *src) {
+	if (dst->num_channel_blocks != src->num_channel_blocks || memcmp(dst->channel_blocks, src->channel_blocks, sizeof(dst->channel_blocks)) != 0) {
+		return -1;
+	}
+	memcpy(dst->samples, src->samples, sizeof(dst->samples));
+	memcpy(dst->mdct_buf, src->mdct_buf, sizeof(dst->mdct_buf));
+	memcpy(dst->time_buf, src->time_buf, sizeof(dst->time_buf));
+	memcpy(dst->outp_buf, src->outp_buf, sizeof(dst->outp_buf));
+	memcpy(dst->ch_units, src->ch_units, src->num_channel_blocks * sizeof(*src->ch_units));
+	for (int i = 0; i < src->num_channel_blocks; i++) {
+		const Atrac3pChanUnitCtx *s = &src->ch_units[i];
+		Atrac3pChanUnitCtx *d = &dst->ch_units[i];
+		for (int ch = 0; ch < 2; ch++) {
+			d->channels[ch].wnd_shape       = rebase_ptr(s->channels[ch].wnd_shape, s, d);
+			d->channels[ch].wnd_shape_prev  = rebase_ptr(s->channels[ch].wnd_shape_prev, s, d);
+			d->channels[ch].gain_data       = rebase_ptr(s->channels[ch].gain_data, s, d);
+			d->channels[ch].gain_data_prev  = rebase_ptr(s->channels[ch].gain_data_prev, s, d);
+			d->channels[ch].tones_info      = rebase_ptr(s->channels[ch].tones_info, s, d);
+			d->channels[ch].tones_info_prev = rebase_ptr(s->channels[ch].tones_info_prev, s, d);
+		}
+		d->waves_info      = rebase_ptr(s->waves_info, s, d);
+		d->waves_info_prev = rebase_ptr(s->waves_info_prev, s, d);
+	}
+	dst->block_align = src->block_align;
+	return 0;
+}
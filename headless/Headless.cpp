@@ -28,6 +28,7 @@
 #include <csignal>
 #endif
 #include "Common/CPUDetect.h"
+#include "Common/Data/Format/JSONWriter.h"
 #include "Common/File/VFS/VFS.h"
 #include "Common/File/VFS/ZipFileReader.h"
 #include "Common/File/VFS/DirectoryReader.h"
@@ -41,9 +42,12 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/System.h"
+#include "Core/WaveFile.h"
 #include "Core/WebServer.h"
+#include "Core/HLE/__sceAudio.h"
 #include "Core/HLE/sceUtility.h"
 #include "Core/SaveState.h"
+#include "Core/Util/AudioFormat.h"
 #include "GPU/GPUCommon.h"
 #include "GPU/Common/FramebufferManagerCommon.h"
 #include "Common/Log.h"
@@ -58,6 +62,9 @@
 #endif
 
 static HeadlessHost *g_headlessHost;
+// Only set during a run with --audio-dump.
+static WaveFileWriter *g_audioDump;
+static u64 g_audioDumpFrames;
 
 #if PPSSPP_PLATFORM(ANDROID)
 JNIEnv *getEnv() {
@@ -119,7 +126,20 @@ void System_AskForPermission(SystemPermission permission) {}
 PermissionStatus System_GetPermissionStatus(SystemPermission permission) { return PERMISSION_STATUS_GRANTED; }
 void System_AudioGetDebugStats(char *buf, size_t bufSize) { if (buf) buf[0] = '\0'; }
 void System_AudioClear() {}
-void System_AudioPushSamples(const s32 *audio, int numSamples, float volume) {}
+void System_AudioPushSamples(const s32 *audio, int numSamples, float volume) {
+	if (!g_audioDump)
+		return;
+	// Same volume handling as the real mixers, but no resampling.
+	s16 buffer[512];
+	const int volume12 = (int)(volume * 4096.0f);
+	for (int done = 0; done < numSamples; ) {
+		int count = std::min(numSamples - done, (int)ARRAY_SIZE(buffer) / 2);
+		ClampBufferToS16WithVolume(buffer, audio + done * 2, count * 2, volume12);
+		g_audioDump->AddStereoSamples(buffer, count);
+		done += count;
+	}
+	g_audioDumpFrames += numSamples;
+}
 
 // TODO: To avoid having to define these here, these should probably be turned into system "requests".
 bool NativeSaveSecret(std::string_view nameOfSecret, std::string_view data) { return false; }
@@ -152,6 +172,11 @@ int printUsage(const char *progname, const char *reason)
 	fprintf(stderr, "  -j                    use jit (default)\n");
 	fprintf(stderr, "  -c, --compare         compare with output in file.expected\n");
 	fprintf(stderr, "  --bench               run multiple times and output speed\n");
+	fprintf(stderr, "  --gpu-stats=FILE      write per-frame GPU stats to FILE, one JSON object per line\n");
+	fprintf(stderr, "  --audio-dump=FILE     write the mixed audio to FILE as WAV, and output audio CPU time\n");
+	fprintf(stderr, "                        per subsystem (with several tests, the test name is appended)\n");
+	fprintf(stderr, "  --throughput          don't present, rasterize asynchronously (software only),\n");
+	fprintf(stderr, "                        and output emulated frames per second\n");
 	fprintf(stderr, "\nSee headless.txt for details.\n");
 
 	return 1;
@@ -174,11 +199,28 @@ static HeadlessHost *getHost(GPUCore gpuCore) {
 struct AutoTestOptions {
 	double timeout;
 	double maxScreenshotError;
+	FILE *gpuStatsFile;
+	const char *audioDumpFilename;
 	bool compare : 1;
 	bool verbose : 1;
 	bool bench : 1;
+	bool throughput : 1;
+	bool audioDumpPerTest : 1;
 };
 
+static void WriteGPUStatsLines(FILE *f) {
+	static uint32_t lastId = 0;
+	for (const GPUStatsFrameRecord &record : gpuStatsHistory.GetSince(lastId)) {
+		json::JsonWriter j;
+		j.begin();
+		j.writeString("test", currentTestName);
+		GPUStatsFrameRecordToJSON(j, record);
+		j.end();
+		fprintf(f, "%s\n", j.str().c_str());
+		lastId = record.id;
+	}
+}
+
 bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const AutoTestOptions &opt) {
 	// Kinda ugly, trying to guesstimate the test name from filename...
 	currentTestName = GetTestName(coreParameter.fileToStart);
@@ -216,7 +258,25 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const
 
 	System_Notify(SystemNotification::BOOT_DONE);
 
-	PSP_UpdateDebugStats((DebugOverlay)g_Config.iDebugOverlay == DebugOverlay::DEBUG_STATS || g_Config.bLogFrameDrops);
+	WaveFileWriter audioDump;
+	if (opt.audioDumpFilename) {
+		std::string filename = opt.audioDumpFilename;
+		if (opt.audioDumpPerTest) {
+			if (endsWithNoCase(filename, ".wav"))
+				filename.resize(filename.size() - 4);
+			filename += "_" + ReplaceAll(currentTestName, "/", "_") + ".wav";
+		}
+		if (audioDump.Start(Path(filename), 44100)) {
+			g_audioDump = &audioDump;
+			g_audioDumpFrames = 0;
+			__AudioResetTimings();
+			__AudioSetCollectTimings(true);
+		} else {
+			fprintf(stderr, "Failed to open %s for writing audio.\n", filename.c_str());
+		}
+	}
+
+	PSP_UpdateDebugStats((DebugOverlay)g_Config.iDebugOverlay == DebugOverlay::DEBUG_STATS || g_Config.bLogFrameDrops || opt.gpuStatsFile);
 
 	if (gpu) {
 		gpu->BeginHostFrame(g_Config.GetDisplayLayoutConfig(DeviceOrientation::Landscape));
@@ -227,7 +287,9 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const
 	}
 
 	bool passed = true;
-	double deadline = time_now_d() + opt.timeout;
+	double startTime = time_now_d();
+	double deadline = startTime + opt.timeout;
+	int frames = 0;
 	coreState = coreParameter.startBreak ? CORE_STEPPING_CPU : CORE_RUNNING_CPU;
 	while (coreState == CORE_RUNNING_CPU || coreState == CORE_STEPPING_CPU)
 	{
@@ -237,7 +299,14 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const
 		// If we were rendering, this might be a nice time to do something about it.
 		if (coreState == CORE_NEXTFRAME) {
 			coreState = CORE_RUNNING_CPU;
-			headlessHost->SwapBuffers();
+			frames++;
+			if (!opt.throughput)
+				headlessHost->SwapBuffers();
+			if (opt.gpuStatsFile) {
+				// Closes out this frame's stats into the history.
+				PSP_UpdateDebugStats(true);
+				WriteGPUStatsLines(opt.gpuStatsFile);
+			}
 		}
 		if (coreState == CORE_STEPPING_CPU && !coreParameter.startBreak) {
 			break;
@@ -261,6 +330,12 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const
 			Core_Stop();
 		}
 	}
+	double elapsed = time_now_d() - startTime;
+	if (opt.gpuStatsFile) {
+		PSP_UpdateDebugStats(true);
+		WriteGPUStatsLines(opt.gpuStatsFile);
+		fflush(opt.gpuStatsFile);
+	}
 	if (gpu) {
 		gpu->EndHostFrame();
 	}
@@ -279,9 +354,26 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, const
 
 	PSP_Shutdown(true);
 
+	if (g_audioDump) {
+		__AudioSetCollectTimings(false);
+		g_audioDump = nullptr;
+		audioDump.Stop();
+	}
+
 	if (!opt.bench)
 		headlessHost->FlushDebugOutput();
 
+	if (opt.throughput) {
+		printf("  %s - %d frames in %0.2f seconds, %0.1f emulated fps\n", currentTestName.c_str(), frames, elapsed, elapsed > 0.0 ? frames / elapsed : 0.0);
+	}
+	if (opt.audioDumpFilename) {
+		double audioSeconds = g_audioDumpFrames / 44100.0;
+		printf("  %s - %0.2f seconds of audio in %0.2f seconds (%0.1fx realtime), sas %0.3f, atrac %0.3f, mp3 %0.3f, mixer %0.3f seconds\n",
+			currentTestName.c_str(), audioSeconds, elapsed, elapsed > 0.0 ? audioSeconds / elapsed : 0.0,
+			__AudioGetTimingSeconds(AudioTimingCategory::SAS), __AudioGetTimingSeconds(AudioTimingCategory::ATRAC),
+			__AudioGetTimingSeconds(AudioTimingCategory::MP3), __AudioGetTimingSeconds(AudioTimingCategory::MIXER));
+	}
+
 	if (opt.compare && passed)
 		passed = CompareOutput(coreParameter.fileToStart, output, opt.verbose);
 
@@ -376,6 +468,7 @@ int main(int argc, const char* argv[])
 	const char *mountIso = nullptr;
 	const char *mountRoot = nullptr;
 	const char *screenshotFilename = nullptr;
+	const char *gpuStatsFilename = nullptr;
 
 	for (int i = 1; i < argc; i++)
 	{
@@ -407,6 +500,12 @@ int main(int argc, const char* argv[])
 			testOptions.compare = true;
 		else if (!strcmp(argv[i], "--bench"))
 			testOptions.bench = true;
+		else if (!strcmp(argv[i], "--throughput"))
+			testOptions.throughput = true;
+		else if (!strncmp(argv[i], "--gpu-stats=", strlen("--gpu-stats=")) && strlen(argv[i]) > strlen("--gpu-stats="))
+			gpuStatsFilename = argv[i] + strlen("--gpu-stats=");
+		else if (!strncmp(argv[i], "--audio-dump=", strlen("--audio-dump=")) && strlen(argv[i]) > strlen("--audio-dump="))
+			testOptions.audioDumpFilename = argv[i] + strlen("--audio-dump=");
 		else if (!strcmp(argv[i], "-v") || !strcmp(argv[i], "--verbose"))
 			testOptions.verbose = true;
 		else if (!strcmp(argv[i], "--old-atrac"))
@@ -471,6 +570,7 @@ int main(int argc, const char* argv[])
 
 	if (testFilenames.empty())
 		return printUsage(argv[0], argc <= 1 ? NULL : "No executables specified");
+	testOptions.audioDumpPerTest = testFilenames.size() > 1;
 
 	g_Config.bEnableLogging = (fullLog || outputDebugStringLog);
 	g_logManager.Init(&g_Config.bEnableLogging, outputDebugStringLog);
@@ -504,6 +604,7 @@ int main(int argc, const char* argv[])
 	coreParameter.mountRoot = mountRoot ? Path(mountRoot) : Path();
 	coreParameter.startBreak = false;
 	coreParameter.headLess = true;
+	coreParameter.softGPUDeferListFlush = testOptions.throughput;
 	coreParameter.renderScaleFactor = 1;
 	coreParameter.renderWidth = 480;
 	coreParameter.renderHeight = 272;
@@ -520,7 +621,8 @@ int main(int argc, const char* argv[])
 
 	// NOTE: In headless mode, we never save the config. This is just for this run.
 	g_Config.iDumpFileTypes = 0;
-	g_Config.bEnableSound = false;
+	// Sound only needs to be mixed when we're dumping it. Either way, there's no host audio and no throttling.
+	g_Config.bEnableSound = testOptions.audioDumpFilename != nullptr;
 	g_Config.bFirstRun = false;
 	g_Config.bIgnoreBadMemAccess = true;  // NOTE: A few tests rely on this, which is BAD: threads/mbx/refer/refer , threads/mbx/send/send, threads/vtimers/interrupt
 	// Never report from tests.
@@ -589,6 +691,12 @@ int main(int argc, const char* argv[])
 		nextPath = nextPath.NavigateUp();
 	}
 
+	if (gpuStatsFilename) {
+		testOptions.gpuStatsFile = File::OpenCFile(Path(std::string(gpuStatsFilename)), "w");
+		if (!testOptions.gpuStatsFile)
+			fprintf(stderr, "Failed to open %s for writing GPU stats.\n", gpuStatsFilename);
+	}
+
 	if (screenshotFilename)
 		headlessHost->SetComparisonScreenshot(Path(std::string(screenshotFilename)), testOptions.maxScreenshotError);
 	headlessHost->SetWriteFailureScreenshot(!teamCityMode && !getenv("GITHUB_ACTIONS") && !testOptions.bench);
@@ -666,6 +774,9 @@ int main(int argc, const char* argv[])
 		}
 	}
 
+	if (testOptions.gpuStatsFile)
+		fclose(testOptions.gpuStatsFile);
+
 	if (debuggerPort > 0) {
 		ShutdownWebServer();
 	}
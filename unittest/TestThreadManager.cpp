@@ -9,6 +9,7 @@
 #include "Common/Thread/Channel.h"
 #include "Common/Thread/Promise.h"
 #include "Common/Thread/ParallelLoop.h"
+#include "Common/Thread/SPSCRing.h"
 #include "Common/Thread/ThreadUtil.h"
 #include "Common/Thread/Waitable.h"
 
@@ -124,6 +125,36 @@ bool TestMultithreadedScheduling() {
 	return true;
 }
 
+bool TestSPSCRing() {
+	// Small ring to exercise both the full and the empty (sleeping consumer) paths.
+	static SPSCRing<int, 4> ring;
+	const int count = 100000;
+
+	std::thread producer([] {
+		for (int i = 0; i < count; i++) {
+			ring.Push(i);
+			if ((i & 1023) == 0) {
+				sleep_ms(1, "spsc-test");
+			}
+		}
+	});
+
+	double idle = 0.0;
+	int mismatches = 0;
+	for (int i = 0; i < count; i++) {
+		int value = -1;
+		idle += ring.Pop(&value);
+		if (value != i)
+			mismatches++;
+	}
+	producer.join();
+
+	EXPECT_EQ_INT(mismatches, 0);
+	EXPECT_TRUE(ring.Empty());
+	printf("SPSC ring: consumer idle %0.1f ms\n", idle * 1000.0);
+	return true;
+}
+
 bool TestThreadManager() {
 	ThreadManager manager;
 	manager.Init(8, 1);
@@ -152,5 +183,9 @@ bool TestThreadManager() {
 		return false;
 	}
 
+	if (!TestSPSCRing()) {
+		return false;
+	}
+
 	return true;
 }
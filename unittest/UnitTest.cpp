@@ -39,6 +39,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <cmath>
 #include <vector>
 #include <string>
@@ -70,6 +71,7 @@
 #include "Common/Render/DrawBuffer.h"
 #include "Common/System/NativeApp.h"
 #include "Common/System/System.h"
+#include "Common/Thread/ThreadManager.h"
 #include "Common/Thread/ThreadUtil.h"
 #include "Common/Data/Format/IniFile.h"
 #include "Common/TimeUtil.h"
@@ -85,12 +87,19 @@
 #include "Common/File/VFS/DirectoryReader.h"
 #include "Common/Math/fast/fast_matrix.h"
 #include "Core/FileSystems/ISOFileSystem.h"
+#include "Core/HW/AudioRing.h"
+#include "Core/HW/PolyphaseFilter.h"
+#include "Core/HW/SasAudio.h"
+#include "Core/HW/SimpleAudioDec.h"
 #include "Core/MemMap.h"
 #include "Core/KeyMap.h"
+#include "Core/Util/AudioFormat.h"
 #include "Core/Util/PathUtil.h"
 #include "Core/MIPS/MIPSVFPUUtils.h"
 #include "GPU/Common/TextureDecoder.h"
+#include "GPU/Common/SplineCommon.h"
 #include "GPU/Common/GPUStateUtils.h"
+#include "GPU/GPU.h"
 #include "GPU/Math3D.h"
 
 #include "Common/File/AndroidContentURI.h"
@@ -640,6 +649,277 @@ bool TestQuickTexHash() {
 	return true;
 }
 
+// Deterministic pseudo-random numbers (an LCG), so test failures reproduce.
+class TestRandom {
+public:
+	explicit TestRandom(uint32_t seed) : seed_(seed) {}
+	uint32_t operator()() {
+		seed_ = seed_ * 1664525 + 1013904223;
+		return seed_ >> 8;
+	}
+
+private:
+	uint32_t seed_;
+};
+
+// Calls func repeatedly for a quarter of a second, returns the average seconds per call.
+template <typename F>
+static double BenchmarkSeconds(F func) {
+	int total = 0;
+	double st = time_now_d();
+	do {
+		func();
+		++total;
+	} while (time_now_d() - st < 0.25);
+	return (time_now_d() - st) / total;
+}
+
+template <typename F>
+static double TextureDecodeMBPerSec(size_t bytesPerRun, F func) {
+	return bytesPerRun / BenchmarkSeconds(func) / (1024.0 * 1024.0);
+}
+
+bool TestTextureDecodeFuncs() {
+	SetupTextureDecoder();
+	const TextureDecodeFuncs &fast = textureDecodeFuncs;
+	const TextureDecodeFuncs &generic = genericTextureDecodeFuncs;
+
+	static const int W = 512;
+	static const int H = 256;
+	std::vector<u8> src(W * H * 4);
+	std::vector<u32> out1(W * H), out2(W * H);
+	u32 clut32[256];
+	u16 clut16[16];
+	TestRandom nextRandom(0x12345678);
+	for (auto &b : src)
+		b = (u8)nextRandom();
+
+	// Odd lengths to also cover the scalar tails.
+	static const int lengths[] = { 1, 7, 31, 32, 33, 100, W };
+	// Opaque CLUTs, then varying alpha, then a single translucent entry, to check the alpha sums.
+	for (int alphaMode = 0; alphaMode < 3; ++alphaMode) {
+		for (int i = 0; i < 256; ++i) {
+			u32 alpha = alphaMode == 1 ? (u32)(i * 0x11) << 24 : 0xFF000000;
+			if (alphaMode == 2 && i == 200)
+				alpha = 0x7F000000;
+			clut32[i] = alpha | (i * 0x010307);
+		}
+		for (int i = 0; i < 16; ++i) {
+			u16 alpha = alphaMode == 1 ? (u16)(i << 12) : 0xF000;
+			if (alphaMode == 2 && i == 5)
+				alpha = 0x7000;
+			clut16[i] = alpha | (i * 0x0123 & 0x0FFF);
+		}
+		for (int length : lengths) {
+			u32 alpha1 = 0xFFFFFFFF, alpha2 = 0xFFFFFFFF;
+			generic.deIndex4To16((u16 *)out1.data(), src.data(), length, clut16, &alpha1);
+			fast.deIndex4To16((u16 *)out2.data(), src.data(), length, clut16, &alpha2);
+			EXPECT_EQ_INT(memcmp(out1.data(), out2.data(), length * sizeof(u16)), 0);
+			EXPECT_EQ_HEX(alpha1, alpha2);
+
+			alpha1 = 0xFFFFFFFF, alpha2 = 0xFFFFFFFF;
+			generic.deIndex4To32(out1.data(), src.data(), length, clut32, &alpha1);
+			fast.deIndex4To32(out2.data(), src.data(), length, clut32, &alpha2);
+			EXPECT_EQ_INT(memcmp(out1.data(), out2.data(), length * sizeof(u32)), 0);
+			EXPECT_EQ_HEX(alpha1, alpha2);
+
+			alpha1 = 0xFFFFFFFF, alpha2 = 0xFFFFFFFF;
+			generic.deIndex8To32(out1.data(), src.data(), length, clut32, &alpha1);
+			fast.deIndex8To32(out2.data(), src.data(), length, clut32, &alpha2);
+			EXPECT_EQ_INT(memcmp(out1.data(), out2.data(), length * sizeof(u32)), 0);
+			EXPECT_EQ_HEX(alpha1, alpha2);
+		}
+	}
+
+	// A 512x256 32-bit texture, in 16x8 byte blocks.
+	const u32 pitch = W * 4;
+	generic.unswizzleTex16(src.data(), out1.data(), pitch / 16, H / 8, pitch);
+	fast.unswizzleTex16(src.data(), out2.data(), pitch / 16, H / 8, pitch);
+	EXPECT_EQ_INT(memcmp(out1.data(), out2.data(), W * H * sizeof(u32)), 0);
+
+	// Throughput is measured in output bytes.
+	struct Bench {
+		const char *name;
+		size_t bytes;
+		std::function<void(const TextureDecodeFuncs &)> run;
+	};
+	u32 alphaSum = 0xFFFFFFFF;
+	const Bench benches[] = {
+		{ "Unswizzle", W * H * 4, [&](const TextureDecodeFuncs &f) { f.unswizzleTex16(src.data(), out1.data(), pitch / 16, H / 8, pitch); } },
+		{ "CLUT4->16", W * H * 2, [&](const TextureDecodeFuncs &f) { for (int y = 0; y < H; ++y) f.deIndex4To16((u16 *)out1.data() + y * W, src.data() + y * W / 2, W, clut16, &alphaSum); } },
+		{ "CLUT4->32", W * H * 4, [&](const TextureDecodeFuncs &f) { for (int y = 0; y < H; ++y) f.deIndex4To32(out1.data() + y * W, src.data() + y * W / 2, W, clut32, &alphaSum); } },
+		{ "CLUT8->32", W * H * 4, [&](const TextureDecodeFuncs &f) { for (int y = 0; y < H; ++y) f.deIndex8To32(out1.data() + y * W, src.data() + y * W, W, clut32, &alphaSum); } },
+	};
+	for (const Bench &bench : benches) {
+		double genericSpeed = TextureDecodeMBPerSec(bench.bytes, [&] { bench.run(generic); });
+		double fastSpeed = TextureDecodeMBPerSec(bench.bytes, [&] { bench.run(fast); });
+		printf("%-10s: %8.1f MB/s (generic: %8.1f MB/s)\n", bench.name, fastSpeed, genericSpeed);
+	}
+
+	return true;
+}
+
+template <typename Surface>
+static bool RunSplineTessellation(Surface &surface, const Spline::ControlPoints &points, u32 vertType, std::vector<SimpleVertex> &verts, std::vector<u16> &inds) {
+	verts.resize(65536);
+	inds.resize(65536 * 6);
+	surface.Init((int)verts.size());
+	Spline::OutputBuffers output;
+	output.vertices = verts.data();
+	output.indices = inds.data();
+	output.count = 0;
+	Spline::SoftwareTessellation(output, surface, vertType, points);
+	return output.count > 0;
+}
+
+template <typename Surface>
+static void InitSplineSurface(Surface &surface, int points_u, int points_v, int tess, int patches_u, int patches_v) {
+	surface.tess_u = tess;
+	surface.tess_v = tess;
+	surface.num_points_u = points_u;
+	surface.num_points_v = points_v;
+	surface.num_patches_u = patches_u;
+	surface.num_patches_v = patches_v;
+	surface.type_u = 0;
+	surface.type_v = 0;
+	surface.primType = GE_PATCHPRIM_TRIANGLES;
+	surface.patchFacing = false;
+}
+
+bool TestSplineTessellation() {
+	const bool ownThreadManager = !g_threadManager.IsInitialized();
+	if (ownThreadManager)
+		g_threadManager.Init(cpu_info.num_cores, cpu_info.logical_cpu_count);
+	const int oldQuality = g_Config.iSplineBezierQuality;
+	g_Config.iSplineBezierQuality = (int)SplineQuality::HIGH_QUALITY;
+
+	static const int MAX_POINTS = 13 * 13;
+	Spline::ControlPoints points;
+	std::vector<Vec3f> pos(MAX_POINTS);
+	std::vector<Vec2f> tex(MAX_POINTS);
+	std::vector<Vec4f> col(MAX_POINTS);
+	points.pos = pos.data();
+	points.tex = tex.data();
+	points.col = col.data();
+	points.defcolor = 0xFFFFFFFF;
+	for (int i = 0; i < MAX_POINTS; ++i) {
+		pos[i] = Vec3f((float)(i % 13), (float)(i / 13), sinf((float)i));
+		tex[i] = Vec2f((float)(i % 13) / 12.0f, (float)(i / 13) / 12.0f);
+		col[i] = Vec4f(1.0f, 0.5f, (float)(i % 7) / 7.0f, 1.0f);
+	}
+	const u32 vertType = GE_VTYPE_TC_FLOAT | GE_VTYPE_COL_8888 | GE_VTYPE_NRM_FLOAT | GE_VTYPE_POS_FLOAT;
+
+	std::vector<SimpleVertex> verts;
+	std::vector<u16> inds;
+	bool success = true;
+
+	// A single high tessellation bezier patch is large enough to be split across threads.
+	// Check it against direct evaluation of the Bernstein polynomials, using the first 4x4 points.
+	Spline::BezierSurface bezier{};
+	InitSplineSurface(bezier, 4, 4, 64, 1, 1);
+	if (!RunSplineTessellation(bezier, points, vertType, verts, inds)) {
+		printf("Bezier tessellation produced no indices\n");
+		success = false;
+	}
+	auto bernstein = [](float t, float b[4]) {
+		const float s = 1.0f - t;
+		b[0] = s * s * s;
+		b[1] = 3.0f * t * s * s;
+		b[2] = 3.0f * t * t * s;
+		b[3] = t * t * t;
+	};
+	for (int v = 0; v <= bezier.tess_v && success; ++v) {
+		float bv[4];
+		bernstein((float)v / bezier.tess_v, bv);
+		for (int u = 0; u <= bezier.tess_u; ++u) {
+			float bu[4];
+			bernstein((float)u / bezier.tess_u, bu);
+			Vec3f expected(0.0f, 0.0f, 0.0f);
+			for (int j = 0; j < 4; ++j) {
+				for (int i = 0; i < 4; ++i) {
+					expected += pos[j * 4 + i] * (bu[i] * bv[j]);
+				}
+			}
+			const Vec3f actual = verts[bezier.GetIndex(u, v, 0, 0)].pos;
+			if ((actual - expected).Length() > 0.0001f) {
+				printf("Bezier vertex %d,%d mismatch: %f %f %f vs %f %f %f\n", u, v, actual.x, actual.y, actual.z, expected.x, expected.y, expected.z);
+				success = false;
+				break;
+			}
+		}
+	}
+
+	// Representative sizes: a single detailed patch, a terrain-like bezier grid and a spline grid.
+	struct Bench {
+		const char *name;
+		int verts;
+		std::function<void()> run;
+	};
+	Spline::BezierSurface bezierGrid{};
+	Spline::SplineSurface splineGrid{};
+	const Bench benches[] = {
+		{ "Bezier 1 patch, tess 64", 65 * 65, [&] { InitSplineSurface(bezier, 4, 4, 64, 1, 1); RunSplineTessellation(bezier, points, vertType, verts, inds); } },
+		{ "Bezier 4x4 patches, tess 16", 17 * 17 * 16, [&] { InitSplineSurface(bezierGrid, 13, 13, 16, 4, 4); RunSplineTessellation(bezierGrid, points, vertType, verts, inds); } },
+		{ "Spline 10x10 patches, tess 8", 81 * 81, [&] { InitSplineSurface(splineGrid, 13, 13, 8, 10, 10); RunSplineTessellation(splineGrid, points, vertType, verts, inds); } },
+	};
+	for (const Bench &bench : benches) {
+		double seconds = BenchmarkSeconds(bench.run);
+		printf("%s: %0.2f Mverts/s\n", bench.name, bench.verts / seconds / 1000000.0);
+	}
+
+	g_Config.iSplineBezierQuality = oldQuality;
+	if (ownThreadManager)
+		g_threadManager.Teardown();
+	return success;
+}
+
+bool TestGPUStatsHistory() {
+	GPUStatsHistory history;
+	EXPECT_TRUE(history.GetSince(0).empty());
+
+	GPUStatsPerFrame stats{};
+	auto recordFrames = [&](int count) {
+		for (int i = 0; i < count; i++) {
+			stats.numDrawCalls++;
+			history.Record(stats, 0);
+		}
+	};
+	// Ids 1 to 10, each with numDrawCalls == id.
+	recordFrames(10);
+	std::vector<GPUStatsFrameRecord> records = history.GetSince(0);
+	EXPECT_EQ_INT(records.size(), 10);
+	EXPECT_EQ_INT(records.front().id, 1);
+	EXPECT_EQ_INT(records.back().id, 10);
+	records = history.GetSince(9);
+	EXPECT_EQ_INT(records.size(), 1);
+	EXPECT_EQ_INT(records[0].id, 10);
+	records = history.GetSince(0, 3);
+	EXPECT_EQ_INT(records.size(), 3);
+	EXPECT_EQ_INT(records[0].id, 8);
+
+	// Nothing new, or an id we haven't reached yet, must never return older records.
+	EXPECT_TRUE(history.GetSince(10).empty());
+	EXPECT_TRUE(history.GetSince(10, 3).empty());
+	EXPECT_TRUE(history.GetSince(11, GPUStatsHistory::SIZE).empty());
+	EXPECT_TRUE(history.GetSince(0xFFFFFFFF, GPUStatsHistory::SIZE).empty());
+
+	// Wrap around the ring, only the newest SIZE are left.
+	recordFrames(GPUStatsHistory::SIZE + 50);
+	const uint32_t lastId = GPUStatsHistory::SIZE + 60;
+	records = history.GetSince(0);
+	EXPECT_EQ_INT(records.size(), GPUStatsHistory::SIZE);
+	EXPECT_EQ_INT(records.front().id, lastId - GPUStatsHistory::SIZE + 1);
+	EXPECT_EQ_INT(records.back().id, lastId);
+	for (const GPUStatsFrameRecord &record : records)
+		EXPECT_EQ_INT(record.stats.numDrawCalls, record.id);
+	records = history.GetSince(lastId - 1, GPUStatsHistory::SIZE);
+	EXPECT_EQ_INT(records.size(), 1);
+	EXPECT_EQ_INT(records[0].id, lastId);
+	EXPECT_TRUE(history.GetSince(lastId, GPUStatsHistory::SIZE).empty());
+	EXPECT_TRUE(history.GetSince(lastId + 100, GPUStatsHistory::SIZE).empty());
+	return true;
+}
+
 bool TestCLZ() {
 	static const uint32_t input[] = {
 		0xFFFFFFFF,
@@ -1046,6 +1326,60 @@ bool TestColorConv() {
 		EXPECT_EQ_INT(reference, value);
 	}
 
+	// YUV 4:2:0 lines, with lengths that leave a tail after the SIMD loop.
+	u8 y[67], u[34], v[34];
+	for (int i = 0; i < (int)sizeof(y); i++) {
+		y[i] = (u8)(i * 97 + 13);
+		u[i / 2] = (u8)(i * 61 + 200);
+		v[i / 2] = (u8)(i * 29 + 7);
+	}
+	// Extremes, black and white.
+	y[0] = 255; u[0] = 255; v[0] = 255;
+	y[2] = 0; u[1] = 0; v[1] = 0;
+	y[4] = 16; y[5] = 235; u[2] = 128; v[2] = 128;
+
+	u32 rgba[67];
+	u16 rgb565[67], rgba5551[67], rgba4444[67];
+	const int lengths[] = { 1, 16, 31, 67 };
+	for (int len : lengths) {
+		ConvertYUV420ToRGBA8888(rgba, y, u, v, len);
+		ConvertYUV420ToRGB565(rgb565, y, u, v, len);
+		ConvertYUV420ToRGBA5551(rgba5551, y, u, v, len);
+		ConvertYUV420ToRGBA4444(rgba4444, y, u, v, len);
+		for (int i = 0; i < len; i++) {
+			const double yy = (255.0 / 219.0) * (y[i] - 16);
+			const double uu = (255.0 / 224.0) * (u[i / 2] - 128);
+			const double vv = (255.0 / 224.0) * (v[i / 2] - 128);
+			const int r = rgba[i] & 0xFF;
+			const int g = (rgba[i] >> 8) & 0xFF;
+			const int b = (rgba[i] >> 16) & 0xFF;
+			EXPECT_TRUE(fabs(r - clamp_value(yy + 1.402 * vv, 0.0, 255.0)) <= 1.0);
+			EXPECT_TRUE(fabs(g - clamp_value(yy - 0.344136 * uu - 0.714136 * vv, 0.0, 255.0)) <= 1.0);
+			EXPECT_TRUE(fabs(b - clamp_value(yy + 1.772 * uu, 0.0, 255.0)) <= 1.0);
+			EXPECT_EQ_INT(rgba[i] >> 24, 0);
+			EXPECT_EQ_HEX(rgb565[i], (r >> 3) | ((g >> 2) << 5) | ((b >> 3) << 11));
+			EXPECT_EQ_HEX(rgba5551[i], (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10));
+			EXPECT_EQ_HEX(rgba4444[i], (r >> 4) | ((g >> 4) << 4) | ((b >> 4) << 8));
+		}
+	}
+	EXPECT_EQ_HEX(rgba[4], 0);
+	EXPECT_EQ_HEX(rgba[5], 0x00FFFFFF);
+
+	// The SIMD path must match the scalar one exactly. Two pixels at a time always take the scalar path,
+	// so compare those against whole lines, for every combination of Y, U and V.
+	u8 yAll[256], uLine[128], vLine[128];
+	u32 simd[256], scalar[256];
+	for (int i = 0; i < 256; i++)
+		yAll[i] = (u8)i;
+	for (int uv = 0; uv < 65536; uv++) {
+		memset(uLine, uv & 0xFF, sizeof(uLine));
+		memset(vLine, uv >> 8, sizeof(vLine));
+		ConvertYUV420ToRGBA8888(simd, yAll, uLine, vLine, 256);
+		for (int i = 0; i < 256; i += 2)
+			ConvertYUV420ToRGBA8888(scalar + i, yAll + i, uLine + i / 2, vLine + i / 2, 2);
+		EXPECT_EQ_INT(memcmp(simd, scalar, sizeof(simd)), 0);
+	}
+
 	return true;
 }
 
@@ -1238,6 +1572,224 @@ bool TestVolumeFunc() {
 	return true;
 }
 
+bool TestSasMix() {
+	TestRandom nextRandom(0x1234567);
+
+	// The volume kernel must match the scalar formula exactly, including at the extremes.
+	static const int frameCounts[] = { 1, 2, 3, 7, 256, 1023 };
+	std::vector<int> samples(PSP_SAS_MAX_GRAIN * 2);
+	std::vector<int> actual(PSP_SAS_MAX_GRAIN * 2);
+	std::vector<int> expected(PSP_SAS_MAX_GRAIN * 2);
+	for (int frames : frameCounts) {
+		for (int i = 0; i < frames * 2; i += 2) {
+			int sample = (int)(nextRandom() & 0xFFFF) - 0x8000;
+			if (i < 8)
+				sample = i < 4 ? -0x8000 : 0x7FFF;
+			samples[i] = sample;
+			samples[i + 1] = sample;
+			actual[i] = expected[i] = (int)nextRandom() - 0x800000;
+			actual[i + 1] = expected[i + 1] = (int)nextRandom() - 0x800000;
+		}
+		const int volumeLeft = frames & 1 ? -PSP_SAS_VOL_MAX : PSP_SAS_VOL_MAX;
+		const int volumeRight = (int)(nextRandom() % (PSP_SAS_VOL_MAX * 2 + 1)) - PSP_SAS_VOL_MAX;
+		for (int i = 0; i < frames * 2; i += 2) {
+			expected[i] += (samples[i] * volumeLeft) >> 12;
+			expected[i + 1] += (samples[i + 1] * volumeRight) >> 12;
+		}
+		SasMixSamplesStereo(actual.data(), samples.data(), frames, volumeLeft, volumeRight);
+		for (int i = 0; i < frames * 2; i++) {
+			EXPECT_EQ_INT(actual[i], expected[i]);
+		}
+	}
+
+	// Benchmark: 32 voices, half PCM and half VAG, at assorted pitches.
+	Memory::g_MemorySize = Memory::RAM_NORMAL_SIZE;
+	if (!Memory::Init(Memory::MemMapSetupFlags::Default)) {
+		printf("TestSasMix: Memory::Init failed, skipping benchmark\n");
+		return true;
+	}
+
+	const u32 pcmAddr = 0x08800000;
+	const int pcmSamples = 0x10000;
+	s16 *pcm = (s16 *)Memory::GetPointerWrite(pcmAddr);
+	for (int i = 0; i < pcmSamples; i++)
+		pcm[i] = (s16)(sinf(i * 0.05f) * 20000.0f);
+
+	const u32 vagAddr = pcmAddr + pcmSamples * sizeof(s16);
+	const int vagSize = 0x10000;
+	u8 *vag = Memory::GetPointerWrite(vagAddr);
+	for (int i = 0; i < vagSize; i += 16) {
+		vag[i] = (u8)(((nextRandom() % 5) << 4) | (nextRandom() % 13));
+		vag[i + 1] = 0;
+		for (int j = 2; j < 16; j++)
+			vag[i + j] = (u8)nextRandom();
+	}
+
+	SasInstance *sas = new SasInstance();
+	const int grainSize = 256;
+	sas->SetGrainSize(grainSize);
+	for (int v = 0; v < PSP_SAS_VOICES_MAX; v++) {
+		SasVoice &voice = sas->voices[v];
+		if (v & 1) {
+			voice.type = VOICETYPE_VAG;
+			voice.vagAddr = vagAddr;
+			voice.vagSize = vagSize;
+			voice.loop = true;
+		} else {
+			voice.type = VOICETYPE_PCM;
+			voice.pcmAddr = pcmAddr;
+			voice.pcmSize = pcmSamples;
+			voice.pcmLoopPos = 0;
+			voice.loop = true;
+		}
+		voice.pitch = PSP_SAS_PITCH_BASE / 2 + (v * PSP_SAS_PITCH_BASE) / 16;
+		voice.volumeLeft = PSP_SAS_VOL_MAX - v * 64;
+		voice.volumeRight = v * 64;
+		voice.effectLeft = (v & 2) ? PSP_SAS_VOL_MAX / 2 : 0;
+		voice.effectRight = (v & 2) ? PSP_SAS_VOL_MAX / 2 : 0;
+		voice.envelope.SetSimpleEnvelope(0x000F, 0x1FC6);
+		voice.KeyOn();
+	}
+
+	double seconds = BenchmarkSeconds([&] {
+		memset(sas->mixBuffer, 0, grainSize * sizeof(int) * 2);
+		memset(sas->sendBuffer, 0, grainSize * sizeof(int) * 2);
+		for (int v = 0; v < PSP_SAS_VOICES_MAX; v++) {
+			SasVoice &voice = sas->voices[v];
+			if (!voice.playing)
+				voice.KeyOn();
+			sas->MixVoice(voice);
+		}
+	});
+	printf("SAS mix, %d voices: %0.2f us per %d-sample grain\n", PSP_SAS_VOICES_MAX, seconds * 1000000.0, grainSize);
+
+	delete sas;
+	Memory::Shutdown();
+	return true;
+}
+
+bool TestVagCache() {
+	Memory::g_MemorySize = Memory::RAM_NORMAL_SIZE;
+	if (!Memory::Init(Memory::MemMapSetupFlags::Default)) {
+		printf("TestVagCache: Memory::Init failed, skipping\n");
+		return true;
+	}
+	const bool savedVagCache = g_Config.bSasVagCache;
+	g_Config.bSasVagCache = true;
+	SasVagCacheClear();
+
+	TestRandom nextRandom(0x2468ACE);
+	const u32 vagAddr = 0x08800000;
+	const int vagBlocks = 64;
+	const int vagSamples = vagBlocks * 28;
+	auto fillVag = [&] {
+		u8 *vag = Memory::GetPointerWrite(vagAddr);
+		for (int i = 0; i < vagBlocks * 16; i += 16) {
+			vag[i] = (u8)(((nextRandom() % 5) << 4) | (nextRandom() % 13));
+			vag[i + 1] = 0;
+			for (int j = 2; j < 16; j++)
+				vag[i + j] = (u8)nextRandom();
+		}
+	};
+	fillVag();
+
+	// Same address, size and data hits, another size misses, and invalidating only drops overlaps.
+	std::shared_ptr<VagCacheEntry> entry = SasVagCacheLookup(vagAddr, vagBlocks * 16);
+	EXPECT_TRUE(entry != nullptr);
+	EXPECT_TRUE(SasVagCacheLookup(vagAddr, vagBlocks * 16) == entry);
+	EXPECT_TRUE(SasVagCacheLookup(vagAddr, vagBlocks * 16 - 16) != entry);
+	SasVagCacheInvalidate(vagAddr + vagBlocks * 16, 16);
+	EXPECT_FALSE(entry->invalidated);
+	EXPECT_TRUE(SasVagCacheLookup(vagAddr, vagBlocks * 16) == entry);
+	SasVagCacheInvalidate(vagAddr + 32, 16);
+	EXPECT_TRUE(entry->invalidated);
+	EXPECT_TRUE(SasVagCacheLookup(vagAddr, vagBlocks * 16) != entry);
+	entry.reset();
+
+	// Decode from memory, and fill the cache with a one-shot voice.
+	std::vector<s16> expected(vagSamples), actual(vagSamples);
+	g_Config.bSasVagCache = false;
+	VagDecoder uncached;
+	uncached.Start(vagAddr, vagBlocks * 16, false);
+	uncached.GetSamples(expected.data(), vagSamples);
+	g_Config.bSasVagCache = true;
+	VagDecoder filler;
+	filler.Start(vagAddr, vagBlocks * 16, false);
+	filler.GetSamples(actual.data(), vagSamples);
+	EXPECT_EQ_MEM(actual.data(), expected.data(), vagSamples * sizeof(s16));
+
+	// Now replay it from the cache, but change the data halfway, like a game reusing the memory.
+	g_Config.bSasVagCache = false;
+	uncached.Start(vagAddr, vagBlocks * 16, false);
+	g_Config.bSasVagCache = true;
+	VagDecoder cached;
+	cached.Start(vagAddr, vagBlocks * 16, false);
+	const int half = vagSamples / 2;
+	uncached.GetSamples(expected.data(), half);
+	cached.GetSamples(actual.data(), half);
+	fillVag();
+	SasVagCacheInvalidate(vagAddr, vagBlocks * 16);
+	uncached.GetSamples(expected.data() + half, vagSamples - half);
+	cached.GetSamples(actual.data() + half, vagSamples - half);
+	EXPECT_EQ_MEM(actual.data(), expected.data(), vagSamples * sizeof(s16));
+
+	SasVagCacheClear();
+	g_Config.bSasVagCache = savedVagCache;
+	Memory::Shutdown();
+	return true;
+}
+
+bool TestSasReverb() {
+	// Output hashes of the original sample-by-sample implementation, for presets -1 (off) to 8.
+	static const uint64_t expected[10] = {
+		0x31ddcd1705163b89ULL,
+		0xefe94ab26bc021e7ULL,
+		0xae1f3a535744f79bULL,
+		0xae1c84c00811976aULL,
+		0x7412d6e9b1aac3a7ULL,
+		0x02c4d2774a5fe217ULL,
+		0xffd6d3d3e04332c6ULL,
+		0xc6a7d827606993ccULL,
+		0x17c71eb09cb68c26ULL,
+		0x35faf65ba60b6a71ULL,
+	};
+
+	// Full volume maps to a multiplier of exactly 1.0.
+	const int savedReverbVolume = g_Config.iReverbVolume;
+	g_Config.iReverbVolume = 100;
+
+	// Deterministic input, with some calls at odd sizes to exercise partial groups and buffer wraps.
+	TestRandom nextRandom(0x5A5A5A5A);
+	std::vector<int16_t> input(512 * 2);
+	std::vector<int16_t> output(512 * 4);
+	uint64_t hashes[10];
+	for (int preset = -1; preset < 9; preset++) {
+		SasReverb reverb;
+		reverb.SetPreset(preset);
+		uint64_t hash = 14695981039346656037ULL;
+		for (int call = 0; call < 400; call++) {
+			size_t count = (call % 5 == 0) ? nextRandom() % 300 + 1 : 128;
+			for (size_t i = 0; i < count * 2; i++) {
+				int value = (int)(nextRandom() & 0xFFFF) - 0x8000;
+				input[i] = (int16_t)((call & 32) ? value : value / 16);
+			}
+			reverb.ProcessReverb(output.data(), input.data(), count, (call & 1) ? 0x8000 : 0x7FF8, 0x4000 + (call & 0xFF));
+			for (size_t i = 0; i < count * 4; i++)
+				hash = (hash ^ (uint16_t)output[i]) * 1099511628211ULL;
+		}
+		hashes[preset + 1] = hash;
+	}
+
+	g_Config.iReverbVolume = savedReverbVolume;
+	for (int i = 0; i < 10; i++) {
+		if (hashes[i] != expected[i]) {
+			printf("%s: preset %d: %016llx vs %016llx\n", __FUNCTION__, i - 1, (unsigned long long)hashes[i], (unsigned long long)expected[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
 bool TestLinAlg() {
 	static const float m1[16] = {
 		1, 2, 3, 4,
@@ -1311,6 +1863,307 @@ bool TestLinAlg() {
 	return true;
 }
 
+bool TestAudioRing() {
+	AudioRing<s16> ring(8);
+	EXPECT_EQ_INT(ring.Size(), 0);
+	// Move close to the u32 wrap, to check that the size stays right across it.
+	ring.PublishTail(0xFFFFFFFE);
+	ring.PublishHead(0xFFFFFFFE);
+	u32 head = ring.Head();
+	EXPECT_EQ_INT(ring.ContiguousFrom(head), 2);
+	for (int i = 0; i < 6; i++)
+		ring.At(head + i) = (s16)(100 + i);
+	ring.PublishHead(head + 6);
+	EXPECT_EQ_INT(ring.Size(), 6);
+	EXPECT_EQ_INT(ring.At(ring.Tail() + 5), 105);
+	EXPECT_EQ_INT(ring.At(2), 104);
+	ring.PublishTail(ring.Tail() + 4);
+	EXPECT_EQ_INT(ring.Size(), 2);
+	EXPECT_EQ_INT(ring.At(ring.Tail()), 104);
+
+	ring.stats.RecordUnderrun();
+	ring.stats.RecordLatency(5.0f);
+	ring.stats.RecordLatency(25.0f);
+	ring.stats.RecordLatency(1000.0f);
+	EXPECT_EQ_INT(ring.stats.underruns, 1);
+	EXPECT_EQ_INT(ring.stats.histogram[0], 1);
+	EXPECT_EQ_INT(ring.stats.histogram[2], 1);
+	EXPECT_EQ_INT(ring.stats.histogram[AudioRingStats::HISTOGRAM_BUCKETS - 1], 1);
+	char buf[512] = "";
+	ring.stats.FormatHistogram(buf, sizeof(buf));
+	EXPECT_TRUE(strstr(buf, "110-120+ ms") != nullptr);
+	ring.stats.Reset();
+	EXPECT_EQ_INT(ring.stats.underruns, 0);
+	buf[0] = '\0';
+	ring.stats.FormatHistogram(buf, sizeof(buf));
+	EXPECT_EQ_INT(strlen(buf), 0);
+	return true;
+}
+
+bool TestAudioMix() {
+	TestRandom nextRandom(0x7654321);
+
+	// Compare against the scalar formulas, on every SIMD path this CPU supports.
+	static const size_t sizes[] = { 1, 7, 8, 15, 16, 33, 128 };
+	s16 in[128];
+	s32 mix[128], expected[128];
+	s16 clamped[128], expectedClamped[128];
+	// Puts the real CPU flags back even when an EXPECT returns early. The last level uses them unchanged,
+	// so the benchmark below runs with them too.
+	struct CPUFlagsRestorer {
+		const bool hadAVX2 = cpu_info.bAVX2;
+		const bool hadSSE4_1 = cpu_info.bSSE4_1;
+		~CPUFlagsRestorer() {
+			cpu_info.bAVX2 = hadAVX2;
+			cpu_info.bSSE4_1 = hadSSE4_1;
+		}
+	} restorer;
+	for (int level = 0; level < 3; level++) {
+		cpu_info.bAVX2 = restorer.hadAVX2 && level == 2;
+		cpu_info.bSSE4_1 = restorer.hadSSE4_1 && level >= 1;
+		for (size_t size : sizes) {
+			for (size_t i = 0; i < size; i++) {
+				in[i] = i < 2 ? (i == 0 ? -0x8000 : 0x7FFF) : (s16)nextRandom();
+				mix[i] = expected[i] = (int)(nextRandom() & 0x7FFFF) - 0x40000;
+			}
+			AccumulateS16ToS32(mix, in, size);
+			for (size_t i = 0; i < size; i++)
+				expected[i] += in[i];
+			EXPECT_EQ_MEM(mix, expected, size * sizeof(s32));
+			ConvertS16ToS32(mix, in, size);
+			for (size_t i = 0; i < size; i++)
+				EXPECT_EQ_INT(mix[i], in[i]);
+
+			for (int volume : { 4096, 3000, 1 }) {
+				for (size_t i = 0; i < size; i++)
+					expectedClamped[i] = clamp_s16((expected[i] * std::min(volume, 4096)) >> 12);
+				ClampBufferToS16WithVolume(clamped, expected, size, volume);
+				EXPECT_EQ_MEM(clamped, expectedClamped, size * sizeof(s16));
+			}
+		}
+	}
+
+	// Benchmark: one __AudioUpdate worth of mixing, 8 channels plus the SRC channel.
+	const int channels = 9;
+	const size_t blockSize = 64 * 2;
+	std::vector<s16> chans(channels * blockSize);
+	for (auto &sample : chans)
+		sample = (s16)nextRandom();
+
+	auto bench = [&](const char *name, auto mixFunc) {
+		// A block is too quick to time on its own.
+		double seconds = BenchmarkSeconds([&] {
+			for (int n = 0; n < 100; n++) {
+				mixFunc(mix, &chans[0], blockSize, false);
+				for (int c = 1; c < channels; c++)
+					mixFunc(mix, &chans[c * blockSize], blockSize, true);
+				ClampBufferToS16WithVolume(clamped, mix, blockSize, 4096);
+			}
+		});
+		printf("Audio mix (%s), %d channels: %0.1f ns per block\n", name, channels, seconds * 1000000000.0 / 100);
+	};
+	bench("scalar", [](s32 *out, const s16 *in, size_t size, bool accumulate) {
+		DO_NOT_VECTORIZE_LOOP
+		for (size_t i = 0; i < size; i++)
+			out[i] = accumulate ? out[i] + in[i] : in[i];
+	});
+	bench("simd", [](s32 *out, const s16 *in, size_t size, bool accumulate) {
+		if (accumulate)
+			AccumulateS16ToS32(out, in, size);
+		else
+			ConvertS16ToS32(out, in, size);
+	});
+	return true;
+}
+
+bool TestAudioResampler() {
+	// Runs a sine through the linear interpolator and both sinc paths, 44.1kHz to 48kHz, and fits
+	// a sine to the output. Reports the gain and everything else as noise, relative to the fit.
+	PolyphaseFilter *filter = new PolyphaseFilter();
+	filter->Build(0.9f);
+
+	const int inRate = 44100;
+	const int outRate = 48000;
+	const u32 ratio = (u32)(65536.0 * inRate / outRate);
+	const int outFrames = 4096;
+	const int inFrames = (int)(((u64)outFrames * ratio) >> 16) + PolyphaseFilter::TAPS + 2;
+	std::vector<s16> input(inFrames * 2);
+	std::vector<s16> output(outFrames * 2);
+
+	auto resample = [&](int method) {
+		u32 frac = 0;
+		int index = 0;
+		for (int i = 0; i < outFrames; i++) {
+			const s16 *frames = &input[index * 2];
+			if (method == 0) {
+				for (int c = 0; c < 2; c++)
+					output[i * 2 + c] = (s16)(frames[c] + (((frames[c + 2] - frames[c]) * (int)(u16)frac) >> 16));
+			} else if (method == 1) {
+				filter->FilterFixed(frames, frac, &output[i * 2]);
+			} else {
+				filter->FilterFloat(frames, frac, &output[i * 2]);
+			}
+			frac += ratio;
+			index += frac >> 16;
+			frac &= 0xFFFF;
+		}
+	};
+
+	auto measure = [&](int method, double freq, double *gainDb, double *noiseDb) {
+		const double amplitude = 16000.0;
+		for (int i = 0; i < inFrames; i++) {
+			s16 sample = (s16)lrint(amplitude * sin(2.0 * M_PI * freq * i / inRate));
+			input[i * 2] = sample;
+			input[i * 2 + 1] = sample;
+		}
+		resample(method);
+
+		// Least squares fit of a sine and cosine at the expected output frequency. Skip the start, where
+		// the sinc paths are still reading before the beginning of the tone.
+		const double w = 2.0 * M_PI * freq * ratio / 65536.0 / inRate;
+		double ss = 0.0, cc = 0.0, sc = 0.0, ys = 0.0, yc = 0.0;
+		const int start = PolyphaseFilter::TAPS;
+		for (int i = start; i < outFrames; i++) {
+			double s = sin(w * i), c = cos(w * i), y = output[i * 2];
+			ss += s * s;
+			cc += c * c;
+			sc += s * c;
+			ys += y * s;
+			yc += y * c;
+		}
+		const double det = ss * cc - sc * sc;
+		const double a = (ys * cc - yc * sc) / det;
+		const double b = (yc * ss - ys * sc) / det;
+		double signal = 0.0, noise = 0.0;
+		for (int i = start; i < outFrames; i++) {
+			double fit = a * sin(w * i) + b * cos(w * i);
+			double err = output[i * 2] - fit;
+			signal += fit * fit;
+			noise += err * err;
+		}
+		*gainDb = 20.0 * log10(sqrt(a * a + b * b) / amplitude);
+		*noiseDb = 10.0 * log10(noise / signal);
+	};
+
+	static const char *const names[3] = { "linear", "sinc fixed", "sinc float" };
+	static const double freqs[] = { 1000.0, 8000.0, 16000.0 };
+	for (double freq : freqs) {
+		double gain[3], noise[3];
+		for (int method = 0; method < 3; method++) {
+			measure(method, freq, &gain[method], &noise[method]);
+			printf("Resampler %s, %0.0f Hz: gain %0.2f dB, noise %0.1f dB\n", names[method], freq, gain[method], noise[method]);
+		}
+		for (int method = 1; method < 3; method++) {
+			EXPECT_TRUE(fabs(gain[method]) < 0.2);
+			EXPECT_TRUE(noise[method] < -60.0);
+			EXPECT_TRUE(noise[method] < noise[0]);
+		}
+	}
+
+	// Throughput, as a share of one core when producing 48kHz stereo.
+	for (int method = 0; method < 3; method++) {
+		double framesPerSecond = outFrames / BenchmarkSeconds([&] { resample(method); });
+		printf("Resampler %s: %0.1f Mframes/s, %0.3f%% of a core at 48kHz\n", names[method], framesPerSecond / 1000000.0, 100.0 * outRate / framesPerSecond);
+	}
+
+	delete filter;
+	return true;
+}
+
+bool TestAudioDecoderPool() {
+	// Same extradata as AtracBase::CreateDecoder, stereo without joint stereo.
+	uint8_t extraData[14]{};
+	extraData[0] = 1;
+	extraData[3] = 2 << 3;
+	extraData[10] = 1;
+
+	const AudioDecoderPoolStats before = GetAudioDecoderPoolStats();
+	AudioDecoder *at3 = CreateAtracAudioDecoder(PSP_CODEC_AT3, 2, 384, extraData, sizeof(extraData));
+	AudioDecoder *at3plus = CreateAtracAudioDecoder(PSP_CODEC_AT3PLUS, 2, 0x2E8);
+	EXPECT_TRUE(at3->IsOK());
+	ReleaseAudioDecoder(at3);
+	ReleaseAudioDecoder(at3plus);
+
+	// Different parameters get a new decoder, the same ones get the pooled one back.
+	AudioDecoder *mono = CreateAtracAudioDecoder(PSP_CODEC_AT3PLUS, 1, 0x178);
+	EXPECT_TRUE(mono != at3plus);
+	AudioDecoder *at3Again = CreateAtracAudioDecoder(PSP_CODEC_AT3, 2, 384, extraData, sizeof(extraData));
+	EXPECT_TRUE(at3Again == at3);
+	AudioDecoder *at3plusAgain = CreateAtracAudioDecoder(PSP_CODEC_AT3PLUS, 2, 0x2E8);
+	EXPECT_TRUE(at3plusAgain == at3plus);
+
+	AudioDecoderPoolStats stats = GetAudioDecoderPoolStats();
+	EXPECT_EQ_INT((int)(stats.created - before.created), 3);
+	EXPECT_EQ_INT((int)(stats.reused - before.reused), 2);
+	EXPECT_EQ_INT((int)(stats.released - before.released), 2);
+
+	ReleaseAudioDecoder(mono);
+	ReleaseAudioDecoder(at3Again);
+	ReleaseAudioDecoder(at3plusAgain);
+	EXPECT_EQ_INT((int)GetAudioDecoderPoolStats().pooled, (int)before.pooled + 3);
+	ClearAudioDecoderPool();
+	stats = GetAudioDecoderPoolStats();
+	EXPECT_EQ_INT((int)stats.pooled, 0);
+	EXPECT_EQ_INT((int)(stats.freed - before.freed), (int)before.pooled + 3);
+
+	// A pooled decoder is reset when it's handed out again, so it has to decode exactly like a new one.
+	TestRandom nextRandom(0xA7A7A7);
+	const int NUM_PACKETS = 32;
+	// The decoders may read a bit past the end of the packet.
+	const int PACKET_PADDING = 4096;
+	auto decodeAll = [&](AudioDecoder *decoder, const std::vector<u8> &packets, int blockAlign, std::vector<s16> &out) {
+		int16_t frame[2048 * 2];
+		int decodedFrames = 0;
+		// Record the result and sample count of each packet too, not just the samples.
+		out.clear();
+		for (int i = 0; i < NUM_PACKETS; i++) {
+			memset(frame, 0, sizeof(frame));
+			int outSamples = 0;
+			const bool result = decoder->Decode(&packets[i * blockAlign], blockAlign, nullptr, 2, frame, &outSamples);
+			decodedFrames += result ? 1 : 0;
+			out.push_back(result);
+			out.push_back(outSamples);
+			out.insert(out.end(), frame, frame + outSamples * 2);
+		}
+		return decodedFrames;
+	};
+	for (PSPAudioType codec : { PSP_CODEC_AT3, PSP_CODEC_AT3PLUS }) {
+		const int blockAlign = codec == PSP_CODEC_AT3 ? 384 : 0x2E8;
+		std::vector<u8> packets(NUM_PACKETS * blockAlign + PACKET_PADDING);
+		for (auto &b : packets)
+			b = (u8)nextRandom();
+		if (codec == PSP_CODEC_AT3) {
+			// Random data is rarely a valid sound unit. Start each channel's with the unit id, one coded band,
+			// no gain control points and no tonal components, so only the spectrum is random.
+			for (int i = 0; i < NUM_PACKETS * 2; i++) {
+				packets[i * blockAlign / 2] = 0xA0;
+				packets[i * blockAlign / 2 + 1] = 0x00;
+			}
+		}
+		auto create = [&] {
+			return codec == PSP_CODEC_AT3 ? CreateAtracAudioDecoder(codec, 2, blockAlign, extraData, sizeof(extraData)) : CreateAtracAudioDecoder(codec, 2, blockAlign);
+		};
+
+		std::vector<s16> firstUse, reused, fresh;
+		AudioDecoder *decoder = create();
+		EXPECT_TRUE(decodeAll(decoder, packets, blockAlign, firstUse) > 0);
+		ReleaseAudioDecoder(decoder);
+		AudioDecoder *decoderAgain = create();
+		EXPECT_TRUE(decoderAgain == decoder);
+		decodeAll(decoderAgain, packets, blockAlign, reused);
+		// The pool is empty now, so this one is new.
+		AudioDecoder *freshDecoder = create();
+		EXPECT_TRUE(freshDecoder != decoderAgain);
+		decodeAll(freshDecoder, packets, blockAlign, fresh);
+		EXPECT_TRUE(firstUse == fresh);
+		EXPECT_TRUE(reused == fresh);
+		ReleaseAudioDecoder(decoderAgain);
+		ReleaseAudioDecoder(freshDecoder);
+	}
+	ClearAudioDecoderPool();
+	return true;
+}
+
 bool TestSplitSearch() {
 	std::string part1 = "The quick brown fox jumps";
 	std::string part2 = " over the lazy dog.";
@@ -1393,6 +2246,9 @@ TestItem availableTests[] = {
 	TEST_ITEM(VFPUMatrixTranspose),
 	TEST_ITEM(ParseLBN),
 	TEST_ITEM(QuickTexHash),
+	TEST_ITEM(TextureDecodeFuncs),
+	TEST_ITEM(SplineTessellation),
+	TEST_ITEM(GPUStatsHistory),
 	TEST_ITEM(CLZ),
 	TEST_ITEM(MemMap),
 	TEST_ITEM(ShaderGenerators),
@@ -1416,6 +2272,13 @@ TestItem availableTests[] = {
 	TEST_ITEM(SIMD),
 	TEST_ITEM(CrossSIMD),
 	TEST_ITEM(VolumeFunc),
+	TEST_ITEM(SasMix),
+	TEST_ITEM(VagCache),
+	TEST_ITEM(SasReverb),
+	TEST_ITEM(AudioRing),
+	TEST_ITEM(AudioMix),
+	TEST_ITEM(AudioResampler),
+	TEST_ITEM(AudioDecoderPool),
 	TEST_ITEM(SplitSearch),
 	TEST_ITEM(FriendlyPath),
 	TEST_ITEM(LinAlg),